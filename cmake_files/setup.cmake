@@ -76,6 +76,29 @@ if(LTO_ENABLED)
     endif()
 endif()
 
+# ----------------------------------------------- additional executables -----------------------------------------------
+# ======================================================================================================================
+# apply the compiler settings of the main target to additional executables (tools and tests)
+# (clang-tidy is applied to all targets via CMAKE_CXX_CLANG_TIDY)
+function(setup_additional_target target)
+    set_target_properties(${target} PROPERTIES
+            CXX_STANDARD ${STANDARD}
+            CXX_STANDARD_REQUIRED ON
+            CXX_EXTENSIONS ${COMPILER_EXTENSIONS}
+    )
+
+    set_definitions(${target})
+    set_options(${target} OFF)
+
+    if (COMPILER_WARNINGS)
+        enable_warnings(${target})
+    else ()
+        disable_warnings(${target})
+    endif ()
+endfunction()
+
+add_subdirectory("tools")
+
 # ----------------------------------------------- doxygen documentation ------------------------------------------------
 # ======================================================================================================================
 if (BUILD_DOC AND NOT STANDALONE_PROJECT)
@@ -0,0 +1,1145 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+/*! \file consumer.hpp
+ * \brief header only library to access the register tables of modbus-rtu-client-shm from other processes
+ *
+ * Example:
+ * \code
+ *  Modbus::consumer::Tables tables({.prefix = "modbus_", .semaphore = "modbus"});
+ *
+ *  std::array<float, 4> setpoints {};
+ *  tables.read(Modbus::consumer::Table::AO, 100, std::span(setpoints));
+ *  tables.write(Modbus::consumer::Table::AI, 0, std::span(setpoints));
+ *
+ *  Modbus::consumer::Change_Notifier notifier("modbus_");
+ *  while (notifier.wait(std::chrono::seconds(1))) { ... }
+ *
+ *  Modbus::consumer::Commit_Sync commits("modbus_");
+ *  commits.read([&] { tables.read(Modbus::consumer::Table::AO, 100, std::span(setpoints)); });
+ *
+ *  Modbus::consumer::Doorbell_Producer doorbell("modbus_");
+ *  while (running) {
+ *      if (const auto request = doorbell.wait(std::chrono::seconds(1))) { update(*request); doorbell.acknowledge(); }
+ *  }
+ *
+ *  Modbus::consumer::Fifo_Producer events("modbus_", 1000);
+ *  const std::array<std::uint16_t, 2> event {alarm_id, value};
+ *  if (!events.push(std::span(event))) { ... }  // queue full
+ *
+ *  if (const auto bus = Modbus::consumer::Bus_Statistics("modbus_").read())
+ *      std::cout << "bus occupancy: " << bus->occupancy / 1e4 << " %\n";
+ * \endcode
+ *
+ * Only POSIX shared memory, POSIX semaphores and futexes are used (link with -lrt on old glibc versions).
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <endian.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <optional>
+#include <semaphore.h>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <unistd.h>
+
+namespace Modbus::consumer {
+
+//! register tables of the client
+enum class Table { DO, DI, AO, AI };
+
+//! byte order of the AO/AI registers in shared memory
+enum class Byte_Order {
+    HOST,  //!< host byte order (default of the client)
+    WIRE   //!< modbus byte order (big endian), client option --wire-order
+};
+
+//! order of the registers of 32 bit values
+enum class Word_Order {
+    HIGH_FIRST,  //!< the first register contains the high word (modbus convention)
+    LOW_FIRST    //!< the first register contains the low word
+};
+
+//! representation of multi register values
+struct Format {
+    Byte_Order byte_order = Byte_Order::HOST;
+    Word_Order word_order = Word_Order::HIGH_FIRST;
+};
+
+//! value types that can be stored in registers
+template <typename T>
+concept Register_Value = std::same_as<T, std::uint16_t> || std::same_as<T, std::int16_t> ||
+                         std::same_as<T, std::uint32_t> || std::same_as<T, std::int32_t> || std::same_as<T, float>;
+
+//! number of registers that store one value of type T
+template <Register_Value T>
+inline constexpr std::size_t REGISTERS_PER_VALUE = sizeof(T) / sizeof(std::uint16_t);
+
+/*! \brief decode a value from registers
+ *
+ * @param registers first register of the value
+ * @param format representation of the value
+ * @return decoded value
+ */
+template <Register_Value T>
+T decode(const std::uint16_t *registers, Format format) noexcept {
+    const auto load = [format](std::uint16_t value) -> std::uint16_t {
+        return format.byte_order == Byte_Order::WIRE ? be16toh(value) : value;
+    };
+
+    if constexpr (REGISTERS_PER_VALUE<T> == 1) {
+        return std::bit_cast<T>(load(registers[0]));
+    } else {
+        const bool          high_first = format.word_order == Word_Order::HIGH_FIRST;
+        const std::uint32_t high       = load(registers[high_first ? 0 : 1]);  // NOLINT
+        const std::uint32_t low        = load(registers[high_first ? 1 : 0]);  // NOLINT
+        return std::bit_cast<T>((high << 16) | low);
+    }
+}
+
+/*! \brief encode a value to registers
+ *
+ * @param value value to encode
+ * @param registers first register of the value
+ * @param format representation of the value
+ */
+template <Register_Value T>
+void encode(T value, std::uint16_t *registers, Format format) noexcept {
+    const auto store = [format](std::uint16_t v) -> std::uint16_t {
+        return format.byte_order == Byte_Order::WIRE ? htobe16(v) : v;
+    };
+
+    if constexpr (REGISTERS_PER_VALUE<T> == 1) {
+        registers[0] = store(std::bit_cast<std::uint16_t>(value));
+    } else {
+        const auto raw        = std::bit_cast<std::uint32_t>(value);
+        const bool high_first = format.word_order == Word_Order::HIGH_FIRST;
+
+        registers[high_first ? 0 : 1] = store(static_cast<std::uint16_t>(raw >> 16));  // NOLINT
+        registers[high_first ? 1 : 0] = store(static_cast<std::uint16_t>(raw));        // NOLINT
+    }
+}
+
+/*! \brief typed zero copy view of a register range
+ *
+ * The values are decoded/encoded on each access directly in shared memory.
+ * Accesses are not synchronized with the client. Use Tables::read/Tables::write for consistent multi register values.
+ */
+template <Register_Value T>
+class Typed_View final {
+private:
+    std::span<std::uint16_t> registers;
+    Format                   format;
+
+public:
+    Typed_View(std::span<std::uint16_t> view_registers, Format view_format)
+        : registers(view_registers), format(view_format) {}
+
+    //! number of values
+    [[nodiscard]] std::size_t size() const noexcept { return registers.size() / REGISTERS_PER_VALUE<T>; }
+
+    //! get the value at index
+    [[nodiscard]] T operator[](std::size_t index) const noexcept {
+        return decode<T>(registers.data() + index * REGISTERS_PER_VALUE<T>, format);  // NOLINT
+    }
+
+    //! set the value at index
+    void set(std::size_t index, T value) noexcept {
+        encode<T>(value, registers.data() + index * REGISTERS_PER_VALUE<T>, format);  // NOLINT
+    }
+};
+
+/*! \brief mapping of an existing shared memory object or memory file */
+class Shared_Memory final {
+private:
+    void       *addr = nullptr;
+    std::size_t size = 0;
+
+    void map(int fd, bool read_only, const std::string &name) {
+        addr = mmap(nullptr, size, read_only ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (addr == MAP_FAILED) {  // NOLINT
+            addr = nullptr;
+            throw std::system_error(errno, std::generic_category(), "failed to map '" + name + "'");
+        }
+    }
+
+public:
+    /*! \brief map an existing shared memory object
+     *
+     * @param name name of the shared memory object
+     * @param read_only map the shared memory read only
+     * @exception std::system_error failed to open or map the shared memory object
+     */
+    Shared_Memory(const std::string &name, bool read_only) {
+        const int fd = shm_open(name.c_str(), read_only ? O_RDONLY : O_RDWR, 0);
+        if (fd == -1) throw std::system_error(errno, std::generic_category(), "failed to open '" + name + "'");
+
+        try {
+            struct stat st {};
+            if (fstat(fd, &st))
+                throw std::system_error(errno, std::generic_category(), "failed to stat '" + name + "'");
+            size = static_cast<std::size_t>(st.st_size);
+            map(fd, read_only, name);
+        } catch (const std::system_error &) {
+            close(fd);
+            throw;
+        }
+        close(fd);
+    }
+
+    /*! \brief map a memory file with sealed size (received from the client)
+     *
+     * The file descriptor is not closed.
+     *
+     * @param fd file descriptor of the memory file
+     * @param expected_size size of the memory file
+     * @param read_only map the memory read only
+     * @param name name of the memory file (for error messages)
+     * @exception std::system_error failed to map the memory file
+     * @exception std::runtime_error size of the memory file is not sealed or does not match
+     */
+    Shared_Memory(int fd, std::size_t expected_size, bool read_only, const std::string &name) : size(expected_size) {
+        struct stat st {};
+        if (fstat(fd, &st)) throw std::system_error(errno, std::generic_category(), "failed to stat '" + name + "'");
+
+        const int seals = fcntl(fd, F_GET_SEALS);
+        if (seals == -1 || (seals & (F_SEAL_GROW | F_SEAL_SHRINK)) != (F_SEAL_GROW | F_SEAL_SHRINK))
+            throw std::runtime_error("size of '" + name + "' is not sealed");
+        if (static_cast<std::size_t>(st.st_size) != expected_size)
+            throw std::runtime_error("unexpected size of '" + name + "'");
+
+        map(fd, read_only, name);
+    }
+
+    ~Shared_Memory() {
+        if (addr) munmap(addr, size);
+    }
+
+    Shared_Memory(const Shared_Memory &other)            = delete;
+    Shared_Memory(Shared_Memory &&other)                 = delete;
+    Shared_Memory &operator=(const Shared_Memory &other) = delete;
+    Shared_Memory &operator=(Shared_Memory &&other)      = delete;
+
+    [[nodiscard]] void       *get_addr() const noexcept { return addr; }
+    [[nodiscard]] std::size_t get_size() const noexcept { return size; }
+};
+
+/*! \brief memory files received from the client (client option --storage memfd:<socket>)
+ *
+ * The client sends one message with a memfd_descriptor_t and the file descriptors of the tables (SCM_RIGHTS)
+ * to each process that connects to the socket and closes the connection afterward.
+ */
+class Memfd_Receiver final {
+public:
+    static constexpr std::uint32_t MAGIC           = 0x46444D4D;  //!< "MMDF"
+    static constexpr std::uint32_t VERSION         = 1;           //!< protocol version
+    static constexpr std::uint32_t FLAG_WIRE_ORDER = 0x1;         //!< registers are stored big endian
+
+    //! message that is sent with the file descriptors
+    struct memfd_descriptor_t {
+        std::uint32_t                magic;    //!< MAGIC
+        std::uint32_t                version;  //!< VERSION
+        std::uint32_t                flags;    //!< FLAG_*
+        std::uint32_t                reserved;
+        std::array<std::uint32_t, 4> values;  //!< number of values per table (DO, DI, AO, AI)
+    };
+
+private:
+    memfd_descriptor_t descriptor {};
+    std::array<int, 4> fds {-1, -1, -1, -1};
+
+public:
+    /*! \brief receive the memory files
+     *
+     * @param path path of the unix domain socket of the client
+     * @exception std::system_error failed to receive the memory files
+     * @exception std::runtime_error invalid message
+     */
+    explicit Memfd_Receiver(const std::string &path) {
+        sockaddr_un addr {};
+        addr.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(addr.sun_path)) throw std::runtime_error("socket path too long: " + path);
+        std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);  // NOLINT
+
+        const int sock = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+        if (sock == -1) throw std::system_error(errno, std::generic_category(), "failed to create socket");
+
+        if (connect(sock, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr))) {  // NOLINT
+            const int error = errno;
+            close(sock);
+            throw std::system_error(error, std::generic_category(), "failed to connect to '" + path + "'");
+        }
+
+        iovec iov {};
+        iov.iov_base = &descriptor;
+        iov.iov_len  = sizeof(descriptor);
+
+        alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(int) * 4)> control {};
+        msghdr msg {};
+        msg.msg_iov        = &iov;
+        msg.msg_iovlen     = 1;
+        msg.msg_control    = control.data();
+        msg.msg_controllen = control.size();
+
+        ssize_t received = 0;
+        do {
+            received = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC);
+        } while (received == -1 && errno == EINTR);
+        const int error = errno;
+        close(sock);
+        if (received == -1) throw std::system_error(error, std::generic_category(), "failed to receive memfds");
+
+        // received file descriptors that are not used (not exactly 4 in one message) are closed
+        for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) continue;
+
+            const std::size_t count  = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            const bool        accept = count == fds.size() && fds[0] == -1;
+            for (std::size_t i = 0; i < count; ++i) {
+                int fd = -1;
+                std::memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));  // NOLINT
+                if (accept) {
+                    fds[i] = fd;  // NOLINT
+                } else {
+                    close(fd);
+                }
+            }
+        }
+
+        if (static_cast<std::size_t>(received) != sizeof(descriptor) || (msg.msg_flags & (MSG_CTRUNC | MSG_TRUNC)) ||
+            descriptor.magic != MAGIC || descriptor.version != VERSION || fds[0] == -1) {
+            release();
+            throw std::runtime_error("invalid memfd message from '" + path + "'");
+        }
+    }
+
+    ~Memfd_Receiver() { release(); }
+
+    Memfd_Receiver(const Memfd_Receiver &other)            = delete;
+    Memfd_Receiver(Memfd_Receiver &&other)                 = delete;
+    Memfd_Receiver &operator=(const Memfd_Receiver &other) = delete;
+    Memfd_Receiver &operator=(Memfd_Receiver &&other)      = delete;
+
+    //! close the received file descriptors
+    void release() noexcept {
+        for (auto &fd : fds) {
+            if (fd != -1) close(fd);
+            fd = -1;
+        }
+    }
+
+    [[nodiscard]] const memfd_descriptor_t &get_descriptor() const noexcept { return descriptor; }
+
+    //! file descriptor of a table
+    [[nodiscard]] int get_fd(Table table) const noexcept { return fds[static_cast<std::size_t>(table)]; }  // NOLINT
+
+    //! size of a table in bytes
+    [[nodiscard]] std::size_t get_size(Table table) const noexcept {
+        const std::size_t values = descriptor.values[static_cast<std::size_t>(table)];  // NOLINT
+        return table == Table::AO || table == Table::AI ? values * sizeof(std::uint16_t) : values;
+    }
+};
+
+/*! \brief existing named semaphore of the client (option --semaphore)
+ *
+ * Satisfies the BasicLockable requirements (usable with std::lock_guard).
+ */
+class Semaphore final {
+private:
+    sem_t *sem;
+
+public:
+    /*! \brief open the semaphore
+     *
+     * @param name name of the semaphore
+     * @exception std::system_error failed to open the semaphore
+     */
+    explicit Semaphore(const std::string &name) : sem(sem_open(name.c_str(), 0)) {
+        if (sem == SEM_FAILED)  // NOLINT
+            throw std::system_error(errno, std::generic_category(), "failed to open semaphore '" + name + "'");
+    }
+
+    ~Semaphore() { sem_close(sem); }
+
+    Semaphore(const Semaphore &other)            = delete;
+    Semaphore(Semaphore &&other)                 = delete;
+    Semaphore &operator=(const Semaphore &other) = delete;
+    Semaphore &operator=(Semaphore &&other)      = delete;
+
+    void lock() {
+        while (sem_wait(sem) == -1) {
+            if (errno != EINTR) throw std::system_error(errno, std::generic_category(), "failed to acquire semaphore");
+        }
+    }
+
+    void unlock() noexcept { sem_post(sem); }
+};
+
+/*! \brief attached register tables of a client */
+class Tables final {
+public:
+    //! attach options
+    struct Options {
+        std::string prefix    = "modbus_";  //!< shared memory name prefix of the client (option --name-prefix)
+        std::string socket    = {};         //!< memfd socket of the client (option --storage memfd:<socket>)
+        std::string semaphore = {};         //!< semaphore of the client (option --semaphore), empty: no locking
+        bool        read_only = false;      //!< map the shared memory objects read only
+        Format      format    = {};         //!< default representation of multi register values
+    };
+
+private:
+    static constexpr std::array<const char *, 4> TABLE_NAMES = {"DO", "DI", "AO", "AI"};
+
+    std::array<std::optional<Shared_Memory>, 4> shm;
+    std::optional<Semaphore>                    semaphore;
+    Format                                      format;
+
+    //* lock the semaphore (if used) for the lifetime of the object
+    struct Guard {
+        Semaphore *sem;
+        explicit Guard(std::optional<Semaphore> &semaphore) : sem(semaphore ? &*semaphore : nullptr) {
+            if (sem) sem->lock();
+        }
+        ~Guard() {
+            if (sem) sem->unlock();
+        }
+        Guard(const Guard &other)            = delete;
+        Guard(Guard &&other)                 = delete;
+        Guard &operator=(const Guard &other) = delete;
+        Guard &operator=(Guard &&other)      = delete;
+    };
+
+    static void check_range(std::size_t address, std::size_t count, std::size_t size) {
+        if (address + count > size) throw std::out_of_range("address range exceeds the register table");
+    }
+
+public:
+    /*! \brief attach to the register tables of a running client
+     *
+     * If a socket is specified, the tables are received from the client as memory files.
+     * The byte order of the registers is taken from the client in this case (options.format.byte_order is ignored).
+     * Otherwise, the shared memory objects <prefix>DO, <prefix>DI, <prefix>AO and <prefix>AI are used.
+     *
+     * @param options attach options
+     * @exception std::system_error failed to attach to the register tables or the semaphore
+     * @exception std::runtime_error invalid memory files received
+     */
+    explicit Tables(const Options &options) : format(options.format) {
+        if (options.socket.empty()) {
+            for (std::size_t i = 0; i < shm.size(); ++i)
+                shm[i].emplace(options.prefix + TABLE_NAMES[i], options.read_only);  // NOLINT
+        } else {
+            const Memfd_Receiver receiver(options.socket);
+            format.byte_order = receiver.get_descriptor().flags & Memfd_Receiver::FLAG_WIRE_ORDER ? Byte_Order::WIRE
+                                                                                                  : Byte_Order::HOST;
+            for (std::size_t i = 0; i < shm.size(); ++i) {
+                const auto table = static_cast<Table>(i);
+                shm[i].emplace(receiver.get_fd(table),  // NOLINT
+                               receiver.get_size(table),
+                               options.read_only,
+                               options.socket + ":" + TABLE_NAMES[i]);  // NOLINT
+            }
+        }
+
+        if (!options.semaphore.empty()) semaphore.emplace(options.semaphore);
+    }
+
+    //! coils of DO or DI (one byte per coil)
+    [[nodiscard]] std::span<std::uint8_t> bits(Table table) const {
+        if (table != Table::DO && table != Table::DI) throw std::invalid_argument("not a coil table");
+        const auto &table_shm = shm[static_cast<std::size_t>(table)];  // NOLINT
+        return {static_cast<std::uint8_t *>(table_shm->get_addr()), table_shm->get_size()};
+    }
+
+    //! registers of AO or AI
+    [[nodiscard]] std::span<std::uint16_t> registers(Table table) const {
+        if (table != Table::AO && table != Table::AI) throw std::invalid_argument("not a register table");
+        const auto &table_shm = shm[static_cast<std::size_t>(table)];  // NOLINT
+        return {static_cast<std::uint16_t *>(table_shm->get_addr()), table_shm->get_size() / sizeof(std::uint16_t)};
+    }
+
+    //! default representation of multi register values (byte order of the client in case of memory files)
+    [[nodiscard]] const Format &get_format() const noexcept { return format; }
+
+    /*! \brief get a typed zero copy view of a register range
+     *
+     * @param table AO or AI
+     * @param address first register
+     * @param count number of values
+     * @param view_format representation of the values
+     */
+    template <Register_Value T>
+    [[nodiscard]] Typed_View<T> view(Table table, std::size_t address, std::size_t count, Format view_format) const {
+        const auto regs = registers(table);
+        check_range(address, count * REGISTERS_PER_VALUE<T>, regs.size());
+        return Typed_View<T>(regs.subspan(address, count * REGISTERS_PER_VALUE<T>), view_format);
+    }
+
+    template <Register_Value T>
+    [[nodiscard]] Typed_View<T> view(Table table, std::size_t address, std::size_t count) const {
+        return view<T>(table, address, count, format);
+    }
+
+    /*! \brief read a range of coils
+     *
+     * The semaphore is only held while the coils are copied.
+     *
+     * @param table DO or DI
+     * @param address first coil
+     * @param values output
+     */
+    void read(Table table, std::size_t address, std::span<std::uint8_t> values) {
+        const auto src = bits(table);
+        check_range(address, values.size(), src.size());
+
+        const Guard guard(semaphore);
+        std::memcpy(values.data(), src.data() + address, values.size());  // NOLINT
+    }
+
+    /*! \brief write a range of coils
+     *
+     * @param table DO or DI
+     * @param address first coil
+     * @param values values to write
+     */
+    void write(Table table, std::size_t address, std::span<const std::uint8_t> values) {
+        const auto dst = bits(table);
+        check_range(address, values.size(), dst.size());
+
+        const Guard guard(semaphore);
+        std::memcpy(dst.data() + address, values.data(), values.size());  // NOLINT
+    }
+
+    /*! \brief read a range of values
+     *
+     * The raw registers are copied to the output buffer while the semaphore is held.
+     * The values are decoded in place after the semaphore is released.
+     *
+     * @param table AO or AI
+     * @param address first register
+     * @param values output
+     * @param read_format representation of the values
+     */
+    template <Register_Value T, std::size_t Extent>
+    void read(Table table, std::size_t address, std::span<T, Extent> values, Format read_format) {
+        const auto        src   = registers(table);
+        const std::size_t count = values.size() * REGISTERS_PER_VALUE<T>;
+        check_range(address, count, src.size());
+
+        auto *raw = reinterpret_cast<std::uint8_t *>(values.data());  // NOLINT
+        {
+            const Guard guard(semaphore);
+            std::memcpy(raw, src.data() + address, count * sizeof(std::uint16_t));  // NOLINT
+        }
+
+        // value i occupies exactly the registers it is decoded from
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            std::array<std::uint16_t, REGISTERS_PER_VALUE<T>> words {};
+            std::memcpy(words.data(), raw + i * sizeof(T), sizeof(T));  // NOLINT
+            values[i] = decode<T>(words.data(), read_format);
+        }
+    }
+
+    template <Register_Value T, std::size_t Extent>
+    void read(Table table, std::size_t address, std::span<T, Extent> values) {
+        read(table, address, values, format);
+    }
+
+    /*! \brief write a range of values
+     *
+     * The values are encoded directly into shared memory while the semaphore is held.
+     *
+     * @param table AO or AI
+     * @param address first register
+     * @param values values to write
+     * @param write_format representation of the values
+     */
+    template <typename T, std::size_t Extent>
+        requires Register_Value<std::remove_const_t<T>>
+    void write(Table table, std::size_t address, std::span<T, Extent> values, Format write_format) {
+        const auto        dst   = registers(table);
+        const std::size_t count = values.size() * REGISTERS_PER_VALUE<std::remove_const_t<T>>;
+        check_range(address, count, dst.size());
+
+        using Value = std::remove_const_t<T>;
+
+        std::uint16_t *regs = dst.data() + address;  // NOLINT
+        const Guard    guard(semaphore);
+        for (std::size_t i = 0; i < values.size(); ++i)
+            encode<Value>(values[i], regs + i * REGISTERS_PER_VALUE<Value>, write_format);  // NOLINT
+    }
+
+    template <typename T, std::size_t Extent>
+        requires Register_Value<std::remove_const_t<T>>
+    void write(Table table, std::size_t address, std::span<T, Extent> values) {
+        write(table, address, values, format);
+    }
+};
+
+/*! \brief wait for write requests of the modbus master
+ *
+ * Requires the write journal of the client (option --write-journal).
+ */
+class Change_Notifier final {
+public:
+    static constexpr std::uint32_t JOURNAL_MAGIC   = 0x4A574D4D;  //!< "MMWJ"
+    static constexpr std::uint32_t JOURNAL_VERSION = 1;
+
+    //! header of the write journal (layout of the client)
+    struct journal_header_t {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t capacity;
+        std::uint32_t entry_size;
+        std::uint64_t head;    //!< sequence number of the newest entry
+        std::uint32_t notify;  //!< futex word, incremented after each new entry
+        std::uint32_t reserved;
+    };
+
+private:
+    Shared_Memory     shm;
+    journal_header_t *header;
+    std::uint32_t     seen;  //!< last seen value of the futex word
+
+public:
+    /*! \brief attach to the write journal
+     *
+     * @param prefix shared memory name prefix of the client (option --name-prefix)
+     * @exception std::system_error failed to attach to the write journal
+     * @exception std::runtime_error invalid write journal
+     */
+    explicit Change_Notifier(const std::string &prefix)
+        : shm(prefix + "write_journal", true), header(static_cast<journal_header_t *>(shm.get_addr())) {
+        if (shm.get_size() < sizeof(journal_header_t) ||
+            std::atomic_ref(header->magic).load(std::memory_order_acquire) != JOURNAL_MAGIC ||
+            header->version != JOURNAL_VERSION)
+            throw std::runtime_error("invalid write journal '" + prefix + "write_journal'");
+        seen = std::atomic_ref(header->notify).load(std::memory_order_acquire);
+    }
+
+    /*! \brief wait until the modbus master wrote registers since the last call
+     *
+     * @param timeout maximum time to wait
+     * @return true if registers were written, false on timeout
+     */
+    bool wait(std::chrono::nanoseconds timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            const auto current = std::atomic_ref(header->notify).load(std::memory_order_acquire);
+            if (current != seen) {
+                seen = current;
+                return true;
+            }
+
+            const auto remaining = deadline - std::chrono::steady_clock::now();
+            if (remaining <= std::chrono::nanoseconds::zero()) return false;
+
+            const auto      seconds = std::chrono::duration_cast<std::chrono::seconds>(remaining);
+            struct timespec ts {};
+            ts.tv_sec  = seconds.count();
+            ts.tv_nsec = (remaining - seconds).count();
+            syscall(SYS_futex, &header->notify, FUTEX_WAIT, current, &ts, nullptr, 0);
+        }
+    }
+
+    //! sequence number of the newest journal entry
+    [[nodiscard]] std::uint64_t head() const noexcept {
+        return std::atomic_ref(header->head).load(std::memory_order_acquire);
+    }
+};
+
+/*! \brief synchronize with the commits of staged writes
+ *
+ * Requires the write staging of the client (option --write-staging).
+ * The visible DO/AO tables are only modified by commits, which are protected by a sequence lock.
+ */
+class Commit_Sync final {
+public:
+    static constexpr std::uint32_t STAGING_MAGIC   = 0x53574D4D;  //!< "MMWS"
+    static constexpr std::uint32_t STAGING_VERSION = 1;
+
+    //! staging shared memory (layout of the client)
+    struct staging_t {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t sequence;  //!< futex word: sequence lock (odd while a commit is in progress)
+        std::uint32_t tick;      //!< futex word: incremented to request a commit
+        std::uint64_t commits;   //!< number of commits
+    };
+
+private:
+    Shared_Memory shm;
+    staging_t    *staging;
+    std::uint32_t seen;  //!< last seen sequence number
+
+    static void futex_wait(std::uint32_t *word, std::uint32_t expected, std::chrono::nanoseconds timeout) noexcept {
+        const auto      seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+        struct timespec ts {};
+        ts.tv_sec  = seconds.count();
+        ts.tv_nsec = (timeout - seconds).count();
+        syscall(SYS_futex, word, FUTEX_WAIT, expected, &ts, nullptr, 0);
+    }
+
+public:
+    /*! \brief attach to the write staging
+     *
+     * @param prefix shared memory name prefix of the client (option --name-prefix)
+     * @exception std::system_error failed to attach to the write staging
+     * @exception std::runtime_error invalid write staging
+     */
+    explicit Commit_Sync(const std::string &prefix)
+        : shm(prefix + "staging", false), staging(static_cast<staging_t *>(shm.get_addr())) {
+        if (shm.get_size() < sizeof(staging_t) ||
+            std::atomic_ref(staging->magic).load(std::memory_order_acquire) != STAGING_MAGIC ||
+            staging->version != STAGING_VERSION)
+            throw std::runtime_error("invalid write staging '" + prefix + "staging'");
+        seen = std::atomic_ref(staging->sequence).load(std::memory_order_acquire) & ~1U;
+    }
+
+    //! request a commit (only effective if the client was started with the trigger 'tick')
+    void request_commit() noexcept {
+        std::atomic_ref(staging->tick).fetch_add(1, std::memory_order_release);
+        syscall(SYS_futex, &staging->tick, FUTEX_WAKE, 1, nullptr, nullptr, 0);
+    }
+
+    /*! \brief wait for the next commit since the last call
+     *
+     * @param timeout maximum time to wait
+     * @return true if a commit was completed, false on timeout
+     */
+    bool wait(std::chrono::nanoseconds timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            const auto current = std::atomic_ref(staging->sequence).load(std::memory_order_acquire);
+            if (!(current & 1U) && current != seen) {
+                seen = current;
+                return true;
+            }
+
+            const auto remaining = deadline - std::chrono::steady_clock::now();
+            if (remaining <= std::chrono::nanoseconds::zero()) return false;
+            futex_wait(&staging->sequence, current, remaining);
+        }
+    }
+
+    /*! \brief read the DO/AO tables without a commit in between
+     *
+     * The function is repeated until it was executed without a concurrent commit.
+     * It must only read from the tables.
+     *
+     * @param function reads the tables
+     */
+    template <typename Function>
+    void read(Function &&function) {
+        for (;;) {
+            const auto before = std::atomic_ref(staging->sequence).load(std::memory_order_acquire);
+            if (before & 1U) {
+                futex_wait(&staging->sequence, before, std::chrono::milliseconds(1));
+                continue;
+            }
+
+            function();
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (std::atomic_ref(staging->sequence).load(std::memory_order_relaxed) == before) return;
+        }
+    }
+
+    //! number of completed commits
+    [[nodiscard]] std::uint64_t commits() const noexcept {
+        return std::atomic_ref(staging->commits).load(std::memory_order_relaxed);
+    }
+};
+
+/*! \brief size of the register tables of a client with resizable tables
+ *
+ * Requires the option --resizable of the client.
+ * If the generation changes, a table was resized and the shared memory objects have to be mapped again
+ * (e.g. by creating a new Tables object). Registers beyond the new size of a shrunk table must not be accessed.
+ */
+class Table_Layout final {
+public:
+    static constexpr std::uint32_t LAYOUT_MAGIC   = 0x4C544D4D;  //!< "MMTL"
+    static constexpr std::uint32_t LAYOUT_VERSION = 1;
+
+    //! layout shared memory (layout of the client)
+    struct layout_t {
+        std::uint32_t                magic;
+        std::uint32_t                version;
+        std::uint32_t                generation;  //!< futex word: incremented after each resize
+        std::uint32_t                reserved;
+        std::array<std::uint32_t, 4> counts;  //!< number of registers per table (DO, DI, AO, AI)
+    };
+
+private:
+    Shared_Memory shm;
+    layout_t     *layout;
+
+public:
+    /*! \brief attach to the table layout
+     *
+     * @param prefix shared memory name prefix of the client (option --name-prefix)
+     * @exception std::system_error failed to attach to the table layout
+     * @exception std::runtime_error invalid table layout
+     */
+    explicit Table_Layout(const std::string &prefix)
+        : shm(prefix + "layout", true), layout(static_cast<layout_t *>(shm.get_addr())) {
+        if (shm.get_size() < sizeof(layout_t) ||
+            std::atomic_ref(layout->magic).load(std::memory_order_acquire) != LAYOUT_MAGIC ||
+            layout->version != LAYOUT_VERSION)
+            throw std::runtime_error("invalid table layout '" + prefix + "layout'");
+    }
+
+    //! current generation (incremented after each resize)
+    [[nodiscard]] std::uint32_t generation() const noexcept {
+        return std::atomic_ref(layout->generation).load(std::memory_order_acquire);
+    }
+
+    //! current number of registers of a table
+    [[nodiscard]] std::size_t count(Table table) const noexcept {
+        return std::atomic_ref(layout->counts[static_cast<std::size_t>(table)]).load(std::memory_order_relaxed);
+    }
+
+    /*! \brief wait until the generation differs from a known generation
+     *
+     * @param known known generation
+     * @param timeout maximum time to wait
+     * @return true if the generation changed, false on timeout
+     */
+    bool wait(std::uint32_t known, std::chrono::nanoseconds timeout) const {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            if (generation() != known) return true;
+
+            const auto remaining = deadline - std::chrono::steady_clock::now();
+            if (remaining <= std::chrono::nanoseconds::zero()) return false;
+
+            const auto      seconds = std::chrono::duration_cast<std::chrono::seconds>(remaining);
+            struct timespec ts {};
+            ts.tv_sec  = seconds.count();
+            ts.tv_nsec = (remaining - seconds).count();
+            syscall(SYS_futex, &layout->generation, FUTEX_WAIT, known, &ts, nullptr, 0);
+        }
+    }
+};
+
+/*! \brief producer that updates DI/AI registers on demand (client option --read-doorbell)
+ *
+ * The producer attaches by storing its pid in a free slot of the doorbell and detaches in the destructor.
+ * The slot of a terminated producer is cleared by the client. The producer must run in the same pid namespace as
+ * the client.
+ */
+class Doorbell_Producer final {
+public:
+    static constexpr std::uint32_t DOORBELL_MAGIC   = 0x42444D4D;  //!< "MMDB"
+    static constexpr std::uint32_t DOORBELL_VERSION = 2;
+    static constexpr std::size_t   MAX_PRODUCERS    = 8;
+
+    //! doorbell shared memory (layout of the client)
+    struct doorbell_t {
+        std::uint32_t                           magic;
+        std::uint32_t                           version;
+        std::uint32_t                           request;  //!< futex word: request sequence number
+        std::uint32_t                           ack;      //!< futex word: last acknowledged sequence number
+        std::uint8_t                            table;
+        std::uint8_t                            reserved;
+        std::uint16_t                           address;
+        std::uint16_t                           quantity;
+        std::uint16_t                           reserved2;
+        std::array<std::int32_t, MAX_PRODUCERS> producers;  //!< pids of the attached producers (0: free slot)
+    };
+
+    //! requested registers
+    struct request_t {
+        Table         table;  //!< Table::DI or Table::AI
+        std::uint16_t address;
+        std::uint16_t quantity;
+    };
+
+private:
+    Shared_Memory shm;
+    doorbell_t   *doorbell;
+    std::size_t   slot = 0;  //!< producer slot of this producer
+    std::uint32_t seen;      //!< last seen request sequence number
+
+public:
+    /*! \brief attach to the read doorbell
+     *
+     * @param prefix shared memory name prefix of the client (option --name-prefix)
+     * @exception std::system_error failed to attach to the read doorbell
+     * @exception std::runtime_error invalid read doorbell or no free producer slot
+     */
+    explicit Doorbell_Producer(const std::string &prefix)
+        : shm(prefix + "read_doorbell", false), doorbell(static_cast<doorbell_t *>(shm.get_addr())) {
+        if (shm.get_size() < sizeof(doorbell_t) ||
+            std::atomic_ref(doorbell->magic).load(std::memory_order_acquire) != DOORBELL_MAGIC ||
+            doorbell->version != DOORBELL_VERSION)
+            throw std::runtime_error("invalid read doorbell '" + prefix + "read_doorbell'");
+
+        seen = std::atomic_ref(doorbell->request).load(std::memory_order_acquire);
+        for (; slot < MAX_PRODUCERS; ++slot) {
+            std::int32_t expected = 0;
+            if (std::atomic_ref(doorbell->producers[slot]).compare_exchange_strong(expected, getpid()))  // NOLINT
+                return;
+        }
+        throw std::runtime_error("no free producer slot in read doorbell '" + prefix + "read_doorbell'");
+    }
+
+    ~Doorbell_Producer() { std::atomic_ref(doorbell->producers[slot]).store(0, std::memory_order_release); }  // NOLINT
+
+    Doorbell_Producer(const Doorbell_Producer &)            = delete;
+    Doorbell_Producer(Doorbell_Producer &&)                 = delete;
+    Doorbell_Producer &operator=(const Doorbell_Producer &) = delete;
+    Doorbell_Producer &operator=(Doorbell_Producer &&)      = delete;
+
+    /*! \brief wait for a read request of the modbus master
+     *
+     * Requests that were published while the producer did not wait are combined: only the newest is returned.
+     * Update the registers and call acknowledge() afterward.
+     *
+     * @param timeout maximum time to wait
+     * @return requested registers or std::nullopt on timeout
+     */
+    std::optional<request_t> wait(std::chrono::nanoseconds timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            const auto current = std::atomic_ref(doorbell->request).load(std::memory_order_acquire);
+            if (current != seen) {
+                seen = current;
+                return request_t {
+                        static_cast<Table>(std::atomic_ref(doorbell->table).load(std::memory_order_relaxed)),
+                        std::atomic_ref(doorbell->address).load(std::memory_order_relaxed),
+                        std::atomic_ref(doorbell->quantity).load(std::memory_order_relaxed)};
+            }
+
+            const auto remaining = deadline - std::chrono::steady_clock::now();
+            if (remaining <= std::chrono::nanoseconds::zero()) return std::nullopt;
+
+            const auto      seconds = std::chrono::duration_cast<std::chrono::seconds>(remaining);
+            struct timespec ts {};
+            ts.tv_sec  = seconds.count();
+            ts.tv_nsec = (remaining - seconds).count();
+            syscall(SYS_futex, &doorbell->request, FUTEX_WAIT, current, &ts, nullptr, 0);
+        }
+    }
+
+    //! acknowledge the last request returned by wait() (the registers are updated)
+    void acknowledge() noexcept {
+        std::atomic_ref(doorbell->ack).store(seen, std::memory_order_release);
+        syscall(SYS_futex, &doorbell->ack, FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+    }
+};
+
+/*! \brief producer of a fifo queue that is read by the modbus master (client option --fifo-queue)
+ *
+ * Single producer: only one producer per queue is allowed. No lock is used.
+ * The registers are pushed in the byte order of the register tables (host byte order or modbus byte order if the
+ * client uses the option --wire-order).
+ */
+class Fifo_Producer final {
+public:
+    static constexpr std::uint32_t FIFO_MAGIC   = 0x51464D4D;  //!< "MMFQ"
+    static constexpr std::uint32_t FIFO_VERSION = 1;
+
+    //! fifo shared memory (the registers follow the header)
+    struct fifo_t {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t capacity;  //!< number of registers (power of 2)
+        std::uint32_t reserved;
+
+        alignas(64) std::uint32_t head;  //!< written by the producer: number of pushed registers
+        alignas(64) std::uint32_t tail;  //!< written by the client: number of read registers
+    };
+
+private:
+    Shared_Memory  shm;
+    fifo_t        *fifo;
+    std::uint16_t *data;
+
+public:
+    /*! \brief attach to a fifo queue
+     *
+     * @param prefix shared memory name prefix of the client (option --name-prefix)
+     * @param address fifo pointer address of the queue
+     * @exception std::system_error failed to attach to the queue
+     * @exception std::runtime_error invalid queue
+     */
+    Fifo_Producer(const std::string &prefix, std::uint16_t address)
+        : shm(prefix + "fifo_" + std::to_string(address), false), fifo(static_cast<fifo_t *>(shm.get_addr())),
+          data(reinterpret_cast<std::uint16_t *>(fifo + 1)) {  // NOLINT
+        if (shm.get_size() < sizeof(fifo_t) ||
+            std::atomic_ref(fifo->magic).load(std::memory_order_acquire) != FIFO_MAGIC ||
+            fifo->version != FIFO_VERSION ||
+            shm.get_size() < sizeof(fifo_t) + std::size_t {fifo->capacity} * sizeof(std::uint16_t))
+            throw std::runtime_error("invalid fifo queue '" + prefix + "fifo_" + std::to_string(address) + "'");
+    }
+
+    //! number of registers that can be pushed
+    [[nodiscard]] std::size_t available() const noexcept {
+        const auto head = std::atomic_ref(fifo->head).load(std::memory_order_relaxed);
+        const auto tail = std::atomic_ref(fifo->tail).load(std::memory_order_acquire);
+        return fifo->capacity - (head - tail);
+    }
+
+    /*! \brief push registers (all or none)
+     *
+     * The registers are visible for the client after all registers are written.
+     *
+     * @param values registers
+     * @return false if the queue has not enough free space
+     */
+    template <std::size_t Extent>
+    bool push(std::span<const std::uint16_t, Extent> values) noexcept {
+        if (values.size() > available()) return false;
+
+        const auto head = std::atomic_ref(fifo->head).load(std::memory_order_relaxed);
+        const auto mask = fifo->capacity - 1;
+        for (std::size_t i = 0; i < values.size(); ++i)
+            data[(head + i) & mask] = values[i];  // NOLINT
+        std::atomic_ref(fifo->head).store(head + static_cast<std::uint32_t>(values.size()), std::memory_order_release);
+        return true;
+    }
+
+    template <std::size_t Extent>
+    bool push(std::span<std::uint16_t, Extent> values) noexcept {
+        return push(std::span<const std::uint16_t, Extent>(values));
+    }
+};
+
+/*! \brief bus utilization and polling cycle statistics of the client (client option --bus-statistics)
+ *
+ * The statistics are updated by the client with every frame on the bus. read() returns a consistent copy
+ * (sequence lock). Times are CLOCK_MONOTONIC timestamps or durations in nanoseconds.
+ */
+class Bus_Statistics final {
+public:
+    static constexpr std::uint32_t STATS_MAGIC   = 0x53424D4D;  //!< "MMBS"
+    static constexpr std::uint32_t STATS_VERSION = 1;
+    static constexpr std::size_t   MAX_CYCLES    = 32;
+    static constexpr std::size_t   GAP_BUCKETS   = 8;
+
+    //! upper bounds of the gap histogram buckets in 1/10 character times (last bucket: larger gaps)
+    static constexpr std::array<std::uint32_t, GAP_BUCKETS - 1> GAP_BOUNDS {35, 50, 100, 200, 500, 1000, 10000};
+
+    //! frame counters
+    struct traffic_t {
+        std::uint64_t frames;
+        std::uint64_t bytes;
+    };
+
+    //! polling cycle of one request (period: time between two identical requests)
+    struct cycle_t {
+        std::uint8_t  slave;  //!< slave id (0: broadcast)
+        std::uint8_t  function;
+        std::uint16_t address;
+        std::uint16_t quantity;
+        std::uint16_t reserved;
+        std::uint64_t periods;  //!< number of measured periods
+        std::uint64_t last;     //!< time of the last request
+        std::uint64_t mean;     //!< mean period
+        std::uint64_t min;      //!< minimum period
+        std::uint64_t max;      //!< maximum period
+        std::uint64_t jitter;   //!< standard deviation of the period
+    };
+
+    //! statistics shared memory (layout of the client)
+    struct stats_t {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t sequence;  //!< sequence lock (odd while an update is in progress)
+        std::uint32_t reserved;
+        std::uint64_t character_time;  //!< time to transmit one character
+
+        std::uint64_t first_frame;  //!< start of the first frame (0: no frame yet)
+        std::uint64_t last_frame;   //!< end of the last frame
+        std::uint64_t busy_time;    //!< sum of the durations of all frames
+        std::uint32_t occupancy;    //!< busy time / (last frame - first frame) in parts per million
+        std::uint32_t own_share;    //!< bytes of the client (requests and responses) / all bytes in ppm
+
+        traffic_t requests;   //!< requests to the client (including broadcasts)
+        traffic_t responses;  //!< responses of the client
+        traffic_t foreign;    //!< frames to other slaves
+        traffic_t errors;     //!< frames with checksum errors
+
+        std::uint64_t                          gaps;  //!< number of inter-frame gaps
+        std::uint64_t                          gap_min;
+        std::uint64_t                          gap_max;
+        std::uint64_t                          gap_sum;
+        std::array<std::uint64_t, GAP_BUCKETS> gap_histogram;  //!< gaps per bucket (see GAP_BOUNDS)
+
+        std::uint32_t                   cycle_count;  //!< number of used entries of cycles
+        std::uint32_t                   reserved2;
+        std::uint64_t                   untracked;  //!< requests that do not fit in cycles
+        std::array<cycle_t, MAX_CYCLES> cycles;
+    };
+
+private:
+    Shared_Memory shm;
+    stats_t      *stats;
+
+public:
+    /*! \brief attach to the bus statistics
+     *
+     * @param prefix shared memory name prefix of the client (option --name-prefix)
+     * @exception std::system_error failed to attach to the bus statistics
+     * @exception std::runtime_error invalid bus statistics
+     */
+    explicit Bus_Statistics(const std::string &prefix)
+        : shm(prefix + "bus_stats", true), stats(static_cast<stats_t *>(shm.get_addr())) {
+        if (shm.get_size() < sizeof(stats_t) ||
+            std::atomic_ref(stats->magic).load(std::memory_order_acquire) != STATS_MAGIC ||
+            stats->version != STATS_VERSION)
+            throw std::runtime_error("invalid bus statistics '" + prefix + "bus_stats'");
+    }
+
+    /*! \brief get a consistent copy of the statistics
+     *
+     * An update of the client takes a few microseconds. If the client was terminated during an update, the
+     * statistics stay inconsistent.
+     *
+     * @param timeout maximum time to wait for a consistent copy
+     * @return statistics or std::nullopt if no consistent copy was possible within the timeout
+     */
+    [[nodiscard]] std::optional<stats_t> read(std::chrono::nanoseconds timeout = std::chrono::milliseconds(10)) const {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        stats_t    copy {};
+        for (;;) {
+            const auto before = std::atomic_ref(stats->sequence).load(std::memory_order_acquire);
+            if (!(before & 1U)) {
+                std::memcpy(&copy, stats, sizeof(copy));
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (std::atomic_ref(stats->sequence).load(std::memory_order_relaxed) == before) return copy;
+            }
+
+            if (std::chrono::steady_clock::now() >= deadline) return std::nullopt;
+            std::this_thread::yield();
+        }
+    }
+};
+
+}  // namespace Modbus::consumer
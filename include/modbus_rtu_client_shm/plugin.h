@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+/*! \file plugin.h
+ * \brief C ABI of modbus-rtu-client-shm data provider plugins
+ *
+ * A plugin is a shared library that is loaded with the command line option --plugin.
+ * It exports the function MODBUS_RTU_CLIENT_PLUGIN_SYMBOL that returns a pointer to a static
+ * modbus_rtu_client_plugin_t.
+ *
+ * All callbacks are called from the thread that serves the modbus requests. If the client uses a semaphore,
+ * before_read and after_write are called while the semaphore is acquired.
+ * The callbacks must not block, as the modbus master waits for the response.
+ *
+ * The register tables of the mapping passed to init stay valid until deinit is called.
+ * Coils use one byte per value. Registers are stored in the byte order of the client (host byte order by default).
+ *
+ * Since api version 2, a plugin can handle function codes (e.g. vendor specific function codes) with the callback
+ * handle_request. Plugins with api version 1 are still supported.
+ */
+
+#ifndef MODBUS_RTU_CLIENT_SHM_PLUGIN_H
+#define MODBUS_RTU_CLIENT_SHM_PLUGIN_H
+
+#include <modbus/modbus.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! plugin api version. Plugins with a newer version are rejected. */
+#define MODBUS_RTU_CLIENT_PLUGIN_API_VERSION 2
+
+/*! oldest supported plugin api version */
+#define MODBUS_RTU_CLIENT_PLUGIN_MIN_API_VERSION 1
+
+/*! name of the function that is exported by a plugin */
+#define MODBUS_RTU_CLIENT_PLUGIN_SYMBOL "modbus_rtu_client_plugin"
+
+/*! register tables */
+#define MODBUS_RTU_CLIENT_PLUGIN_TABLE_DO 0 /*!< discrete output coils */
+#define MODBUS_RTU_CLIENT_PLUGIN_TABLE_DI 1 /*!< discrete input coils */
+#define MODBUS_RTU_CLIENT_PLUGIN_TABLE_AO 2 /*!< output registers */
+#define MODBUS_RTU_CLIENT_PLUGIN_TABLE_AI 3 /*!< input registers */
+
+/*! plugin description */
+typedef struct modbus_rtu_client_plugin {
+    /*! must be MODBUS_RTU_CLIENT_PLUGIN_API_VERSION */
+    uint32_t api_version;
+
+    /*! plugin name (used for log messages) */
+    const char *name;
+
+    /*! \brief initialize the plugin (optional)
+     *
+     * @param context pointer to store a plugin specific context that is passed to all other callbacks
+     * @param argument argument string from the command line (empty string if not specified)
+     * @param mapping register tables of the client
+     * @return 0 on success. Any other value aborts the client.
+     */
+    int (*init)(void **context, const char *argument, modbus_mapping_t *mapping);
+
+    /*! \brief called before a read request is served (optional)
+     *
+     * The plugin can update the requested registers in the mapping.
+     * Only called for valid requests: all requested registers are within the table.
+     *
+     * @param context plugin context
+     * @param function modbus function code
+     * @param table read table (MODBUS_RTU_CLIENT_PLUGIN_TABLE_*)
+     * @param address first read address
+     * @param quantity number of read registers
+     */
+    void (*before_read)(void *context, uint8_t function, uint8_t table, uint16_t address, uint16_t quantity);
+
+    /*! \brief called after a write request was applied to the mapping (optional)
+     *
+     * @param context plugin context
+     * @param function modbus function code
+     * @param table written table (MODBUS_RTU_CLIENT_PLUGIN_TABLE_*)
+     * @param address first written address
+     * @param quantity number of written registers
+     */
+    void (*after_write)(void *context, uint8_t function, uint8_t table, uint16_t address, uint16_t quantity);
+
+    /*! \brief deinitialize the plugin (optional)
+     *
+     * @param context plugin context
+     */
+    void (*deinit)(void *context);
+
+    /* ---------- api version 2 ---------- */
+
+    /*! function codes that are handled by handle_request (optional) */
+    const uint8_t *function_codes;
+
+    /*! number of elements of function_codes */
+    uint32_t function_code_count;
+
+    /*! \brief handle a request with one of the function codes in function_codes (optional)
+     *
+     * The request is not passed to libmodbus. If the client uses a semaphore, it is acquired while the callback is
+     * called. The callback is not called in listen only mode (see option --diagnostics).
+     *
+     * @param context plugin context
+     * @param pdu request pdu (starting with the function code)
+     * @param pdu_length length of the request pdu
+     * @param mapping register tables of the client (the same as passed to init)
+     * @param response response pdu (starting with the function code, MODBUS_MAX_PDU_LENGTH bytes)
+     * @return length of the response pdu, 0: no response, negative value: exception response with the exception code
+     *         -return value (e.g. -MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS). Values below -255 and lengths above
+     *         MODBUS_MAX_PDU_LENGTH are answered with MODBUS_EXCEPTION_SLAVE_OR_SERVER_FAILURE.
+     */
+    int (*handle_request)(
+            void *context, const uint8_t *pdu, int pdu_length, modbus_mapping_t *mapping, uint8_t *response);
+} modbus_rtu_client_plugin_t;
+
+/*! type of the function that is exported by a plugin */
+typedef const modbus_rtu_client_plugin_t *(*modbus_rtu_client_plugin_get_t)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MODBUS_RTU_CLIENT_SHM_PLUGIN_H */
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Address_Range.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <stdexcept>
+
+namespace Modbus {
+
+//* maximum modbus address
+static constexpr unsigned long MAX_ADDRESS = 0xFFFF;
+
+static constexpr std::array<const char *, TABLE_COUNT> TABLE_NAMES = {"DO", "DI", "AO", "AI"};
+
+table_t parse_table(const std::string &str) {
+    std::string upper = str;
+    std::transform(upper.begin(), upper.end(), upper.begin(), [](unsigned char c) {
+        return static_cast<char>(std::toupper(c));
+    });
+
+    for (std::size_t i = 0; i < TABLE_NAMES.size(); ++i)
+        if (upper == TABLE_NAMES[i]) return static_cast<table_t>(i);  // NOLINT
+
+    throw std::invalid_argument("invalid register table '" + str + "' (expected DO, DI, AO or AI)");
+}
+
+const char *table_name(table_t table) noexcept {
+    if (table >= TABLE_COUNT) return "--";
+    return TABLE_NAMES[table];  // NOLINT
+}
+
+static std::uint16_t parse_address(const std::string &str, const std::string &range) {
+    std::size_t   idx   = 0;
+    unsigned long value = 0;
+    try {
+        value = std::stoul(str, &idx, 0);
+    } catch (const std::exception &) { idx = 0; }
+
+    if (str.empty() || idx != str.size() || value > MAX_ADDRESS)
+        throw std::invalid_argument("invalid address '" + str + "' in '" + range + "'");
+
+    return static_cast<std::uint16_t>(value);
+}
+
+Address_Range parse_address_range(const std::string &str) {
+    const auto colon = str.find(':');
+    if (colon == std::string::npos)
+        throw std::invalid_argument("invalid address range '" + str + "' (expected <table>:<first>[-<last>])");
+
+    Address_Range range;
+    range.table = parse_table(str.substr(0, colon));
+
+    const std::string addresses = str.substr(colon + 1);
+    const auto        dash      = addresses.find('-');
+    range.start                 = parse_address(addresses.substr(0, dash), str);
+    if (dash == std::string::npos) {
+        range.count = 1;
+    } else {
+        const auto last = parse_address(addresses.substr(dash + 1), str);
+        if (last < range.start) throw std::invalid_argument("invalid address range '" + str + "' (last < first)");
+        range.count = static_cast<std::size_t>(last - range.start) + 1;
+    }
+
+    return range;
+}
+
+}  // namespace Modbus
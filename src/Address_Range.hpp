@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Modbus_Request.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Modbus {
+
+//! range of registers in a register table
+struct Address_Range {
+    table_t       table = NO_TABLE;  //!< register table
+    std::uint16_t start = 0;         //!< first address
+    std::size_t   count = 0;         //!< number of registers
+
+    /*! \brief check if an address range is completely inside this range
+     *
+     * @param address first address
+     * @param quantity number of registers
+     * @return true if [address, address + quantity) is inside the range
+     */
+    [[nodiscard]] bool contains(std::size_t address, std::size_t quantity) const noexcept {
+        return address >= start && address + quantity <= start + count;
+    }
+
+    /*! \brief check if an address range has at least one address inside this range
+     *
+     * @param address first address
+     * @param quantity number of registers
+     * @return true if [address, address + quantity) and the range have at least one common address
+     */
+    [[nodiscard]] bool intersects(std::size_t address, std::size_t quantity) const noexcept {
+        return address < start + count && start < address + quantity;
+    }
+
+    /*! \brief check if two ranges overlap
+     *
+     * @param other other range
+     * @return true if both ranges are in the same table and have at least one common address
+     */
+    [[nodiscard]] bool overlaps(const Address_Range &other) const noexcept {
+        return table == other.table && start < other.start + other.count && other.start < start + count;
+    }
+};
+
+/*! \brief parse a register table name
+ *
+ * @param str table name (DO, DI, AO or AI; case insensitive)
+ * @return register table
+ * @exception std::invalid_argument invalid table name
+ */
+table_t parse_table(const std::string &str);
+
+/*! \brief get the name of a register table
+ *
+ * @param table register table
+ * @return table name (DO, DI, AO or AI)
+ */
+const char *table_name(table_t table) noexcept;
+
+/*! \brief parse a register address range
+ *
+ * Format: <table>:<first address>[-<last address>]
+ * Addresses can be specified decimal, hexadecimal (0x) or octal (0).
+ *
+ * @param str string to parse
+ * @return address range
+ * @exception std::invalid_argument invalid format
+ */
+Address_Range parse_address_range(const std::string &str);
+
+/*! \brief check if a table contains coils
+ *
+ * @param table register table
+ * @return true if the table contains coils (DO, DI), false if it contains registers (AO, AI)
+ */
+constexpr bool is_coil_table(table_t table) noexcept {
+    return table == DO || table == DI;
+}
+
+}  // namespace Modbus
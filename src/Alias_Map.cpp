@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Alias_Map.hpp"
+
+#include <stdexcept>
+
+namespace Modbus {
+
+//* get the number of registers of a table
+static std::size_t table_size(const modbus_mapping_t &mapping, table_t table) {
+    switch (table) {
+        case DO: return static_cast<std::size_t>(mapping.nb_bits);
+        case DI: return static_cast<std::size_t>(mapping.nb_input_bits);
+        case AO: return static_cast<std::size_t>(mapping.nb_registers);
+        case AI: return static_cast<std::size_t>(mapping.nb_input_registers);
+        case TABLE_COUNT:
+        default: return 0;
+    }
+}
+
+void Alias_Map::add(const std::string &definition) {
+    const auto separator = definition.find('=');
+    if (separator == std::string::npos)
+        throw std::invalid_argument("invalid alias '" + definition +
+                                    "' (expected <table>:<first>-<last>=<table>:<first>)");
+
+    alias_t alias;
+    alias.window = parse_address_range(definition.substr(0, separator));
+
+    const auto source  = parse_address_range(definition.substr(separator + 1));
+    alias.source       = source.table;
+    alias.source_start = source.start;
+
+    if (is_coil_table(alias.window.table) != is_coil_table(alias.source))
+        throw std::invalid_argument("invalid alias '" + definition + "': coils and registers can not be mixed");
+
+    if ((alias.window.table == DO || alias.window.table == AO) && alias.source != alias.window.table)
+        throw std::invalid_argument("invalid alias '" + definition +
+                                    "': a writable table can only be mapped to the same table");
+
+    if (alias.source_start + alias.window.count > table_size(mapping, alias.source))
+        throw std::invalid_argument("invalid alias '" + definition + "': source range exceeds the register table");
+
+    for (const auto &other : aliases[alias.window.table]) {  // NOLINT
+        if (other.window.overlaps(alias.window))
+            throw std::invalid_argument("invalid alias '" + definition + "': overlaps with another alias");
+    }
+
+    aliases[alias.window.table].emplace_back(alias);  // NOLINT
+}
+
+bool Alias_Map::resolve(const Request &request, modbus_mapping_t &view, Request &translated) const {
+    const auto read_table  = request.read_table();
+    const auto write_table = request.write_table();
+    const auto table       = read_table != NO_TABLE ? read_table : write_table;
+    if (table == NO_TABLE) return false;
+
+    const alias_t *alias   = nullptr;
+    bool           partial = false;
+    for (const auto &a : aliases[table]) {  // NOLINT
+        const bool read_match  = read_table == NO_TABLE || a.window.contains(request.address, request.quantity);
+        const bool write_match = write_table == NO_TABLE ||
+                                 a.window.contains(request.write_address, request.write_quantity);
+        if (read_match && write_match) {
+            alias = &a;
+            break;
+        }
+
+        partial = partial || (read_table != NO_TABLE && a.window.intersects(request.address, request.quantity)) ||
+                  (write_table != NO_TABLE && a.window.intersects(request.write_address, request.write_quantity));
+    }
+
+    if (alias == nullptr) {
+        if (!partial) return false;
+
+        // partially inside a window: the table has no registers in the view (illegal data address)
+        view = mapping;
+        switch (table) {
+            case DO: view.nb_bits = 0; break;
+            case DI: view.nb_input_bits = 0; break;
+            case AO: view.nb_registers = 0; break;
+            case AI: view.nb_input_registers = 0; break;
+            case TABLE_COUNT:
+            default: return false;
+        }
+        translated = request;
+        return true;
+    }
+
+    // create a view of the mapping: the window is the only range of the table
+    view             = mapping;
+    const auto start = static_cast<int>(alias->window.start);
+    const auto count = static_cast<int>(alias->window.count);
+    switch (table) {
+        case DO:
+            view.start_bits = start;
+            view.nb_bits    = count;
+            view.tab_bits   = mapping.tab_bits + alias->source_start;  // NOLINT
+            break;
+        case DI:
+            view.start_input_bits = start;
+            view.nb_input_bits    = count;
+            view.tab_input_bits   = (alias->source == DO ? mapping.tab_bits : mapping.tab_input_bits) +  // NOLINT
+                                  alias->source_start;
+            break;
+        case AO:
+            view.start_registers = start;
+            view.nb_registers    = count;
+            view.tab_registers   = mapping.tab_registers + alias->source_start;  // NOLINT
+            break;
+        case AI:
+            view.start_input_registers = start;
+            view.nb_input_registers    = count;
+            view.tab_input_registers   = (alias->source == AO ? mapping.tab_registers  // NOLINT
+                                                              : mapping.tab_input_registers) +
+                                       alias->source_start;
+            break;
+        case TABLE_COUNT:
+        default: return false;
+    }
+
+    const auto translate = [alias](std::uint16_t address) {
+        return static_cast<std::uint16_t>(address - alias->window.start + alias->source_start);
+    };
+    const auto read_address  = read_table != NO_TABLE ? translate(request.address) : request.address;
+    const auto write_address = write_table != NO_TABLE ? translate(request.write_address) : request.write_address;
+    translated               = request.translated(alias->source, read_address, write_address);
+    return true;
+}
+
+bool Alias_Map::empty() const noexcept {
+    for (const auto &table_aliases : aliases)
+        if (!table_aliases.empty()) return false;
+    return true;
+}
+
+}  // namespace Modbus
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Address_Range.hpp"
+#include "Modbus_Request.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace Modbus {
+
+/*! \brief alias address ranges that are served from another range of the register tables
+ *
+ * An alias maps an address window of a table to a range of the same or another table of the same kind
+ * (coils or registers). Requests that are completely inside an alias window are served directly from the
+ * source range. No data is copied: the request is served with a view of the mapping whose table pointer
+ * and start address are adjusted to the window.
+ * Requests that are only partially inside a window are served with a view without registers in the table, so they
+ * are answered with an illegal data address exception (no mix of aliased and unaliased registers).
+ *
+ * Windows of writable tables (DO, AO) can only be mapped to the same table, so a master can never write
+ * into the input tables.
+ */
+class Alias_Map final {
+private:
+    //! alias definition
+    struct alias_t {
+        Address_Range window;        //!< address window that is visible for the master
+        table_t       source;        //!< table that contains the data
+        std::uint16_t source_start;  //!< first address of the data in the source table
+    };
+
+    const modbus_mapping_t                       &mapping;  //!< mapping that contains the data
+    std::array<std::vector<alias_t>, TABLE_COUNT> aliases;  //!< aliases per (visible) table
+
+public:
+    /*! \brief create an empty alias map
+     *
+     * @param mapping mapping that contains the data
+     */
+    explicit Alias_Map(const modbus_mapping_t &mapping) : mapping(mapping) {}
+
+    /*! \brief add an alias
+     *
+     * Format: <table>:<first>-<last>=<source table>:<source first>
+     *
+     * Example: AI:100-199=AO:0 (input registers 100 to 199 are served from holding registers 0 to 99)
+     *
+     * @param definition alias definition
+     * @exception std::invalid_argument invalid alias definition
+     */
+    void add(const std::string &definition);
+
+    /*! \brief resolve the aliases of a request
+     *
+     * @param request received request
+     * @param view output: view of the mapping that serves the request (only written if an alias is used)
+     * @param translated output: request with the addresses that are actually accessed (only written if an alias is
+     *                   used)
+     * @return true if the request is served from an alias (or rejected: partially inside a window)
+     */
+    bool resolve(const Request &request, modbus_mapping_t &view, Request &translated) const;
+
+    /*! \brief check if aliases are defined
+     *
+     * @return true if no alias is defined
+     */
+    [[nodiscard]] bool empty() const noexcept;
+};
+
+}  // namespace Modbus
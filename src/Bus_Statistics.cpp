@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Bus_Statistics.hpp"
+
+#include "modbus_rtu_client_shm/consumer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+namespace Modbus::shm {
+
+// the consumer library accesses the statistics with its own definition
+using consumer_stats_t = consumer::Bus_Statistics::stats_t;
+static_assert(consumer::Bus_Statistics::STATS_MAGIC == Bus_Statistics::MAGIC);
+static_assert(consumer::Bus_Statistics::STATS_VERSION == Bus_Statistics::VERSION);
+static_assert(consumer::Bus_Statistics::MAX_CYCLES == Bus_Statistics::MAX_CYCLES);
+static_assert(consumer::Bus_Statistics::GAP_BOUNDS == Bus_Statistics::GAP_BOUNDS);
+static_assert(sizeof(consumer::Bus_Statistics::traffic_t) == sizeof(Bus_Statistics::traffic_t));
+static_assert(sizeof(consumer::Bus_Statistics::cycle_t) == sizeof(Bus_Statistics::cycle_t));
+static_assert(offsetof(consumer::Bus_Statistics::cycle_t, periods) == offsetof(Bus_Statistics::cycle_t, periods));
+static_assert(sizeof(consumer_stats_t) == sizeof(Bus_Statistics::stats_t));
+static_assert(offsetof(consumer_stats_t, sequence) == offsetof(Bus_Statistics::stats_t, sequence));
+static_assert(offsetof(consumer_stats_t, occupancy) == offsetof(Bus_Statistics::stats_t, occupancy));
+static_assert(offsetof(consumer_stats_t, requests) == offsetof(Bus_Statistics::stats_t, requests));
+static_assert(offsetof(consumer_stats_t, gap_histogram) == offsetof(Bus_Statistics::stats_t, gap_histogram));
+static_assert(offsetof(consumer_stats_t, cycle_count) == offsetof(Bus_Statistics::stats_t, cycle_count));
+static_assert(offsetof(consumer_stats_t, cycles) == offsetof(Bus_Statistics::stats_t, cycles));
+
+//* parts per million
+static constexpr double PPM = 1e6;
+
+//* number of nanoseconds per second
+static constexpr double NS_PER_SECOND = 1e9;
+
+Bus_Statistics::Bus_Statistics(const std::string &name,
+                               int                baud,
+                               int                data_bits,
+                               char               parity,
+                               int                stop_bits,
+                               bool               force,
+                               mode_t             permissions)
+    : character_time(static_cast<double>(1 + data_bits + (parity == 'N' ? 0 : 1) + stop_bits) * NS_PER_SECOND /
+                     baud) {
+    shm = std::make_unique<cxxshm::SharedMemory>(name, sizeof(stats_t), false, !force, permissions);
+
+    stats = static_cast<stats_t *>(shm->get_addr());
+    std::memset(stats, 0, sizeof(stats_t));
+    stats->version        = VERSION;
+    stats->character_time = static_cast<std::uint64_t>(std::llround(character_time));
+    std::atomic_ref(stats->magic).store(MAGIC, std::memory_order_release);
+}
+
+void Bus_Statistics::begin() noexcept {
+    std::atomic_ref sequence(stats->sequence);
+    sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void Bus_Statistics::end() noexcept {
+    std::atomic_ref sequence(stats->sequence);
+    sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+std::uint64_t Bus_Statistics::duration(int length) const noexcept {
+    return static_cast<std::uint64_t>(std::llround(length * character_time));
+}
+
+void Bus_Statistics::frame(traffic_t &traffic, int length, std::uint64_t start, std::uint64_t end_time) noexcept {
+    ++traffic.frames;
+    traffic.bytes    += static_cast<std::uint64_t>(length);
+    stats->busy_time += end_time - start;
+
+    if (stats->first_frame == 0) {
+        stats->first_frame = start;
+    } else {
+        // a frame that seems to start before the end of the previous frame (wake-up latency): no gap
+        const std::uint64_t gap = start > stats->last_frame ? start - stats->last_frame : 0;
+        ++stats->gaps;
+        stats->gap_sum += gap;
+        stats->gap_min  = stats->gaps == 1 ? gap : std::min(stats->gap_min, gap);
+        stats->gap_max  = std::max(stats->gap_max, gap);
+
+        const auto gap_tenths = static_cast<double>(gap) * 10.0 / character_time;  // NOLINT
+        const auto bucket     = static_cast<std::size_t>(
+                std::find_if(GAP_BOUNDS.begin(),
+                             GAP_BOUNDS.end(),
+                             [gap_tenths](std::uint32_t bound) { return gap_tenths < bound; }) -
+                GAP_BOUNDS.begin());
+        ++stats->gap_histogram[bucket];  // NOLINT
+    }
+    stats->last_frame = std::max(stats->last_frame, end_time);
+
+    // ratios over the complete runtime
+    const auto elapsed = stats->last_frame - stats->first_frame;
+    if (elapsed) {
+        stats->occupancy = static_cast<std::uint32_t>(
+                std::min(PPM, static_cast<double>(stats->busy_time) * PPM / static_cast<double>(elapsed)));
+    }
+    const auto own   = stats->requests.bytes + stats->responses.bytes;
+    const auto total = own + stats->foreign.bytes + stats->errors.bytes;
+    stats->own_share = static_cast<std::uint32_t>(static_cast<double>(own) * PPM / static_cast<double>(total));
+}
+
+void Bus_Statistics::cycle(const Request &request, std::uint64_t timestamp) noexcept {
+    const auto first = stats->cycles.begin();
+    const auto last  = first + stats->cycle_count;
+    const auto entry = std::find_if(first, last, [&request](const cycle_t &c) {
+        return c.slave == request.slave && c.function == request.function && c.address == request.address &&
+               c.quantity == request.quantity;
+    });
+
+    if (entry == last) {
+        if (stats->cycle_count == MAX_CYCLES) {
+            ++stats->untracked;
+            return;
+        }
+        *entry          = cycle_t {};
+        entry->slave    = request.slave;
+        entry->function = request.function;
+        entry->address  = request.address;
+        entry->quantity = request.quantity;
+        entry->last     = timestamp;
+        ++stats->cycle_count;
+        return;
+    }
+
+    // running mean and variance of the period (welford)
+    const auto index  = static_cast<std::size_t>(entry - first);
+    const auto period = timestamp - entry->last;
+    auto      &mean   = cycle_mean[index];  // NOLINT
+    auto      &m2     = cycle_m2[index];    // NOLINT
+
+    ++entry->periods;
+    const auto delta  = static_cast<double>(period) - mean;
+    mean             += delta / static_cast<double>(entry->periods);
+    m2               += delta * (static_cast<double>(period) - mean);
+
+    entry->last   = timestamp;
+    entry->mean   = static_cast<std::uint64_t>(std::llround(mean));
+    entry->min    = entry->periods == 1 ? period : std::min(entry->min, period);
+    entry->max    = std::max(entry->max, period);
+    entry->jitter = static_cast<std::uint64_t>(std::llround(std::sqrt(m2 / static_cast<double>(entry->periods))));
+}
+
+void Bus_Statistics::request(const Request &request, std::uint64_t timestamp) noexcept {
+    const int length = request.get_adu_length();
+
+    begin();
+    frame(stats->requests, length, timestamp - std::min(timestamp, duration(length)), timestamp);
+    cycle(request, timestamp);
+    end();
+}
+
+void Bus_Statistics::foreign(int length, std::uint64_t timestamp) noexcept {
+    begin();
+    frame(stats->foreign, length, timestamp - std::min(timestamp, duration(length)), timestamp);
+    end();
+}
+
+void Bus_Statistics::error(int length, std::uint64_t timestamp) noexcept {
+    begin();
+    frame(stats->errors, length, timestamp - std::min(timestamp, duration(length)), timestamp);
+    end();
+}
+
+void Bus_Statistics::response(int length, std::uint64_t timestamp) noexcept {
+    if (length <= 0) return;
+
+    begin();
+    frame(stats->responses, length, timestamp, timestamp + duration(length));
+    end();
+}
+
+}  // namespace Modbus::shm
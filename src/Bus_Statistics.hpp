@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Modbus_Request.hpp"
+#include "cxxshm.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <sys/types.h>
+
+namespace Modbus::shm {
+
+/*! \brief bus utilization and polling cycle statistics in shared memory
+ *
+ * The statistics are calculated from the receive timestamps of all frames on the bus (requests to this client,
+ * frames to other slaves and frames with checksum errors) and the responses of this client.
+ * The duration of a frame is calculated from its length and the serial configuration (character time); a received
+ * frame ends with its last byte. All values are estimates (wake-up latency of the client).
+ *
+ * The polling cycle of the master is tracked per request (function code, address, quantity) that is addressed to
+ * this client: period = time between two identical requests, jitter = standard deviation of the period.
+ *
+ * The statistics are published with a sequence lock (odd while an update is in progress).
+ */
+class Bus_Statistics final {
+public:
+    static constexpr std::uint32_t MAGIC       = 0x53424D4D;  //!< "MMBS"
+    static constexpr std::uint32_t VERSION     = 1;           //!< statistics version
+    static constexpr std::size_t   MAX_CYCLES  = 32;          //!< maximum number of tracked requests
+    static constexpr std::size_t   GAP_BUCKETS = 8;           //!< number of buckets of the inter-frame gap histogram
+
+    //! upper bounds of the gap histogram buckets in 1/10 character times (last bucket: larger gaps)
+    static constexpr std::array<std::uint32_t, GAP_BUCKETS - 1> GAP_BOUNDS {35, 50, 100, 200, 500, 1000, 10000};
+
+    //! frame counters
+    struct traffic_t {
+        std::uint64_t frames;  //!< number of frames
+        std::uint64_t bytes;   //!< number of bytes
+    };
+
+    //! polling cycle of one request
+    struct cycle_t {
+        std::uint8_t  slave;     //!< slave id (0: broadcast)
+        std::uint8_t  function;  //!< function code
+        std::uint16_t address;   //!< first address
+        std::uint16_t quantity;  //!< number of registers
+        std::uint16_t reserved;
+        std::uint64_t periods;  //!< number of measured periods
+        std::uint64_t last;     //!< time of the last request
+        std::uint64_t mean;     //!< mean period
+        std::uint64_t min;      //!< minimum period
+        std::uint64_t max;      //!< maximum period
+        std::uint64_t jitter;   //!< standard deviation of the period
+    };
+
+    //! statistics shared memory (times: CLOCK_MONOTONIC or durations in nanoseconds)
+    struct stats_t {
+        std::uint32_t magic;           //!< MAGIC
+        std::uint32_t version;         //!< VERSION
+        std::uint32_t sequence;        //!< sequence lock (odd while an update is in progress)
+        std::uint32_t reserved;
+        std::uint64_t character_time;  //!< time to transmit one character
+
+        std::uint64_t first_frame;  //!< start of the first frame (0: no frame yet)
+        std::uint64_t last_frame;   //!< end of the last frame
+        std::uint64_t busy_time;    //!< sum of the durations of all frames
+        std::uint32_t occupancy;    //!< busy time / (last frame - first frame) in parts per million
+        std::uint32_t own_share;    //!< bytes of this client (requests and responses) / all bytes in ppm
+
+        traffic_t requests;   //!< requests to this client (including broadcasts)
+        traffic_t responses;  //!< responses of this client
+        traffic_t foreign;    //!< frames to other slaves
+        traffic_t errors;     //!< frames with checksum errors
+
+        std::uint64_t                          gaps;           //!< number of inter-frame gaps
+        std::uint64_t                          gap_min;        //!< minimum gap
+        std::uint64_t                          gap_max;        //!< maximum gap
+        std::uint64_t                          gap_sum;        //!< sum of all gaps
+        std::array<std::uint64_t, GAP_BUCKETS> gap_histogram;  //!< gaps per bucket (see GAP_BOUNDS)
+
+        std::uint32_t                   cycle_count;  //!< number of used entries of cycles
+        std::uint32_t                   reserved2;
+        std::uint64_t                   untracked;  //!< requests that do not fit in cycles
+        std::array<cycle_t, MAX_CYCLES> cycles;     //!< polling cycles per request
+    };
+
+private:
+    std::unique_ptr<cxxshm::SharedMemory> shm;
+
+    stats_t *stats;  //!< statistics in shared memory
+
+    const double character_time;  //!< time to transmit one character in nanoseconds
+
+    std::array<double, MAX_CYCLES> cycle_mean {};  //!< exact mean period per cycle
+    std::array<double, MAX_CYCLES> cycle_m2 {};    //!< sum of squared deviations of the period per cycle
+
+    //* start an update (sequence lock)
+    void begin() noexcept;
+
+    //* finish an update (sequence lock)
+    void end() noexcept;
+
+    //* account a frame on the bus (within an update)
+    void frame(traffic_t &traffic, int length, std::uint64_t start, std::uint64_t end_time) noexcept;
+
+    //* account the period of a request (within an update)
+    void cycle(const Request &request, std::uint64_t timestamp) noexcept;
+
+    //* duration of a frame in nanoseconds
+    [[nodiscard]] std::uint64_t duration(int length) const noexcept;
+
+public:
+    /*! \brief create the statistics shared memory
+     *
+     * @param name name of the shared memory object
+     * @param baud serial baud rate
+     * @param data_bits serial data bits
+     * @param parity serial parity ('N', 'E' or 'O')
+     * @param stop_bits serial stop bits
+     * @param force do not fail if the shared memory exist, but use the existing shared memory
+     * @param permissions shared memory file permissions
+     * @exception std::system_error failed to create the shared memory
+     */
+    Bus_Statistics(const std::string &name,
+                   int                baud,
+                   int                data_bits,
+                   char               parity,
+                   int                stop_bits,
+                   bool               force,
+                   mode_t             permissions);
+
+    /*! \brief account a request that is addressed to this client
+     *
+     * @param request received request
+     * @param timestamp time the request was received
+     */
+    void request(const Request &request, std::uint64_t timestamp) noexcept;
+
+    /*! \brief account a frame that is addressed to another slave
+     *
+     * @param length length of the received frame
+     * @param timestamp time the frame was received
+     */
+    void foreign(int length, std::uint64_t timestamp) noexcept;
+
+    /*! \brief account a frame with checksum error (or an incomplete frame)
+     *
+     * @param length length of the received frame
+     * @param timestamp time the frame was received
+     */
+    void error(int length, std::uint64_t timestamp) noexcept;
+
+    /*! \brief account a response of this client
+     *
+     * @param length length of the sent frame (ignored if not positive)
+     * @param timestamp time the transmission was started
+     */
+    void response(int length, std::uint64_t timestamp) noexcept;
+};
+
+}  // namespace Modbus::shm
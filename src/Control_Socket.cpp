@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Control_Socket.hpp"
+
+#include "Print_Time.hpp"
+#include "unix_socket.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <utility>
+
+namespace Modbus {
+
+//* maximum length of a command line
+static constexpr std::size_t MAX_LINE_LENGTH = 4096;
+
+//* maximum number of simultaneous connections
+static constexpr std::size_t MAX_CONNECTIONS = 16;
+
+Control_Socket::Control_Socket(std::string path, mode_t permissions, Event_Loop &event_loop)
+    : path(std::move(path)), event_loop(event_loop) {
+    listen_fd = create_unix_listener(this->path, SOCK_STREAM, permissions);
+    event_loop.add(listen_fd, [this] { accept_connections(); });
+
+    add_command("help", "list all commands", [this](const std::string &) {
+        std::string result;
+        for (const auto &[name, command] : commands)
+            result += (result.empty() ? "" : "; ") + name + ": " + command.help;
+        return result;
+    });
+}
+
+Control_Socket::~Control_Socket() {
+    for (const auto &[fd, input] : connections) {
+        event_loop.remove(fd);
+        close(fd);
+    }
+    event_loop.remove(listen_fd);
+    close(listen_fd);
+    unlink(path.c_str());
+}
+
+void Control_Socket::add_command(const std::string &name, const std::string &help, handler_t handler) {
+    commands[name] = {std::move(handler), help};
+}
+
+void Control_Socket::accept_connections() {
+    for (;;) {
+        const int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd == -1) {
+            if (errno != EAGAIN && errno != EINTR)
+                std::cerr << Print_Time::iso << " WARNING: control socket: accept failed: " << strerror(errno) << '\n';
+            return;
+        }
+
+        if (connections.size() >= MAX_CONNECTIONS) {
+            close(fd);
+            continue;
+        }
+
+        connections[fd] = std::string();
+        event_loop.add(fd, [this, fd] { handle_connection(fd); });
+    }
+}
+
+void Control_Socket::handle_connection(int fd) {
+    auto &input = connections[fd];
+
+    std::array<char, 512> buffer {};
+    for (;;) {
+        const ssize_t received = recv(fd, buffer.data(), buffer.size(), 0);
+        if (received == 0) break;
+        if (received == -1) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN) return;
+            break;
+        }
+        input.append(buffer.data(), static_cast<std::size_t>(received));
+
+        // execute all complete lines
+        std::size_t newline = 0;
+        while ((newline = input.find('\n')) != std::string::npos) {
+            std::string line = input.substr(0, newline);
+            input.erase(0, newline + 1);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty()) continue;
+
+            // the response is short: a full socket buffer indicates a peer that does not read
+            const std::string response = execute(line) + '\n';
+            if (send(fd, response.data(), response.size(), MSG_DONTWAIT | MSG_NOSIGNAL) == -1) {
+                close_connection(fd);
+                return;
+            }
+        }
+
+        if (input.size() > MAX_LINE_LENGTH) break;
+    }
+
+    close_connection(fd);
+}
+
+void Control_Socket::close_connection(int fd) {
+    event_loop.remove(fd);
+    close(fd);
+    connections.erase(fd);
+}
+
+std::string Control_Socket::execute(const std::string &line) {
+    const auto        separator = line.find(' ');
+    const std::string name      = line.substr(0, separator);
+    const std::string arguments = separator == std::string::npos ? "" : line.substr(separator + 1);
+
+    const auto command = commands.find(name);
+    if (command == commands.end()) return "ERROR unknown command '" + name + "'";
+
+    try {
+        const auto result = command->second.handler(arguments);
+        return result.empty() ? "OK" : "OK " + result;
+    } catch (const std::exception &e) { return std::string("ERROR ") + e.what(); }
+}
+
+}  // namespace Modbus
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Event_Loop.hpp"
+
+#include <functional>
+#include <map>
+#include <string>
+#include <sys/types.h>
+
+namespace Modbus {
+
+/*! \brief unix domain socket (stream) that accepts text commands
+ *
+ * Each line that is received is one command: <command> [<arguments>]
+ * Each command is answered with one line that starts with "OK" or "ERROR".
+ * Commands are executed in the thread of the event loop (between two modbus requests).
+ *
+ * Example: echo snapshot | socat - UNIX-CONNECT:/run/modbus.ctl
+ */
+class Control_Socket final {
+public:
+    /*! \brief command handler
+     *
+     * @param arguments arguments of the command (the rest of the line)
+     * @return result (without "OK")
+     * @exception std::exception command failed (the message is sent as error)
+     */
+    using handler_t = std::function<std::string(const std::string &arguments)>;
+
+private:
+    //! command
+    struct command_t {
+        handler_t   handler;
+        std::string help;  //!< description of the command
+    };
+
+    std::string                      path;         //!< path of the socket
+    int                              listen_fd;    //!< listening socket
+    Event_Loop                      &event_loop;   //!< event loop that serves the connections
+    std::map<std::string, command_t> commands;     //!< available commands
+    std::map<int, std::string>       connections;  //!< open connections with incomplete input
+
+    //* accept pending connections
+    void accept_connections();
+
+    //* read and execute commands of a connection
+    void handle_connection(int fd);
+
+    //* close a connection
+    void close_connection(int fd);
+
+    //* execute a command line
+    std::string execute(const std::string &line);
+
+public:
+    /*! \brief create the socket and add it to the event loop
+     *
+     * @param path path of the socket
+     * @param permissions file permissions of the socket
+     * @param event_loop event loop that serves the connections
+     * @exception std::system_error failed to create the socket
+     */
+    Control_Socket(std::string path, mode_t permissions, Event_Loop &event_loop);
+
+    ~Control_Socket();
+
+    Control_Socket(const Control_Socket &other)            = delete;
+    Control_Socket(Control_Socket &&other)                 = delete;
+    Control_Socket &operator=(const Control_Socket &other) = delete;
+    Control_Socket &operator=(Control_Socket &&other)      = delete;
+
+    /*! \brief add a command
+     *
+     * @param name name of the command
+     * @param help description of the command (output of the command "help")
+     * @param handler command handler
+     */
+    void add_command(const std::string &name, const std::string &help, handler_t handler);
+};
+
+}  // namespace Modbus
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Device_Identification.hpp"
+
+#include <cerrno>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+
+namespace Modbus {
+
+//* names of the standard objects (index: object id)
+static constexpr std::array<std::string_view, 7> OBJECT_NAMES {"VendorName",
+                                                               "ProductCode",
+                                                               "MajorMinorRevision",
+                                                               "VendorUrl",
+                                                               "ProductName",
+                                                               "ModelName",
+                                                               "UserApplicationName"};
+
+//* first object id of the private (extended) objects
+static constexpr std::size_t FIRST_PRIVATE_OBJECT = 0x80;
+
+//* last object id per stream access category (basic, regular, extended)
+static constexpr std::array<std::size_t, 3> LAST_OBJECT {0x02, 0x7F, 0xFF};
+
+//* read device id code of the individual access
+static constexpr std::uint8_t INDIVIDUAL_ACCESS = 4;
+
+//* conformity level flag: individual access is supported
+static constexpr std::uint8_t CONFORMITY_INDIVIDUAL = 0x80;
+
+//* length of the response header (function code, mei type, code, conformity, more follows, next id, count)
+static constexpr std::size_t RESPONSE_HEADER_LENGTH = 7;
+
+//* length of an object header (id, length)
+static constexpr std::size_t OBJECT_HEADER_LENGTH = 2;
+
+//* maximum length of an object value (one object must fit in a response)
+static constexpr std::size_t MAX_VALUE_LENGTH =
+        MODBUS_MAX_PDU_LENGTH - RESPONSE_HEADER_LENGTH - OBJECT_HEADER_LENGTH;
+
+//* more follows value if the objects do not fit in one response
+static constexpr std::uint8_t MORE_FOLLOWS = 0xFF;
+
+//* remove leading and trailing whitespace
+static std::string_view trim(std::string_view str) {
+    static constexpr std::string_view WHITESPACE = " \t\r";
+    const auto                        first      = str.find_first_not_of(WHITESPACE);
+    if (first == std::string_view::npos) return {};
+    return str.substr(first, str.find_last_not_of(WHITESPACE) - first + 1);
+}
+
+//* get the object id of an object name or number
+static std::size_t parse_object_id(std::string_view object) {
+    for (std::size_t id = 0; id < OBJECT_NAMES.size(); ++id)
+        if (object == OBJECT_NAMES[id]) return id;  // NOLINT
+
+    std::size_t id = 0;
+    try {
+        std::size_t idx = 0;
+        id              = std::stoul(std::string(object), &idx, 0);
+        if (idx != object.size()) throw std::invalid_argument("");
+    } catch (const std::logic_error &) { throw std::runtime_error("unknown object '" + std::string(object) + "'"); }
+
+    if (id >= OBJECT_NAMES.size() && (id < FIRST_PRIVATE_OBJECT || id > LAST_OBJECT.back()))
+        throw std::runtime_error("reserved object id '" + std::string(object) + "'");
+    return id;
+}
+
+//* encode an exception response
+static std::vector<std::uint8_t> exception_response(std::uint8_t exception_code) {
+    return {static_cast<std::uint8_t>(Device_Identification::FUNCTION_CODE | 0x80U), exception_code};  // NOLINT
+}
+
+Device_Identification::Device_Identification(const std::string &path) {
+    std::ifstream file(path);
+    if (!file) throw std::system_error(errno, std::generic_category(), "failed to open '" + path + "'");
+
+    std::map<std::size_t, std::string> objects;
+    std::string                        line;
+    for (std::size_t line_nr = 1; std::getline(file, line); ++line_nr) {
+        const auto content = trim(line);
+        if (content.empty() || content.front() == '#') continue;
+
+        const auto where = "invalid device identification '" + path + "' (line " + std::to_string(line_nr) + "): ";
+        try {
+            const auto separator = content.find('=');
+            if (separator == std::string_view::npos) throw std::runtime_error("expected <object>=<value>");
+
+            const auto id    = parse_object_id(trim(content.substr(0, separator)));
+            const auto value = trim(content.substr(separator + 1));
+            if (value.size() > MAX_VALUE_LENGTH)
+                throw std::runtime_error("value exceeds " + std::to_string(MAX_VALUE_LENGTH) + " bytes");
+            if (!objects.emplace(id, value).second) throw std::runtime_error("duplicate object");
+        } catch (const std::runtime_error &e) { throw std::runtime_error(where + e.what()); }
+    }
+    if (file.bad()) throw std::system_error(errno, std::generic_category(), "failed to read '" + path + "'");
+
+    for (std::size_t id = 0; id <= LAST_OBJECT.front(); ++id) {
+        if (!objects.contains(id))
+            throw std::runtime_error("invalid device identification '" + path + "': missing object " +
+                                     std::string(OBJECT_NAMES[id]));  // NOLINT
+    }
+
+    // the conformity level is the highest category that contains an object
+    const auto    last_id    = objects.rbegin()->first;
+    std::uint8_t  conformity = last_id <= LAST_OBJECT[0] ? 1 : (last_id <= LAST_OBJECT[1] ? 2 : 3);
+    conformity              |= CONFORMITY_INDIVIDUAL;
+
+    const auto add_response = [this](std::vector<std::uint8_t> response) {
+        responses.emplace_back(std::move(response));
+        return static_cast<std::uint16_t>(responses.size() - 1);
+    };
+
+    const auto append_object = [](std::vector<std::uint8_t> &response, std::size_t id, const std::string &value) {
+        response.push_back(static_cast<std::uint8_t>(id));
+        response.push_back(static_cast<std::uint8_t>(value.size()));
+        response.insert(response.end(), value.begin(), value.end());
+    };
+
+    illegal_value_index         = add_response(exception_response(MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE));
+    const auto illegal_id_index = add_response(exception_response(MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS));
+
+    // stream access: one response per category and existing first object
+    for (std::size_t category = 0; category < LAST_OBJECT.size(); ++category) {
+        const auto code = static_cast<std::uint8_t>(category + 1);
+        auto      &index = response_index[category];  // NOLINT
+
+        for (auto first = objects.begin(); first != objects.end() && first->first <= LAST_OBJECT[category]; ++first) {
+            std::vector<std::uint8_t> response {FUNCTION_CODE, MEI_TYPE, code, conformity, 0, 0, 0};
+            for (auto object = first; object != objects.end() && object->first <= LAST_OBJECT[category]; ++object) {
+                if (response.size() + OBJECT_HEADER_LENGTH + object->second.size() > MODBUS_MAX_PDU_LENGTH) {
+                    response[4] = MORE_FOLLOWS;
+                    response[5] = static_cast<std::uint8_t>(object->first);
+                    break;
+                }
+                append_object(response, object->first, object->second);
+                ++response[6];
+            }
+            index[first->first] = add_response(std::move(response));  // NOLINT
+        }
+
+        // unknown first objects: the stream starts with the first object
+        for (std::size_t id = 0; id < OBJECT_IDS; ++id) {
+            if (id > LAST_OBJECT[category] || !objects.contains(id)) index[id] = index[0];  // NOLINT
+        }
+    }
+
+    // individual access
+    auto &individual = response_index[INDIVIDUAL_ACCESS - 1];
+    individual.fill(illegal_id_index);
+    for (const auto &[id, value] : objects) {
+        std::vector<std::uint8_t> response {FUNCTION_CODE, MEI_TYPE, INDIVIDUAL_ACCESS, conformity, 0, 0, 1};
+        append_object(response, id, value);
+        individual[id] = add_response(std::move(response));  // NOLINT
+    }
+}
+
+std::span<const std::uint8_t> Device_Identification::response(const Request &request) const noexcept {
+    static constexpr int REQUEST_LENGTH = 4;
+
+    if (request.function != FUNCTION_CODE) return {};
+    const std::uint8_t *pdu    = request.get_pdu();
+    const int           length = request.get_pdu_length();
+    if (length < 2 || pdu[1] != MEI_TYPE) return {};  // other MEI types are rejected by modbus_reply
+
+    std::uint16_t index = illegal_value_index;
+    if (length == REQUEST_LENGTH && pdu[2] >= 1 && pdu[2] <= READ_CODES)  // NOLINT
+        index = response_index[pdu[2] - 1][pdu[3]];                        // NOLINT
+    return responses[index];
+}
+
+}  // namespace Modbus
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Modbus_Request.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Modbus {
+
+/*! \brief responses to Read Device Identification requests (FC 0x2B, MEI type 0x0E)
+ *
+ * The identification objects are loaded from a file at startup. All possible responses (stream access per
+ * read device id code and first object id, individual access per object id and the exception responses) are
+ * encoded once. A request is answered by looking up the response pdu.
+ *
+ * File format: one object per line: <object>=<value>. Empty lines and lines that start with '#' are ignored.
+ * The object is a name (VendorName, ProductCode, MajorMinorRevision, VendorUrl, ProductName, ModelName,
+ * UserApplicationName) or an object id (0x80 - 0xFF for private objects).
+ * The objects VendorName, ProductCode and MajorMinorRevision are mandatory.
+ */
+class Device_Identification final {
+public:
+    static constexpr std::uint8_t FUNCTION_CODE = 0x2B;  //!< encapsulated interface transport
+    static constexpr std::uint8_t MEI_TYPE      = 0x0E;  //!< read device identification
+
+private:
+    static constexpr std::size_t READ_CODES = 4;    //!< basic, regular, extended and individual access
+    static constexpr std::size_t OBJECT_IDS = 256;  //!< number of possible object ids
+
+    std::vector<std::vector<std::uint8_t>> responses;  //!< encoded response pdus
+
+    //! index of the response pdu per read device id code (1 - 4) and object id
+    std::array<std::array<std::uint16_t, OBJECT_IDS>, READ_CODES> response_index {};
+
+    std::uint16_t illegal_value_index = 0;  //!< index of the exception response to invalid requests
+
+public:
+    /*! \brief load the identification objects and encode the responses
+     *
+     * @param path path of the identification file
+     * @exception std::system_error failed to read the file
+     * @exception std::runtime_error invalid identification file
+     */
+    explicit Device_Identification(const std::string &path);
+
+    /*! \brief get the response to a request
+     *
+     * @param request received request
+     * @return response pdu (starting with the function code) or an empty span if the request is no Read Device
+     *         Identification request
+     */
+    [[nodiscard]] std::span<const std::uint8_t> response(const Request &request) const noexcept;
+};
+
+}  // namespace Modbus
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Diagnostics.hpp"
+
+#include <cstring>
+
+namespace Modbus {
+
+//* diagnostics sub-functions
+enum sub_function_t : std::uint16_t {
+    RETURN_QUERY_DATA              = 0x00,
+    RESTART_COMMUNICATIONS         = 0x01,
+    RETURN_DIAGNOSTIC_REGISTER     = 0x02,
+    FORCE_LISTEN_ONLY              = 0x04,
+    CLEAR_COUNTERS                 = 0x0A,
+    BUS_MESSAGE_COUNT              = 0x0B,
+    BUS_COMMUNICATION_ERROR_COUNT  = 0x0C,
+    BUS_EXCEPTION_ERROR_COUNT      = 0x0D,
+    SERVER_MESSAGE_COUNT           = 0x0E,
+    SERVER_NO_RESPONSE_COUNT       = 0x0F,
+    SERVER_NAK_COUNT               = 0x10,
+    SERVER_BUSY_COUNT              = 0x11,
+    BUS_CHARACTER_OVERRUN_COUNT    = 0x12,
+    CLEAR_OVERRUN_COUNTER_AND_FLAG = 0x14,
+};
+
+//* length of a diagnostics pdu with one data word (function code, sub-function, data)
+static constexpr int PDU_LENGTH = 5;
+
+//* data of Restart Communications Option that clears the communication event log
+static constexpr std::uint16_t CLEAR_LOG = 0xFF00;
+
+static inline std::uint16_t get_u16(const uint8_t *data) {
+    return static_cast<std::uint16_t>((data[0] << 8) | data[1]);  // NOLINT
+}
+
+//* check if a request restarts the communications (the only request that is executed in listen only mode)
+static bool is_restart(const Request &request) noexcept {
+    return request.function == Diagnostics::FUNCTION_CODE && request.get_pdu_length() >= PDU_LENGTH &&
+           get_u16(request.get_pdu() + 1) == RESTART_COMMUNICATIONS;
+}
+
+//* create an exception response
+static int exception(std::uint8_t *response, int exception_code) noexcept {
+    response[0] = Diagnostics::FUNCTION_CODE | 0x80U;  // NOLINT
+    response[1] = static_cast<std::uint8_t>(exception_code);
+    return 2;
+}
+
+void Diagnostics::clear() noexcept {
+    bus_messages        = 0;
+    bus_errors          = 0;
+    exceptions          = 0;
+    server_messages     = 0;
+    server_no_responses = 0;
+}
+
+bool Diagnostics::receive(const Request &request) noexcept {
+    ++bus_messages;
+    ++server_messages;
+
+    const bool ignore = listen_only && !is_restart(request);
+    if (ignore || request.is_broadcast()) ++server_no_responses;
+    return !ignore;
+}
+
+int Diagnostics::reply(const Request &request, std::uint8_t *response) noexcept {
+    if (request.function != FUNCTION_CODE) return -1;
+
+    const std::uint8_t *pdu    = request.get_pdu();
+    const int           length = request.get_pdu_length();
+    if (length < PDU_LENGTH) return exception(response, MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+
+    const auto sub_function = get_u16(pdu + 1);
+    const auto data         = get_u16(pdu + 3);  // NOLINT
+
+    // return query data: echo the request
+    if (sub_function == RETURN_QUERY_DATA) {
+        std::memcpy(response, pdu, static_cast<std::size_t>(length));
+        return length;
+    }
+
+    if (length != PDU_LENGTH) return exception(response, MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+
+    // the response echoes function code and sub-function
+    std::memcpy(response, pdu, PDU_LENGTH);
+    const auto set_data = [response](std::uint16_t value) {
+        response[3] = static_cast<std::uint8_t>(value >> 8);  // NOLINT
+        response[4] = static_cast<std::uint8_t>(value);       // NOLINT
+    };
+
+    switch (sub_function) {
+        case RESTART_COMMUNICATIONS: {
+            if (data != 0 && data != CLEAR_LOG) return exception(response, MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+            const bool was_listen_only = listen_only;
+            listen_only                = false;
+            clear();
+            return was_listen_only ? 0 : PDU_LENGTH;
+        }
+        case FORCE_LISTEN_ONLY:
+            if (data != 0) return exception(response, MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+            listen_only = true;
+            return 0;
+        case CLEAR_COUNTERS:
+            if (data != 0) return exception(response, MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+            clear();
+            return PDU_LENGTH;
+        case CLEAR_OVERRUN_COUNTER_AND_FLAG:
+            if (data != 0) return exception(response, MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+            return PDU_LENGTH;
+        case RETURN_DIAGNOSTIC_REGISTER:
+        case SERVER_NAK_COUNT:
+        case SERVER_BUSY_COUNT:
+        case BUS_CHARACTER_OVERRUN_COUNT: set_data(0); break;
+        case BUS_MESSAGE_COUNT: set_data(bus_messages); break;
+        case BUS_COMMUNICATION_ERROR_COUNT: set_data(bus_errors); break;
+        case BUS_EXCEPTION_ERROR_COUNT: set_data(exceptions); break;
+        case SERVER_MESSAGE_COUNT: set_data(server_messages); break;
+        case SERVER_NO_RESPONSE_COUNT: set_data(server_no_responses); break;
+        default: return exception(response, MODBUS_EXCEPTION_ILLEGAL_FUNCTION);
+    }
+
+    if (data != 0) return exception(response, MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+    return PDU_LENGTH;
+}
+
+}  // namespace Modbus
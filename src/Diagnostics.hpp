@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Modbus_Request.hpp"
+
+#include <cstdint>
+
+namespace Modbus {
+
+/*! \brief bus counters and Diagnostics requests (FC 0x08)
+ *
+ * The counters are updated in the receive path of the client. They are 16 bit values that wrap around
+ * (as defined by the modbus specification).
+ *
+ * Supported sub-functions: Return Query Data, Restart Communications Option, Return Diagnostic Register,
+ * Force Listen Only Mode, Clear Counters and Diagnostic Register, Return Bus Message/Communication Error/Exception
+ * Error/Server Message/Server No Response/Server NAK/Server Busy/Bus Character Overrun Count and
+ * Clear Overrun Counter and Flag.
+ *
+ * In listen only mode, requests are counted but neither executed nor answered. Only Restart Communications Option
+ * leaves the listen only mode (without response).
+ */
+class Diagnostics final {
+public:
+    static constexpr std::uint8_t FUNCTION_CODE = 0x08;  //!< diagnostics
+
+private:
+    std::uint16_t bus_messages        = 0;  //!< frames on the bus (including other slaves and checksum errors)
+    std::uint16_t bus_errors          = 0;  //!< frames with checksum errors
+    std::uint16_t exceptions          = 0;  //!< exception responses sent by this client
+    std::uint16_t server_messages     = 0;  //!< requests addressed to this client (including broadcasts)
+    std::uint16_t server_no_responses = 0;  //!< requests addressed to this client that were not answered
+
+    bool listen_only = false;  //!< listen only mode is active
+
+    //* reset all counters
+    void clear() noexcept;
+
+public:
+    //! count a frame that is addressed to another slave
+    void count_bus_message() noexcept { ++bus_messages; }
+
+    //! count a frame with checksum error
+    void count_bus_error() noexcept {
+        ++bus_messages;
+        ++bus_errors;
+    }
+
+    //! count an exception response
+    void count_exception() noexcept { ++exceptions; }
+
+    /*! \brief count a request that is addressed to this client
+     *
+     * @param request received request
+     * @return false if the request must be ignored (listen only mode)
+     */
+    bool receive(const Request &request) noexcept;
+
+    /*! \brief handle a Diagnostics request
+     *
+     * @param request received request
+     * @param response output: response pdu (at least MODBUS_MAX_PDU_LENGTH bytes)
+     * @return length of the response pdu, 0 if no response is sent or -1 if the request is no Diagnostics request
+     */
+    int reply(const Request &request, std::uint8_t *response) noexcept;
+};
+
+}  // namespace Modbus
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Event_Loop.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+
+namespace Modbus {
+
+void Event_Loop::add(int fd, std::function<void()> handler) {
+    // the handler that is currently called must not be moved
+    if (dispatching) added.push_back({fd, std::move(handler)});
+    else {
+        sources.push_back({fd, std::move(handler)});
+        poll_fds.push_back({fd, POLLIN, 0});
+    }
+}
+
+void Event_Loop::remove(int fd) noexcept {
+    for (auto &source : sources)
+        if (source.fd == fd) source.fd = -1;
+    for (auto &poll_fd : poll_fds)
+        if (poll_fd.fd == fd) poll_fd.fd = -1;  // ignored by poll
+    std::erase_if(added, [fd](const source_t &source) { return source.fd == fd; });
+}
+
+void Event_Loop::run_once(int timeout) {
+    const int rc = poll(poll_fds.data(), poll_fds.size(), timeout);
+    if (rc == -1) {
+        if (errno == EINTR) return;
+        throw std::system_error(errno, std::generic_category(), "poll failed");
+    }
+
+    dispatching = true;
+    try {
+        for (std::size_t i = 0; i < sources.size(); ++i) {
+            if (sources[i].fd != -1 && poll_fds[i].revents) sources[i].handler();
+        }
+    } catch (...) {
+        dispatching = false;
+        throw;
+    }
+    dispatching = false;
+
+    // apply changes of the handlers
+    for (std::size_t i = sources.size(); i-- > 0;) {
+        if (sources[i].fd == -1) {
+            sources.erase(sources.begin() + static_cast<std::ptrdiff_t>(i));
+            poll_fds.erase(poll_fds.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+    }
+    for (auto &source : added)
+        add(source.fd, std::move(source.handler));
+    added.clear();
+}
+
+}  // namespace Modbus
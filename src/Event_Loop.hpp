@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <poll.h>
+#include <vector>
+
+namespace Modbus {
+
+/*! \brief poll based event loop of the main thread
+ *
+ * Waits for multiple file descriptors (modbus connection, sockets, timers, ...) and calls the handler of each
+ * readable file descriptor. All handlers are called in the thread that calls run_once().
+ * Handlers can add and remove file descriptors.
+ */
+class Event_Loop final {
+private:
+    //! registered file descriptor
+    struct source_t {
+        int                   fd;       //!< file descriptor (-1: removed)
+        std::function<void()> handler;  //!< function that is called if the file descriptor is ready
+    };
+
+    std::vector<source_t> sources;   //!< registered file descriptors
+    std::vector<source_t> added;     //!< file descriptors added by handlers (registered after the dispatch)
+    std::vector<pollfd>   poll_fds;  //!< poll array (same index as sources)
+    bool                  dispatching = false;
+
+public:
+    /*! \brief add a file descriptor
+     *
+     * @param fd file descriptor
+     * @param handler function that is called if the file descriptor is readable (or an error occurred)
+     */
+    void add(int fd, std::function<void()> handler);
+
+    /*! \brief remove a file descriptor
+     *
+     * The file descriptor must be removed before it is closed.
+     *
+     * @param fd file descriptor
+     */
+    void remove(int fd) noexcept;
+
+    /*! \brief wait for events and call the handlers of all ready file descriptors
+     *
+     * Returns without calling handlers if the wait is interrupted by a signal.
+     *
+     * @param timeout timeout in milliseconds (-1: wait forever)
+     * @exception std::system_error poll failed
+     */
+    void run_once(int timeout = -1);
+};
+
+}  // namespace Modbus
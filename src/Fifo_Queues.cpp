@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Fifo_Queues.hpp"
+
+#include "modbus_rtu_client_shm/consumer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <endian.h>
+#include <stdexcept>
+#include <utility>
+
+namespace Modbus::shm {
+
+// the consumer library accesses the fifo with its own definition
+using consumer_fifo_t = consumer::Fifo_Producer::fifo_t;
+static_assert(consumer::Fifo_Producer::FIFO_MAGIC == Fifo_Queues::MAGIC);
+static_assert(consumer::Fifo_Producer::FIFO_VERSION == Fifo_Queues::VERSION);
+static_assert(sizeof(consumer_fifo_t) == sizeof(Fifo_Queues::fifo_t));
+static_assert(offsetof(consumer_fifo_t, capacity) == offsetof(Fifo_Queues::fifo_t, capacity));
+static_assert(offsetof(consumer_fifo_t, head) == offsetof(Fifo_Queues::fifo_t, head));
+static_assert(offsetof(consumer_fifo_t, tail) == offsetof(Fifo_Queues::fifo_t, tail));
+
+//* default number of registers of a queue
+static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+//* maximum number of registers of a queue
+static constexpr std::size_t MAX_CAPACITY = 0x10000;
+
+//* length of a read fifo queue request pdu (function code, fifo pointer address)
+static constexpr int REQUEST_LENGTH = 3;
+
+//* length of the response header (function code, byte count, fifo count)
+static constexpr std::size_t RESPONSE_HEADER_LENGTH = 5;
+
+//* create an exception response
+static int exception(std::uint8_t *response, int exception_code) noexcept {
+    response[0] = Fifo_Queues::FUNCTION_CODE | 0x80U;  // NOLINT
+    response[1] = static_cast<std::uint8_t>(exception_code);
+    return 2;
+}
+
+Fifo_Queues::Fifo_Queues(std::string shm_prefix, bool force, mode_t permissions, bool wire_order)
+    : shm_prefix(std::move(shm_prefix)), force(force), permissions(permissions), wire_order(wire_order) {}
+
+void Fifo_Queues::add(const std::string &definition) {
+    const auto separator = definition.find(':');
+
+    std::size_t address  = 0;
+    std::size_t capacity = DEFAULT_CAPACITY;
+    try {
+        const auto  address_str = definition.substr(0, separator);
+        std::size_t idx         = 0;
+        address                 = std::stoul(address_str, &idx, 0);
+        if (idx != address_str.size()) throw std::invalid_argument("trailing characters");
+
+        if (separator != std::string::npos) {
+            const auto capacity_str = definition.substr(separator + 1);
+            capacity                = std::stoul(capacity_str, &idx, 0);
+            if (idx != capacity_str.size()) throw std::invalid_argument("trailing characters");
+        }
+    } catch (const std::logic_error &) {
+        throw std::invalid_argument("invalid fifo queue '" + definition +
+                                    "' (expected <fifo pointer address>[:<capacity>])");
+    }
+
+    if (address > UINT16_MAX)
+        throw std::invalid_argument("invalid fifo queue '" + definition + "': address out of range");
+    if (capacity < 2 || capacity > MAX_CAPACITY || !std::has_single_bit(capacity))
+        throw std::invalid_argument("invalid fifo queue '" + definition +
+                                    "': capacity must be a power of 2 (2 - 65536)");
+    for (const auto &other : queues) {
+        if (other.address == address)
+            throw std::invalid_argument("invalid fifo queue '" + definition + "': address already used");
+    }
+
+    queue_t queue;
+    queue.address  = static_cast<std::uint16_t>(address);
+    queue.capacity = static_cast<std::uint32_t>(capacity);
+    queue.shm     = std::make_unique<cxxshm::SharedMemory>(shm_prefix + "fifo_" + std::to_string(address),
+                                                       sizeof(fifo_t) + capacity * sizeof(std::uint16_t),
+                                                       false,
+                                                       !force,
+                                                       permissions);
+
+    queue.fifo = static_cast<fifo_t *>(queue.shm->get_addr());
+    queue.data = reinterpret_cast<std::uint16_t *>(queue.fifo + 1);  // NOLINT
+    std::memset(queue.fifo, 0, sizeof(fifo_t));
+    queue.fifo->version  = VERSION;
+    queue.fifo->capacity = queue.capacity;
+    std::atomic_ref(queue.fifo->magic).store(MAGIC, std::memory_order_release);
+
+    queues.emplace_back(std::move(queue));
+}
+
+int Fifo_Queues::reply(const Request &request, std::uint8_t *response) noexcept {
+    if (request.function != FUNCTION_CODE) return -1;
+
+    const std::uint8_t *pdu = request.get_pdu();
+    if (request.get_pdu_length() != REQUEST_LENGTH) return exception(response, MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+
+    const auto address = static_cast<std::uint16_t>((pdu[1] << 8) | pdu[2]);  // NOLINT
+    const auto queue   = std::find_if(queues.begin(), queues.end(), [address](const queue_t &q) {
+        return q.address == address;
+    });
+    if (queue == queues.end()) return exception(response, MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS);
+
+    // a broadcast is not answered: keep the registers for the next request
+    if (request.is_broadcast()) return 0;
+
+    // the header can be written by the producer: only the capacity of the definition is used
+    fifo_t    &fifo  = *queue->fifo;
+    const auto mask  = queue->capacity - 1;
+    const auto tail  = std::atomic_ref(fifo.tail).load(std::memory_order_relaxed);
+    const auto head  = std::atomic_ref(fifo.head).load(std::memory_order_acquire);
+    const auto count = std::min({head - tail, queue->capacity, static_cast<std::uint32_t>(MAX_COUNT)});
+
+    const auto byte_count = 2 + count * sizeof(std::uint16_t);
+    response[0]           = FUNCTION_CODE;
+    response[1]           = static_cast<std::uint8_t>(byte_count >> 8);  // NOLINT
+    response[2]           = static_cast<std::uint8_t>(byte_count);
+    response[3]           = 0;
+    response[4]           = static_cast<std::uint8_t>(count);  // NOLINT
+
+    std::uint8_t *out = response + RESPONSE_HEADER_LENGTH;  // NOLINT
+    for (std::uint32_t i = 0; i < count; ++i) {
+        const std::uint16_t value = queue->data[(tail + i) & mask];  // NOLINT
+        const std::uint16_t wire  = wire_order ? value : htobe16(value);
+        std::memcpy(out + i * sizeof(std::uint16_t), &wire, sizeof(wire));  // NOLINT
+    }
+
+    // the registers are read: the producer can overwrite them (at most once delivery)
+    std::atomic_ref(fifo.tail).store(tail + count, std::memory_order_release);
+
+    return static_cast<int>(RESPONSE_HEADER_LENGTH + count * sizeof(std::uint16_t));
+}
+
+}  // namespace Modbus::shm
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Modbus_Request.hpp"
+#include "cxxshm.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace Modbus::shm {
+
+/*! \brief Read FIFO Queue requests (FC 0x18) served from single producer single consumer rings in shared memory
+ *
+ * Each queue is identified by its FIFO pointer address and has a shared memory object <prefix>fifo_<address>.
+ * One producer pushes registers to the ring (head index), the client is the only consumer (tail index).
+ * No lock is used: the indices are published with release/acquire ordering.
+ *
+ * Each request drains up to 31 registers (the maximum of one response) and advances the tail index afterward.
+ * If the queue contains more registers, the remaining registers are returned by the next requests.
+ * The delivery is at most once: Modbus can not distinguish a repeated request (lost response) from the next poll,
+ * registers of a lost response are not repeated.
+ * The ring size is taken from the queue definition, never from the shared memory (written by the producer).
+ * The registers are stored in the byte order of the register tables (host byte order or modbus byte order).
+ */
+class Fifo_Queues final {
+public:
+    static constexpr std::uint8_t  FUNCTION_CODE = 0x18;        //!< read fifo queue
+    static constexpr std::uint32_t MAGIC         = 0x51464D4D;  //!< "MMFQ"
+    static constexpr std::uint32_t VERSION       = 1;           //!< fifo version
+    static constexpr std::size_t   MAX_COUNT     = 31;          //!< maximum number of registers per response
+
+    //! fifo shared memory (the registers follow the header)
+    struct fifo_t {
+        std::uint32_t magic;     //!< MAGIC
+        std::uint32_t version;   //!< VERSION
+        std::uint32_t capacity;  //!< number of registers (power of 2)
+        std::uint32_t reserved;
+
+        alignas(64) std::uint32_t head;  //!< written by the producer: number of pushed registers
+        alignas(64) std::uint32_t tail;  //!< written by the client: number of read registers
+    };
+
+private:
+    //! queue
+    struct queue_t {
+        std::uint16_t                         address;   //!< fifo pointer address
+        std::uint32_t                         capacity;  //!< number of registers of the ring
+        std::unique_ptr<cxxshm::SharedMemory> shm;       //!< shared memory of the ring
+        fifo_t                               *fifo;      //!< ring header
+        std::uint16_t                        *data;      //!< ring registers
+    };
+
+    const std::string shm_prefix;   //!< name prefix of the shared memory objects
+    const bool        force;        //!< use existing shared memory objects
+    const mode_t      permissions;  //!< shared memory file permissions
+    const bool        wire_order;   //!< registers are stored in modbus byte order (big endian)
+
+    std::vector<queue_t> queues;
+
+public:
+    /*! \brief create an empty set of queues
+     *
+     * @param shm_prefix name prefix of the shared memory objects
+     * @param force do not fail if a shared memory exist, but use the existing shared memory
+     * @param permissions shared memory file permissions
+     * @param wire_order registers are stored in modbus byte order (big endian)
+     */
+    Fifo_Queues(std::string shm_prefix, bool force, mode_t permissions, bool wire_order);
+
+    /*! \brief add a queue
+     *
+     * Format: <fifo pointer address>[:<capacity>] (capacity: number of registers, power of 2, default: 1024)
+     *
+     * @param definition queue definition
+     * @exception std::invalid_argument invalid definition
+     * @exception std::system_error failed to create the shared memory
+     */
+    void add(const std::string &definition);
+
+    /*! \brief handle a Read FIFO Queue request
+     *
+     * @param request received request
+     * @param response output: response pdu (at least MODBUS_MAX_PDU_LENGTH bytes)
+     * @return length of the response pdu, 0 if no response is sent (broadcast) or -1 if the request is no
+     *         Read FIFO Queue request
+     */
+    int reply(const Request &request, std::uint8_t *response) noexcept;
+};
+
+}  // namespace Modbus::shm
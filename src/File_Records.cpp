@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "File_Records.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace Modbus {
+
+//* reference type of all sub-requests
+static constexpr std::uint8_t REFERENCE_TYPE = 6;
+
+//* number of records per file (record numbers 0 - 9999)
+static constexpr std::size_t MAX_RECORDS = 10000;
+
+//* length of a sub-request header (reference type, file number, record number, record length)
+static constexpr std::size_t SUB_REQUEST_LENGTH = 7;
+
+//* size of a record
+static constexpr std::size_t RECORD_SIZE = 2;
+
+//* valid byte counts of the requests
+static constexpr int READ_MIN_BYTE_COUNT  = 0x07;
+static constexpr int READ_MAX_BYTE_COUNT  = 0xF5;
+static constexpr int WRITE_MIN_BYTE_COUNT = 0x09;
+static constexpr int WRITE_MAX_BYTE_COUNT = 0xFB;
+
+static inline std::uint16_t get_u16(const uint8_t *data) {
+    return static_cast<std::uint16_t>((data[0] << 8) | data[1]);  // NOLINT
+}
+
+//* decoded sub-request header
+struct sub_request_t {
+    std::uint8_t  reference_type;
+    std::uint16_t file;
+    std::uint16_t record;
+    std::uint16_t length;
+
+    explicit sub_request_t(const std::uint8_t *data)
+        : reference_type(data[0]), file(get_u16(data + 1)), record(get_u16(data + 3)),  // NOLINT
+          length(get_u16(data + 5)) {}                                                   // NOLINT
+};
+
+//* create an exception response
+static int exception(std::uint8_t function, std::uint8_t *response, int exception_code) noexcept {
+    response[0] = function | 0x80U;  // NOLINT
+    response[1] = static_cast<std::uint8_t>(exception_code);
+    return 2;
+}
+
+//* get the file number of a file name (0: no file number)
+static std::uint16_t file_number(const std::string &name) {
+    static constexpr unsigned long MAX_FILE_NUMBER = 0xFFFF;
+    if (name.empty() || name.size() > 5 || !std::all_of(name.begin(), name.end(), ::isdigit)) return 0;  // NOLINT
+    const auto number = std::stoul(name);
+    return number <= MAX_FILE_NUMBER ? static_cast<std::uint16_t>(number) : 0;
+}
+
+File_Records::File_Records(const std::string &directory) {
+    // collect all files first: different names can have the same file number (e.g. "1" and "01")
+    std::map<std::uint16_t, std::string> paths;
+    for (const auto &entry : std::filesystem::directory_iterator(directory)) {
+        if (!entry.is_regular_file()) continue;
+        const auto number = file_number(entry.path().filename().string());
+        if (number == 0) continue;
+
+        const auto [existing, inserted] = paths.emplace(number, entry.path().string());
+        if (!inserted)
+            throw std::invalid_argument("file number " + std::to_string(number) + " is used by '" + existing->second +
+                                        "' and '" + entry.path().string() + "'");
+    }
+
+    try {
+        for (const auto &[number, path] : paths) {
+            bool writable = true;
+            int  fd       = open(path.c_str(), O_RDWR | O_CLOEXEC);  // NOLINT
+            if (fd == -1 && (errno == EACCES || errno == EROFS)) {
+                writable = false;
+                fd       = open(path.c_str(), O_RDONLY | O_CLOEXEC);  // NOLINT
+            }
+            if (fd == -1) throw std::system_error(errno, std::generic_category(), "failed to open '" + path + "'");
+
+            struct stat st {};
+            if (fstat(fd, &st)) {
+                const int error = errno;
+                close(fd);
+                throw std::system_error(error, std::generic_category(), "failed to stat '" + path + "'");
+            }
+
+            file_t file {nullptr, std::min(static_cast<std::size_t>(st.st_size) / RECORD_SIZE, MAX_RECORDS), writable};
+            if (file.records) {
+                void *addr = mmap(nullptr,
+                                  file.records * RECORD_SIZE,
+                                  PROT_READ | (writable ? PROT_WRITE : 0),
+                                  MAP_SHARED,
+                                  fd,
+                                  0);
+                const int error = errno;
+                close(fd);
+                if (addr == MAP_FAILED)  // NOLINT
+                    throw std::system_error(error, std::generic_category(), "failed to map '" + path + "'");
+                file.data = static_cast<std::uint8_t *>(addr);
+            } else {
+                close(fd);
+            }
+            files.emplace(number, file);
+        }
+    } catch (...) {
+        for (const auto &[number, file] : files)
+            if (file.data) munmap(file.data, file.records * RECORD_SIZE);
+        throw;
+    }
+}
+
+File_Records::~File_Records() {
+    for (const auto &[number, file] : files)
+        if (file.data) munmap(file.data, file.records * RECORD_SIZE);
+}
+
+const File_Records::file_t *
+File_Records::find(std::uint16_t file, std::uint16_t record, std::uint16_t length) const noexcept {
+    const auto it = files.find(file);
+    if (it == files.end() || length == 0) return nullptr;
+    if (static_cast<std::size_t>(record) + length > it->second.records) return nullptr;
+    return &it->second;
+}
+
+int File_Records::reply(const Request &request, std::uint8_t *response) noexcept {
+    switch (request.function) {
+        case READ_FUNCTION_CODE: return read(request.get_pdu(), request.get_pdu_length(), response);
+        case WRITE_FUNCTION_CODE: return write(request.get_pdu(), request.get_pdu_length(), response);
+        default: return -1;
+    }
+}
+
+int File_Records::read(const std::uint8_t *pdu, int length, std::uint8_t *response) const noexcept {
+    if (length < 2) return exception(READ_FUNCTION_CODE, response, MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+    const int byte_count = pdu[1];
+    if (byte_count < READ_MIN_BYTE_COUNT || byte_count > READ_MAX_BYTE_COUNT || byte_count % SUB_REQUEST_LENGTH ||
+        length != 2 + byte_count)
+        return exception(READ_FUNCTION_CODE, response, MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+
+    const std::uint8_t *first = pdu + 2;           // NOLINT
+    const std::uint8_t *last  = first + byte_count;  // NOLINT
+
+    // validate all sub-requests and check that the response fits in one pdu
+    std::size_t response_length = 2;
+    for (const std::uint8_t *sub = first; sub != last; sub += SUB_REQUEST_LENGTH) {  // NOLINT
+        const sub_request_t header(sub);
+        if (header.reference_type != REFERENCE_TYPE || !find(header.file, header.record, header.length))
+            return exception(READ_FUNCTION_CODE, response, MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS);
+        response_length += 2 + header.length * RECORD_SIZE;
+        if (response_length > MODBUS_MAX_PDU_LENGTH)
+            return exception(READ_FUNCTION_CODE, response, MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+    }
+
+    response[0]       = READ_FUNCTION_CODE;
+    response[1]       = static_cast<std::uint8_t>(response_length - 2);
+    std::uint8_t *out = response + 2;  // NOLINT
+    for (const std::uint8_t *sub = first; sub != last; sub += SUB_REQUEST_LENGTH) {  // NOLINT
+        const sub_request_t header(sub);
+        const std::size_t   size = header.length * RECORD_SIZE;
+        out[0]                   = static_cast<std::uint8_t>(size + 1);
+        out[1]                   = REFERENCE_TYPE;
+        const auto         *file = find(header.file, header.record, header.length);
+        std::memcpy(out + 2, file->data + header.record * RECORD_SIZE, size);  // NOLINT
+        out += 2 + size;  // NOLINT
+    }
+    return static_cast<int>(response_length);
+}
+
+int File_Records::write(const std::uint8_t *pdu, int length, std::uint8_t *response) noexcept {
+    if (length < 2) return exception(WRITE_FUNCTION_CODE, response, MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+    const int byte_count = pdu[1];
+    if (byte_count < WRITE_MIN_BYTE_COUNT || byte_count > WRITE_MAX_BYTE_COUNT || length != 2 + byte_count)
+        return exception(WRITE_FUNCTION_CODE, response, MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+
+    const std::uint8_t *first = pdu + 2;           // NOLINT
+    const std::uint8_t *last  = first + byte_count;  // NOLINT
+
+    // validate all sub-requests before any record is written
+    for (const std::uint8_t *sub = first; sub != last;) {
+        if (static_cast<std::size_t>(last - sub) < SUB_REQUEST_LENGTH)
+            return exception(WRITE_FUNCTION_CODE, response, MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+        const sub_request_t header(sub);
+        const std::size_t   size = header.length * RECORD_SIZE;
+        if (static_cast<std::size_t>(last - sub) < SUB_REQUEST_LENGTH + size)
+            return exception(WRITE_FUNCTION_CODE, response, MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+
+        const auto *file = find(header.file, header.record, header.length);
+        if (header.reference_type != REFERENCE_TYPE || !file || !file->writable)
+            return exception(WRITE_FUNCTION_CODE, response, MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS);
+        sub += SUB_REQUEST_LENGTH + size;  // NOLINT
+    }
+
+    for (const std::uint8_t *sub = first; sub != last;) {
+        const sub_request_t header(sub);
+        const std::size_t   size = header.length * RECORD_SIZE;
+        const auto         *file = find(header.file, header.record, header.length);
+        std::memcpy(file->data + header.record * RECORD_SIZE, sub + SUB_REQUEST_LENGTH, size);  // NOLINT
+        sub += SUB_REQUEST_LENGTH + size;  // NOLINT
+    }
+
+    // the response is an echo of the request
+    std::memcpy(response, pdu, static_cast<std::size_t>(length));
+    return length;
+}
+
+}  // namespace Modbus
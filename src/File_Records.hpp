@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Modbus_Request.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace Modbus {
+
+/*! \brief Read/Write File Record requests (FC 0x14, FC 0x15) served from memory mapped files
+ *
+ * Each file of a directory whose name is a file number (1 - 65535) is mapped (shared) at startup.
+ * A record is one register (2 bytes) of the file: record n is stored at byte offset 2 * n in modbus byte order.
+ * Records are copied directly between the request/response and the mapping. The files are not resized,
+ * records beyond the end of a file (or beyond record 9999) are answered with an illegal data address exception.
+ *
+ * A request is validated completely before any record is written.
+ * Files that can not be opened for writing are mapped read only; write requests to them are rejected.
+ */
+class File_Records final {
+public:
+    static constexpr std::uint8_t READ_FUNCTION_CODE  = 0x14;  //!< read file record
+    static constexpr std::uint8_t WRITE_FUNCTION_CODE = 0x15;  //!< write file record
+
+private:
+    //! mapped file
+    struct file_t {
+        std::uint8_t *data;      //!< mapping of the file (nullptr if the file is empty)
+        std::size_t   records;   //!< number of records
+        bool          writable;  //!< the file is mapped writable
+    };
+
+    std::map<std::uint16_t, file_t> files;  //!< mapped files per file number
+
+    //* get a file that contains a range of records (nullptr if the records do not exist)
+    [[nodiscard]] const file_t *find(std::uint16_t file, std::uint16_t record, std::uint16_t length) const noexcept;
+
+    //* serve a read file record request
+    int read(const std::uint8_t *pdu, int length, std::uint8_t *response) const noexcept;
+
+    //* serve a write file record request
+    int write(const std::uint8_t *pdu, int length, std::uint8_t *response) noexcept;
+
+public:
+    /*! \brief map all files of a directory
+     *
+     * @param directory directory that contains the files (file name: file number)
+     * @exception std::system_error failed to open or map a file
+     * @exception std::invalid_argument two files have the same file number
+     */
+    explicit File_Records(const std::string &directory);
+
+    ~File_Records();
+
+    File_Records(const File_Records &other)            = delete;
+    File_Records(File_Records &&other)                 = delete;
+    File_Records &operator=(const File_Records &other) = delete;
+    File_Records &operator=(File_Records &&other)      = delete;
+
+    /*! \brief handle a Read/Write File Record request
+     *
+     * @param request received request
+     * @param response output: response pdu (at least MODBUS_MAX_PDU_LENGTH bytes)
+     * @return length of the response pdu or -1 if the request is no file record request
+     */
+    int reply(const Request &request, std::uint8_t *response) noexcept;
+
+    /*! \brief get the number of mapped files
+     *
+     * @return number of files
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return files.size(); }
+};
+
+}  // namespace Modbus
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Frame_Receiver.hpp"
+
+#include "monotonic_time.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <modbus/modbus.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace Modbus::RTU {
+
+//* length of the header of a rtu frame (slave id)
+static constexpr int HEADER_LENGTH = 1;
+
+//* length of the checksum of a rtu frame
+static constexpr int CHECKSUM_LENGTH = 2;
+
+//* length of the shortest valid frame (slave id, function code, checksum)
+static constexpr int MIN_LENGTH = HEADER_LENGTH + 1 + CHECKSUM_LENGTH;
+
+//* function codes that are not defined by libmodbus
+static constexpr std::uint8_t FC_DIAGNOSTICS            = 0x08;
+static constexpr std::uint8_t FC_GET_COMM_EVENT_COUNTER = 0x0B;
+static constexpr std::uint8_t FC_GET_COMM_EVENT_LOG     = 0x0C;
+static constexpr std::uint8_t FC_READ_FILE_RECORD       = 0x14;
+static constexpr std::uint8_t FC_WRITE_FILE_RECORD      = 0x15;
+static constexpr std::uint8_t FC_READ_FIFO_QUEUE        = 0x18;
+static constexpr std::uint8_t FC_ENCAPSULATED_INTERFACE = 0x2B;
+
+//* sub-function of diagnostics requests with data of any length (return query data)
+static constexpr std::uint16_t DIAGNOSTICS_RETURN_QUERY_DATA = 0x0000;
+
+//* MEI type of read device identification requests
+static constexpr std::uint8_t MEI_READ_DEVICE_IDENTIFICATION = 0x0E;
+
+//* silent interval in characters
+static constexpr double SILENT_INTERVAL_CHARACTERS = 3.5;
+
+//* baud rate above which the silent interval is fixed
+static constexpr int FIXED_SILENT_INTERVAL_BAUD = 19200;
+
+//* silent interval above 19200 baud in nanoseconds
+static constexpr double FIXED_SILENT_INTERVAL = 1'750'000;
+
+//* number of nanoseconds per second
+static constexpr double NS_PER_SECOND = 1e9;
+
+static timespec to_timespec(double nanoseconds) noexcept {
+    const auto ns = std::llround(nanoseconds);
+    return {static_cast<time_t>(ns / static_cast<long long>(NS_PER_SECOND)),
+            static_cast<long>(ns % static_cast<long long>(NS_PER_SECOND))};
+}
+
+//* modbus crc16 (polynomial 0xA001, initial value 0xFFFF)
+static std::uint16_t crc16(const std::uint8_t *data, int length) noexcept {
+    static constexpr std::uint16_t POLYNOMIAL = 0xA001;
+
+    std::uint16_t crc = 0xFFFF;
+    for (int i = 0; i < length; ++i) {
+        crc ^= data[i];  // NOLINT
+        for (int bit = 0; bit < 8; ++bit)
+            crc = static_cast<std::uint16_t>(crc & 1U ? (crc >> 1U) ^ POLYNOMIAL : crc >> 1U);
+    }
+    return crc;
+}
+
+Frame_Receiver::Frame_Receiver(int fd, std::uint8_t slave, int baud, int data_bits, char parity, int stop_bits)
+    : fd(fd), slave(slave) {
+    const double character_time =
+            static_cast<double>(1 + data_bits + (parity == 'N' ? 0 : 1) + stop_bits) * NS_PER_SECOND / baud;
+    silent_interval = to_timespec(baud > FIXED_SILENT_INTERVAL_BAUD ? FIXED_SILENT_INTERVAL
+                                                                    : SILENT_INTERVAL_CHARACTERS * character_time);
+}
+
+void Frame_Receiver::set_byte_timeout(double timeout) noexcept {
+    byte_timeout = to_timespec(timeout * NS_PER_SECOND);
+}
+
+int Frame_Receiver::request_length(const std::uint8_t *adu, int size) noexcept {
+    if (size < HEADER_LENGTH + 1) return HEADER_LENGTH + 1;
+
+    // number of received bytes of the pdu, function code at pdu[0]
+    const std::uint8_t *pdu      = adu + HEADER_LENGTH;  // NOLINT
+    const int           received = size - HEADER_LENGTH;
+
+    // the pdu header (first header bytes) is required to derive the length
+    const auto missing = [received](int header) { return received < header; };
+
+    int pdu_length = 0;
+    switch (pdu[0]) {
+        case MODBUS_FC_READ_COILS:
+        case MODBUS_FC_READ_DISCRETE_INPUTS:
+        case MODBUS_FC_READ_HOLDING_REGISTERS:
+        case MODBUS_FC_READ_INPUT_REGISTERS:
+        case MODBUS_FC_WRITE_SINGLE_COIL:
+        case MODBUS_FC_WRITE_SINGLE_REGISTER: pdu_length = 5; break;  // NOLINT
+        case MODBUS_FC_READ_EXCEPTION_STATUS:
+        case FC_GET_COMM_EVENT_COUNTER:
+        case FC_GET_COMM_EVENT_LOG:
+        case MODBUS_FC_REPORT_SLAVE_ID: pdu_length = 1; break;
+        case MODBUS_FC_WRITE_MULTIPLE_COILS:
+        case MODBUS_FC_WRITE_MULTIPLE_REGISTERS:
+            // function code, address, quantity, byte count, values
+            if (missing(6)) return HEADER_LENGTH + 6;  // NOLINT
+            pdu_length = 6 + pdu[5];                   // NOLINT
+            break;
+        case MODBUS_FC_MASK_WRITE_REGISTER: pdu_length = 7; break;  // NOLINT
+        case MODBUS_FC_WRITE_AND_READ_REGISTERS:
+            // function code, read address, read quantity, write address, write quantity, byte count, values
+            if (missing(10)) return HEADER_LENGTH + 10;  // NOLINT
+            pdu_length = 10 + pdu[9];                    // NOLINT
+            break;
+        case FC_DIAGNOSTICS:
+            // function code, sub-function, data (one word, except return query data)
+            if (missing(3)) return HEADER_LENGTH + 3;
+            if (((pdu[1] << 8U) | pdu[2]) == DIAGNOSTICS_RETURN_QUERY_DATA) return 0;
+            pdu_length = 5;  // NOLINT
+            break;
+        case FC_READ_FILE_RECORD:
+        case FC_WRITE_FILE_RECORD:
+            // function code, byte count, sub-requests
+            if (missing(2)) return HEADER_LENGTH + 2;
+            pdu_length = 2 + pdu[1];
+            break;
+        case FC_READ_FIFO_QUEUE: pdu_length = 3; break;
+        case FC_ENCAPSULATED_INTERFACE:
+            // function code, MEI type, read device id code, object id
+            if (missing(2)) return HEADER_LENGTH + 2;
+            if (pdu[1] != MEI_READ_DEVICE_IDENTIFICATION) return 0;
+            pdu_length = 4;
+            break;
+        default: return 0;
+    }
+
+    const int length = HEADER_LENGTH + pdu_length + CHECKSUM_LENGTH;
+    return length <= MODBUS_RTU_MAX_ADU_LENGTH ? length : 0;
+}
+
+int Frame_Receiver::receive(std::uint8_t *adu) {
+    int  size      = 0;      // bytes in adu
+    int  discarded = 0;      // bytes that did not fit in adu
+    bool own       = false;  // frame to this client or broadcast
+    bool complete  = true;   // false: a frame of known length ended before all bytes were received
+
+    for (;;) {
+        // bytes that belong to the frame (0: the frame ends with a silent interval)
+        int expected = 1;
+        if (size) expected = own ? request_length(adu, size) : 0;
+        if (expected == size) break;
+
+        pollfd          pfd {fd, POLLIN, 0};
+        const timespec *timeout = expected ? &byte_timeout : &silent_interval;
+        const int       ready   = ppoll(&pfd, 1, size ? timeout : nullptr, nullptr);
+        if (ready == -1) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (ready == 0) {
+            complete = !expected;
+            break;
+        }
+
+        // a frame of unknown length that is longer than the buffer is received completely, but not stored
+        std::array<std::uint8_t, MODBUS_RTU_MAX_ADU_LENGTH> overflow {};
+        std::uint8_t *buffer = adu + size;  // NOLINT
+        int           count  = expected ? expected - size : MODBUS_RTU_MAX_ADU_LENGTH - size;
+        if (count == 0) {
+            buffer = overflow.data();
+            count  = static_cast<int>(overflow.size());
+        }
+
+        const auto received = read(fd, buffer, static_cast<std::size_t>(count));
+        if (received == 0) {
+            errno = ECONNRESET;
+            return -1;
+        }
+        if (received == -1) {
+            if (errno == EAGAIN || errno == EINTR) continue;
+            return -1;
+        }
+        timestamp = monotonic_ns();
+
+        if (debug) {
+            for (int i = 0; i < received; ++i)
+                std::cout << '<' << std::hex << std::uppercase << std::setw(2) << std::setfill('0')
+                          << static_cast<int>(buffer[i]) << '>' << std::dec;  // NOLINT
+        }
+
+        if (buffer == overflow.data()) {
+            discarded += static_cast<int>(received);
+        } else {
+            size += static_cast<int>(received);
+        }
+        own = adu[0] == slave || adu[0] == MODBUS_BROADCAST_ADDRESS;
+    }
+    if (debug) std::cout << std::endl;  // NOLINT
+
+    length = size + discarded;
+    if (!own) return 0;
+
+    if (!complete || discarded || size < MIN_LENGTH ||
+        crc16(adu, size - CHECKSUM_LENGTH) != ((adu[size - 1] << 8U) | adu[size - 2])) {  // NOLINT
+        errno = EMBBADCRC;
+        return -1;
+    }
+    return size;
+}
+
+}  // namespace Modbus::RTU
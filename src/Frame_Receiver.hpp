@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+
+namespace Modbus::RTU {
+
+/*! \brief receives the frames on the serial line
+ *
+ * modbus_receive derives the length of a request only for the function codes that are served by libmodbus.
+ * Requests with other function codes are cut after the function code and fail the checksum check.
+ *
+ * The length of a request to this client is derived from the function code and the header of the request (byte
+ * count, sub-function, MEI type). Frames whose length can not be derived from the header (e.g. vendor specific
+ * function codes) and frames to other slaves (requests and responses) end with a silent interval of 3.5 characters
+ * (1.75ms above 19200 baud).
+ */
+class Frame_Receiver final {
+private:
+    int           fd;                  //!< serial device (non-blocking)
+    std::uint8_t  slave;               //!< id of this client
+    timespec      silent_interval {};  //!< silence that ends a frame of unknown length
+    timespec      byte_timeout {};     //!< maximum time between two bytes of a frame of known length
+    bool          debug     = false;   //!< print the received frames
+    int           length    = 0;       //!< length of the last frame
+    std::uint64_t timestamp = 0;       //!< time the last byte of the last frame was received
+
+public:
+    /*! \brief create a receiver
+     *
+     * @param fd serial device (see modbus_get_socket)
+     * @param slave id of this client
+     * @param baud serial baud rate
+     * @param data_bits serial data bits
+     * @param parity serial parity ('N', 'E' or 'O')
+     * @param stop_bits serial stop bits
+     */
+    Frame_Receiver(int fd, std::uint8_t slave, int baud, int data_bits, char parity, int stop_bits);
+
+    /*! \brief set the maximum time between two bytes of a frame
+     *
+     * A frame of known length that is not complete within this time is invalid.
+     *
+     * @param timeout byte timeout in seconds
+     */
+    void set_byte_timeout(double timeout) noexcept;
+
+    /*! \brief enable/disable the output of the received frames
+     *
+     * @param enable true: print each received frame (same format as libmodbus)
+     */
+    void set_debug(bool enable) noexcept { debug = enable; }
+
+    /*! \brief receive the next frame
+     *
+     * Waits until the first byte of the frame is received.
+     * Frames to other slaves are not checked.
+     *
+     * @param adu output: received frame (MODBUS_RTU_MAX_ADU_LENGTH bytes)
+     * @return length of the frame if it is addressed to this client (or broadcast), 0 if it is addressed to another
+     *         slave or -1 on error (errno EMBBADCRC: checksum error or incomplete frame,
+     *         ECONNRESET: the device was closed)
+     */
+    int receive(std::uint8_t *adu);
+
+    //! length of the last frame (also frames to other slaves and invalid frames)
+    [[nodiscard]] int get_length() const noexcept { return length; }
+
+    //! time the last byte of the last frame was received (CLOCK_MONOTONIC in nanoseconds)
+    [[nodiscard]] std::uint64_t get_timestamp() const noexcept { return timestamp; }
+
+    /*! \brief derive the length of a request from its header
+     *
+     * @param adu received bytes of the request (starting with the slave id)
+     * @param size number of received bytes
+     * @return length of the request, the number of bytes that are required to derive the length (more than size) or
+     *         0 if the length can not be derived from the header
+     */
+    [[nodiscard]] static int request_length(const std::uint8_t *adu, int size) noexcept;
+};
+
+}  // namespace Modbus::RTU
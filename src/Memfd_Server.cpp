@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Memfd_Server.hpp"
+
+#include "Print_Time.hpp"
+#include "unix_socket.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <utility>
+
+namespace Modbus {
+
+Memfd_Server::Memfd_Server(std::string                   path,
+                           const storage::Memfd_Storage &storage,
+                           bool                          wire_order,
+                           mode_t                        permissions)
+    : path(std::move(path)), fds(storage.get_fds()) {
+    const auto *mapping = storage.get_mapping();
+
+    descriptor.magic     = consumer::Memfd_Receiver::MAGIC;
+    descriptor.version   = consumer::Memfd_Receiver::VERSION;
+    descriptor.flags     = wire_order ? consumer::Memfd_Receiver::FLAG_WIRE_ORDER : 0;
+    descriptor.values[0] = static_cast<std::uint32_t>(mapping->nb_bits);
+    descriptor.values[1] = static_cast<std::uint32_t>(mapping->nb_input_bits);
+    descriptor.values[2] = static_cast<std::uint32_t>(mapping->nb_registers);
+    descriptor.values[3] = static_cast<std::uint32_t>(mapping->nb_input_registers);
+
+    listen_fd = create_unix_listener(this->path, SOCK_SEQPACKET, permissions);
+}
+
+Memfd_Server::~Memfd_Server() {
+    close(listen_fd);
+    unlink(path.c_str());
+}
+
+void Memfd_Server::handle_connections() const {
+    for (;;) {
+        const int connection = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (connection == -1) {
+            if (errno != EAGAIN && errno != EINTR)
+                std::cerr << Print_Time::iso << " WARNING: memfd socket: accept failed: " << strerror(errno) << '\n';
+            return;
+        }
+
+        iovec iov {};
+        iov.iov_base = const_cast<consumer::Memfd_Receiver::memfd_descriptor_t *>(&descriptor);  // NOLINT
+        iov.iov_len  = sizeof(descriptor);
+
+        alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(int) * TABLE_COUNT)> control {};
+        msghdr msg {};
+        msg.msg_iov        = &iov;
+        msg.msg_iovlen     = 1;
+        msg.msg_control    = control.data();
+        msg.msg_controllen = control.size();
+
+        cmsghdr *cmsg    = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type  = SCM_RIGHTS;
+        cmsg->cmsg_len   = CMSG_LEN(sizeof(int) * TABLE_COUNT);
+        std::memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * TABLE_COUNT);  // NOLINT
+
+        // the message is small: it never blocks on a new connection
+        if (sendmsg(connection, &msg, MSG_DONTWAIT | MSG_NOSIGNAL) == -1)
+            std::cerr << Print_Time::iso << " WARNING: memfd socket: failed to send memfds: " << strerror(errno)
+                      << '\n';
+
+        close(connection);
+    }
+}
+
+}  // namespace Modbus
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Memfd_Storage.hpp"
+#include "modbus_rtu_client_shm/consumer.hpp"
+
+#include <array>
+#include <string>
+#include <sys/types.h>
+
+namespace Modbus {
+
+/*! \brief unix domain socket that hands the memory files of the register tables to consumers
+ *
+ * Each process that connects to the socket receives one message (consumer::Memfd_Receiver::memfd_descriptor_t)
+ * with the file descriptors of the tables (SCM_RIGHTS). The connection is closed afterward.
+ * Access is controlled by the file permissions of the socket.
+ */
+class Memfd_Server final {
+private:
+    std::string path;       //!< path of the socket
+    int         listen_fd;  //!< listening socket
+
+    consumer::Memfd_Receiver::memfd_descriptor_t descriptor {};  //!< message that is sent to each consumer
+
+    std::array<int, TABLE_COUNT> fds;  //!< file descriptors of the tables
+
+public:
+    /*! \brief create the socket
+     *
+     * A stale socket file of a terminated instance is replaced.
+     *
+     * @param path path of the socket
+     * @param storage register tables
+     * @param wire_order AO/AI registers are stored in modbus byte order (big endian)
+     * @param permissions file permissions of the socket
+     * @exception std::system_error failed to create the socket
+     */
+    Memfd_Server(std::string path, const storage::Memfd_Storage &storage, bool wire_order, mode_t permissions);
+
+    ~Memfd_Server();
+
+    Memfd_Server(const Memfd_Server &other)            = delete;
+    Memfd_Server(Memfd_Server &&other)                 = delete;
+    Memfd_Server &operator=(const Memfd_Server &other) = delete;
+    Memfd_Server &operator=(Memfd_Server &&other)      = delete;
+
+    /*! \brief get the listening socket (readable if a consumer connects)
+     *
+     * @return file descriptor
+     */
+    [[nodiscard]] int get_fd() const noexcept { return listen_fd; }
+
+    /*! \brief send the memory files to all pending consumers
+     *
+     * Does not block. Failed transmissions are logged and otherwise ignored.
+     */
+    void handle_connections() const;
+};
+
+}  // namespace Modbus
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Memfd_Storage.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace Modbus::storage {
+
+//* seals of the memory files: the size can not be changed anymore
+static constexpr int SEALS = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL;
+
+static constexpr std::array<const char *, TABLE_COUNT> TABLE_SUFFIX = {"DO", "DI", "AO", "AI"};
+
+Memfd_Storage::Memfd_Storage(std::size_t        nb_bits,             // NOLINT
+                             std::size_t        nb_input_bits,       // NOLINT
+                             std::size_t        nb_registers,        // NOLINT
+                             std::size_t        nb_input_registers,  // NOLINT
+                             const std::string &name)
+    : Register_Storage(nb_bits, nb_input_bits, nb_registers, nb_input_registers) {
+    sizes[DO] = nb_bits;
+    sizes[DI] = nb_input_bits;
+    sizes[AO] = nb_registers * sizeof(uint16_t);
+    sizes[AI] = nb_input_registers * sizeof(uint16_t);
+
+    try {
+        for (std::size_t i = 0; i < TABLE_COUNT; ++i) {
+            const std::string file_name = name + TABLE_SUFFIX[i];  // NOLINT
+
+            fds[i] = memfd_create(file_name.c_str(), MFD_CLOEXEC | MFD_ALLOW_SEALING);  // NOLINT
+            if (fds[i] == -1)                                                           // NOLINT
+                throw std::system_error(errno, std::generic_category(), "failed to create memfd '" + file_name + "'");
+
+            if (ftruncate(fds[i], static_cast<off_t>(sizes[i])))  // NOLINT
+                throw std::system_error(errno, std::generic_category(), "failed to resize memfd '" + file_name + "'");
+
+            if (fcntl(fds[i], F_ADD_SEALS, SEALS))  // NOLINT
+                throw std::system_error(errno, std::generic_category(), "failed to seal memfd '" + file_name + "'");
+
+            addrs[i] = mmap(nullptr, sizes[i], PROT_READ | PROT_WRITE, MAP_SHARED, fds[i], 0);  // NOLINT
+            if (addrs[i] == MAP_FAILED) {                                                        // NOLINT
+                addrs[i] = nullptr;                                                              // NOLINT
+                throw std::system_error(errno, std::generic_category(), "failed to map memfd '" + file_name + "'");
+            }
+        }
+    } catch (const std::system_error &) {
+        release();
+        throw;
+    }
+
+    mapping.tab_bits            = static_cast<uint8_t *>(addrs[DO]);
+    mapping.tab_input_bits      = static_cast<uint8_t *>(addrs[DI]);
+    mapping.tab_registers       = static_cast<uint16_t *>(addrs[AO]);
+    mapping.tab_input_registers = static_cast<uint16_t *>(addrs[AI]);
+}
+
+Memfd_Storage::~Memfd_Storage() {
+    release();
+}
+
+void Memfd_Storage::release() noexcept {
+    for (std::size_t i = 0; i < TABLE_COUNT; ++i) {
+        if (addrs[i]) munmap(addrs[i], sizes[i]);  // NOLINT
+        if (fds[i] != -1) close(fds[i]);            // NOLINT
+        addrs[i] = nullptr;                         // NOLINT
+        fds[i]   = -1;                              // NOLINT
+    }
+}
+
+}  // namespace Modbus::storage
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Modbus_Request.hpp"
+#include "Register_Storage.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+namespace Modbus::storage {
+
+/*! \brief register tables in anonymous memory files (memfd)
+ *
+ * One memory file is created per table. The size of each file is sealed (F_SEAL_SHRINK, F_SEAL_GROW, F_SEAL_SEAL),
+ * therefore a process that receives the file descriptor can map the complete file without risking SIGBUS.
+ * The memory files are not visible in the file system and are released when the last file descriptor is closed.
+ */
+class Memfd_Storage final : public Register_Storage {
+private:
+    //! file descriptors of the tables
+    std::array<int, TABLE_COUNT> fds {-1, -1, -1, -1};
+
+    //! mapped tables
+    std::array<void *, TABLE_COUNT> addrs {nullptr, nullptr, nullptr, nullptr};
+
+    //! sizes of the tables in bytes
+    std::array<std::size_t, TABLE_COUNT> sizes {};
+
+    //* unmap and close all tables
+    void release() noexcept;
+
+public:
+    /*! \brief create the register tables
+     *
+     * @param nb_bits number of digital output registers (DO)
+     * @param nb_input_bits number of digital input registers (DI)
+     * @param nb_registers number of analog output registers (AO)
+     * @param nb_input_registers number of analog input registers (AI)
+     * @param name name prefix of the memory files (only used for debugging, e.g. in /proc/<pid>/fd)
+     * @exception std::invalid_argument invalid number of registers
+     * @exception std::system_error failed to create the memory files
+     */
+    Memfd_Storage(std::size_t        nb_bits,
+                  std::size_t        nb_input_bits,
+                  std::size_t        nb_registers,
+                  std::size_t        nb_input_registers,
+                  const std::string &name);
+
+    ~Memfd_Storage() override;
+
+    Memfd_Storage(const Memfd_Storage &other)            = delete;
+    Memfd_Storage(Memfd_Storage &&other)                 = delete;
+    Memfd_Storage &operator=(const Memfd_Storage &other) = delete;
+    Memfd_Storage &operator=(Memfd_Storage &&other)      = delete;
+
+    /*! \brief get the file descriptors of the tables
+     *
+     * @return file descriptors (index: table_t)
+     */
+    [[nodiscard]] const std::array<int, TABLE_COUNT> &get_fds() const noexcept { return fds; }
+};
+
+}  // namespace Modbus::storage
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Metrics.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+
+namespace Modbus {
+
+//* number of nanoseconds per second
+static constexpr double NS_PER_SECOND = 1e9;
+
+//* format a floating point value
+static std::string format(double value) {
+    std::array<char, 32> buffer {};
+    std::snprintf(buffer.data(), buffer.size(), "%.9g", value);  // NOLINT
+    return buffer.data();
+}
+
+//* append the header of a metric
+static void header(std::string &out, const char *name, const char *type, const char *help) {
+    out += std::string("# HELP ") + name + ' ' + help + '\n';
+    out += std::string("# TYPE ") + name + ' ' + type + '\n';
+}
+
+//* append a sample
+static void sample(std::string &out, const std::string &name, const std::string &labels, const std::string &value) {
+    out += name;
+    if (!labels.empty()) out += '{' + labels + '}';
+    out += ' ' + value + '\n';
+}
+
+void Metrics::histogram_t::observe(std::uint64_t duration) noexcept {
+    const auto bucket = static_cast<std::size_t>(
+            std::lower_bound(BUCKET_BOUNDS.begin(), BUCKET_BOUNDS.end(), duration) - BUCKET_BOUNDS.begin());
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);  // NOLINT
+    sum.fetch_add(duration, std::memory_order_relaxed);
+}
+
+Metrics::Metrics(int baud, int data_bits, char parity, int stop_bits)
+    : character_time(static_cast<double>(1 + data_bits + (parity == 'N' ? 0 : 1) + stop_bits) / baud) {}
+
+//* append the samples of a histogram
+static void histogram(std::string &out, const char *name, const std::string &labels, const auto &histogram) {
+    const std::string prefix = labels.empty() ? "" : labels + ',';
+
+    std::uint64_t count = 0;
+    for (std::size_t i = 0; i < Metrics::BUCKETS; ++i) {
+        count += histogram.buckets[i].load(std::memory_order_relaxed);                           // NOLINT
+        const auto upper_bound = static_cast<double>(Metrics::BUCKET_BOUNDS[i]) / NS_PER_SECOND;  // NOLINT
+        sample(out, std::string(name) + "_bucket", prefix + "le=\"" + format(upper_bound) + '"', std::to_string(count));
+    }
+    count += histogram.buckets[Metrics::BUCKETS].load(std::memory_order_relaxed);
+    sample(out, std::string(name) + "_bucket", prefix + "le=\"+Inf\"", std::to_string(count));
+    sample(out,
+           std::string(name) + "_sum",
+           labels,
+           format(static_cast<double>(histogram.sum.load(std::memory_order_relaxed)) / NS_PER_SECOND));
+    sample(out, std::string(name) + "_count", labels, std::to_string(count));
+}
+
+std::string Metrics::render_prometheus(const modbus_mapping_t &mapping) const {
+    std::string out;
+
+    header(out,
+           "modbus_request_duration_seconds",
+           "histogram",
+           "Time from the reception of a request until the response is sent, per function code.");
+    for (std::size_t function = 0; function < requests.size(); ++function) {
+        const auto &hist = requests[function];  // NOLINT
+        if (std::none_of(hist.buckets.begin(), hist.buckets.end(), [](const auto &bucket) {
+                return bucket.load(std::memory_order_relaxed) != 0;
+            }))
+            continue;
+        histogram(out, "modbus_request_duration_seconds", "function=\"" + std::to_string(function) + '"', hist);
+    }
+
+    header(out, "modbus_exceptions_total", "counter", "Exception responses per function code.");
+    for (std::size_t function = 0; function < exceptions.size(); ++function) {
+        const auto count = exceptions[function].load(std::memory_order_relaxed);  // NOLINT
+        if (count) {
+            sample(out,
+                   "modbus_exceptions_total",
+                   "function=\"" + std::to_string(function) + '"',
+                   std::to_string(count));
+        }
+    }
+
+    const auto counter = [&out](const char *name, const char *help, const std::atomic<std::uint64_t> &value) {
+        header(out, name, "counter", help);
+        sample(out, name, "", std::to_string(value.load(std::memory_order_relaxed)));
+    };
+    counter("modbus_ignored_requests_total", "Requests that were not served (listen only mode).", ignored_requests);
+    counter("modbus_foreign_frames_total", "Frames that are addressed to other slaves.", foreign_frames);
+    counter("modbus_checksum_errors_total", "Received frames with checksum errors.", checksum_errors);
+    counter("modbus_semaphore_timeouts_total", "Failures to acquire the semaphore.", semaphore_timeouts);
+
+    header(out, "modbus_lock_wait_seconds", "histogram", "Time to acquire the semaphore.");
+    histogram(out, "modbus_lock_wait_seconds", "", lock_wait);
+    header(out, "modbus_lock_hold_seconds", "histogram", "Time the semaphore is held.");
+    histogram(out, "modbus_lock_hold_seconds", "", lock_hold);
+
+    const auto rx = received_bytes.load(std::memory_order_relaxed);
+    const auto tx = sent_bytes.load(std::memory_order_relaxed);
+    header(out, "modbus_bus_bytes_total", "counter", "Bytes of the requests to this client and of its responses.");
+    sample(out, "modbus_bus_bytes_total", "direction=\"rx\"", std::to_string(rx));
+    sample(out, "modbus_bus_bytes_total", "direction=\"tx\"", std::to_string(tx));
+    header(out,
+           "modbus_bus_busy_seconds_total",
+           "counter",
+           "Time the bus is occupied by the requests to this client and its responses.");
+    sample(out, "modbus_bus_busy_seconds_total", "", format(static_cast<double>(rx + tx) * character_time));
+
+    const std::array<std::pair<const char *, std::size_t>, 4> tables {{
+            {"DO", static_cast<std::size_t>(mapping.nb_bits)},
+            {"DI", static_cast<std::size_t>(mapping.nb_input_bits)},
+            {"AO", static_cast<std::size_t>(mapping.nb_registers)},
+            {"AI", static_cast<std::size_t>(mapping.nb_input_registers)},
+    }};
+    header(out, "modbus_table_registers", "gauge", "Number of registers per table.");
+    for (const auto &[table, count] : tables)
+        sample(out, "modbus_table_registers", std::string("table=\"") + table + '"', std::to_string(count));
+    header(out, "modbus_table_size_bytes", "gauge", "Size of the register tables in bytes.");
+    for (const auto &[table, count] : tables) {
+        const std::size_t size = table[0] == 'A' ? count * sizeof(std::uint16_t) : count;
+        sample(out, "modbus_table_size_bytes", std::string("table=\"") + table + '"', std::to_string(size));
+    }
+
+    return out;
+}
+
+void Metrics::write_file(const std::string &path, const modbus_mapping_t &mapping, mode_t permissions) const {
+    const std::string content  = render_prometheus(mapping);
+    const std::string tmp_path = path + ".tmp";
+
+    // the temporary file is always created (permissions), never opened through a symbolic link
+    unlink(tmp_path.c_str());
+    const int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, permissions);  // NOLINT
+    if (fd == -1) throw std::system_error(errno, std::generic_category(), "failed to create '" + tmp_path + "'");
+
+    const char *data   = content.data();
+    std::size_t length = content.size();
+    while (length) {
+        const ssize_t written = write(fd, data, length);
+        if (written == -1) {
+            if (errno == EINTR) continue;
+            const int error = errno;
+            close(fd);
+            unlink(tmp_path.c_str());
+            throw std::system_error(error, std::generic_category(), "failed to write '" + tmp_path + "'");
+        }
+        data   += written;  // NOLINT
+        length -= static_cast<std::size_t>(written);
+    }
+    close(fd);
+
+    // the collector never reads a partially written file
+    if (rename(tmp_path.c_str(), path.c_str())) {
+        const int error = errno;
+        unlink(tmp_path.c_str());
+        throw std::system_error(error, std::generic_category(), "failed to rename '" + tmp_path + "'");
+    }
+}
+
+}  // namespace Modbus
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <modbus/modbus.h>
+#include <string>
+#include <sys/types.h>
+
+namespace Modbus {
+
+/*! \brief pre-aggregated metrics of the client (Prometheus text exposition format)
+ *
+ * The exposition uses the Prometheus text format 0.0.4 (the format of the node_exporter textfile collector), not
+ * OpenMetrics: counters are declared with their _total names and the exposition does not end with # EOF.
+ *
+ * The request path only increments relaxed atomic counters. The exposition is rendered on demand from the counters
+ * (metrics socket, textfile): rendering does not access the request path.
+ *
+ * Durations are recorded in histograms with fixed buckets (100us - 1s).
+ * The bus busy time is calculated from the number of transmitted characters and the serial configuration.
+ */
+class Metrics final {
+public:
+    static constexpr std::size_t BUCKETS = 10;  //!< number of histogram buckets (without +Inf)
+
+    //! upper bounds of the histogram buckets in nanoseconds
+    static constexpr std::array<std::uint64_t, BUCKETS> BUCKET_BOUNDS {
+            100'000, 250'000, 500'000, 1'000'000, 2'500'000, 5'000'000, 10'000'000, 25'000'000, 100'000'000,
+            1'000'000'000};
+
+private:
+    //! histogram of durations
+    struct histogram_t {
+        std::array<std::atomic<std::uint64_t>, BUCKETS + 1> buckets {};  //!< non-cumulative (last bucket: +Inf)
+        std::atomic<std::uint64_t>                          sum {};      //!< sum of all durations in nanoseconds
+
+        //* record a duration
+        void observe(std::uint64_t duration) noexcept;
+    };
+
+    std::array<histogram_t, 256>                requests;    //!< duration of the served requests per function code
+    std::array<std::atomic<std::uint64_t>, 256> exceptions;  //!< exception responses per function code
+
+    histogram_t lock_wait;  //!< time to acquire the semaphore
+    histogram_t lock_hold;  //!< time the semaphore is held
+
+    std::atomic<std::uint64_t> ignored_requests {};    //!< requests that were not served (listen only mode)
+    std::atomic<std::uint64_t> foreign_frames {};      //!< frames that are addressed to other slaves
+    std::atomic<std::uint64_t> checksum_errors {};     //!< frames with checksum errors
+    std::atomic<std::uint64_t> semaphore_timeouts {};  //!< failures to acquire the semaphore
+    std::atomic<std::uint64_t> received_bytes {};      //!< received bytes of the requests to this client
+    std::atomic<std::uint64_t> sent_bytes {};          //!< sent bytes of the responses
+
+    const double character_time;  //!< time to transmit one character in seconds
+
+public:
+    /*! \brief create metrics with all counters zero
+     *
+     * @param baud serial baud rate
+     * @param data_bits serial data bits
+     * @param parity serial parity ('N', 'E' or 'O')
+     * @param stop_bits serial stop bits
+     */
+    Metrics(int baud, int data_bits, char parity, int stop_bits);
+
+    //! record a served request
+    void observe_request(std::uint8_t function, std::uint64_t duration) noexcept {
+        requests[function].observe(duration);  // NOLINT
+    }
+
+    //! count an exception response
+    void count_exception(std::uint8_t function) noexcept {
+        exceptions[function].fetch_add(1, std::memory_order_relaxed);  // NOLINT
+    }
+
+    //! record the time to acquire the semaphore
+    void observe_lock_wait(std::uint64_t duration) noexcept { lock_wait.observe(duration); }
+
+    //! record the time the semaphore was held
+    void observe_lock_hold(std::uint64_t duration) noexcept { lock_hold.observe(duration); }
+
+    //! count a request that was not served (listen only mode)
+    void count_ignored_request() noexcept { ignored_requests.fetch_add(1, std::memory_order_relaxed); }
+
+    //! count a frame that is addressed to another slave
+    void count_foreign_frame() noexcept { foreign_frames.fetch_add(1, std::memory_order_relaxed); }
+
+    //! count a frame with checksum error
+    void count_checksum_error() noexcept { checksum_errors.fetch_add(1, std::memory_order_relaxed); }
+
+    //! count a failure to acquire the semaphore
+    void count_semaphore_timeout() noexcept { semaphore_timeouts.fetch_add(1, std::memory_order_relaxed); }
+
+    //! count the bytes of a received request
+    void count_received(int bytes) noexcept {
+        received_bytes.fetch_add(static_cast<std::uint64_t>(bytes), std::memory_order_relaxed);
+    }
+
+    //! count the bytes of a sent response
+    void count_sent(int bytes) noexcept {
+        if (bytes > 0) sent_bytes.fetch_add(static_cast<std::uint64_t>(bytes), std::memory_order_relaxed);
+    }
+
+    /*! \brief render all metrics
+     *
+     * @param mapping register tables (sizes)
+     * @return metrics in the Prometheus text format 0.0.4
+     */
+    [[nodiscard]] std::string render_prometheus(const modbus_mapping_t &mapping) const;
+
+    /*! \brief write all metrics to a textfile (e.g. for the node_exporter textfile collector)
+     *
+     * The file is replaced atomically (written to <path>.tmp and renamed).
+     *
+     * @param path path of the file
+     * @param mapping register tables (sizes)
+     * @param permissions file permissions
+     * @exception std::system_error failed to write the file
+     */
+    void write_file(const std::string &path, const modbus_mapping_t &mapping, mode_t permissions) const;
+};
+
+}  // namespace Modbus
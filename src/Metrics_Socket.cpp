@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Metrics_Socket.hpp"
+
+#include "Print_Time.hpp"
+#include "unix_socket.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <utility>
+
+namespace Modbus {
+
+Metrics_Socket::Metrics_Socket(std::string path, mode_t permissions, Event_Loop &event_loop, render_t render)
+    : path(std::move(path)), event_loop(event_loop), render(std::move(render)) {
+    listen_fd = create_unix_listener(this->path, SOCK_STREAM, permissions);
+    event_loop.add(listen_fd, [this] { accept_connections(); });
+}
+
+Metrics_Socket::~Metrics_Socket() {
+    event_loop.remove(listen_fd);
+    close(listen_fd);
+    unlink(path.c_str());
+}
+
+void Metrics_Socket::accept_connections() {
+    for (;;) {
+        const int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd == -1) {
+            if (errno != EAGAIN && errno != EINTR)
+                std::cerr << Print_Time::iso << " WARNING: metrics socket: accept failed: " << strerror(errno) << '\n';
+            return;
+        }
+
+        // the metrics fit in the socket buffer: a peer that does not read gets a truncated exposition
+        const std::string metrics = render();
+        const ssize_t     sent    = send(fd, metrics.data(), metrics.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (sent != static_cast<ssize_t>(metrics.size()))
+            std::cerr << Print_Time::iso << " WARNING: metrics socket: failed to send the metrics" << '\n';
+        close(fd);
+    }
+}
+
+}  // namespace Modbus
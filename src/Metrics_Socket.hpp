@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Event_Loop.hpp"
+
+#include <functional>
+#include <string>
+#include <sys/types.h>
+
+namespace Modbus {
+
+/*! \brief unix domain socket (stream) that serves the metrics
+ *
+ * The metrics are sent to each accepted connection and the connection is closed.
+ * Connections are served in the thread of the event loop (between two modbus requests).
+ *
+ * The socket serves the raw exposition, not HTTP: Prometheus can not scrape it directly.
+ *
+ * Example: socat - UNIX-CONNECT:/run/modbus.metrics
+ */
+class Metrics_Socket final {
+public:
+    //! function that renders the metrics
+    using render_t = std::function<std::string()>;
+
+private:
+    std::string path;        //!< path of the socket
+    int         listen_fd;   //!< listening socket
+    Event_Loop &event_loop;  //!< event loop that serves the connections
+    render_t    render;      //!< renders the metrics
+
+    //* accept pending connections and send the metrics
+    void accept_connections();
+
+public:
+    /*! \brief create the socket and add it to the event loop
+     *
+     * @param path path of the socket
+     * @param permissions file permissions of the socket
+     * @param event_loop event loop that serves the connections
+     * @param render function that renders the metrics
+     * @exception std::system_error failed to create the socket
+     */
+    Metrics_Socket(std::string path, mode_t permissions, Event_Loop &event_loop, render_t render);
+
+    ~Metrics_Socket();
+
+    Metrics_Socket(const Metrics_Socket &other)            = delete;
+    Metrics_Socket(Metrics_Socket &&other)                 = delete;
+    Metrics_Socket &operator=(const Metrics_Socket &other) = delete;
+    Metrics_Socket &operator=(Metrics_Socket &&other)      = delete;
+};
+
+}  // namespace Modbus
@@ -5,8 +5,13 @@
 
 #include "Modbus_RTU_Client.hpp"
 #include "Print_Time.hpp"
+#include "monotonic_time.hpp"
+#include "usdt.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <endian.h>
 #include <iostream>
 #include <stdexcept>
 
@@ -79,12 +84,19 @@ Client::Client(const std::string &device,
         throw std::runtime_error("Failed to set modbus rtu mode to RS232: " + error_msg);
     }
 
+    header_length = modbus_get_header_length(modbus);
+
     // get socket
     socket = modbus_get_socket(modbus);
     if (socket == -1) {
         const std::string error_msg = modbus_strerror(errno);
         throw std::runtime_error("Failed to get socket: " + error_msg);
     }
+
+    // requests are received without libmodbus (modbus_receive can not frame all served function codes)
+    receiver = std::make_unique<Frame_Receiver>(
+            socket, static_cast<std::uint8_t>(id), baud, data_bits, parity, stop_bits);
+    receiver->set_byte_timeout(get_byte_timeout());
 }
 
 Client::~Client() {
@@ -100,6 +112,7 @@ void Client::set_debug(bool debug) {
         const std::string error_msg = modbus_strerror(errno);
         throw std::runtime_error("failed to enable modbus debugging mode: " + error_msg);
     }
+    receiver->set_debug(debug);
 }
 
 void Client::enable_semaphore(const std::string &name, bool force) {
@@ -108,39 +121,409 @@ void Client::enable_semaphore(const std::string &name, bool force) {
     semaphore = std::make_unique<cxxsemaphore::Semaphore>(name, 1, force);
 }
 
+void Client::enable_write_journal(std::unique_ptr<shm::Write_Journal> journal) {
+    if (write_journal) throw std::logic_error("write journal already enabled");
+
+    write_journal = std::move(journal);
+}
+
+void Client::enable_write_timestamps(std::unique_ptr<shm::Write_Timestamps> timestamps) {
+    if (write_timestamps) throw std::logic_error("write timestamps already enabled");
+
+    write_timestamps = std::move(timestamps);
+}
+
+void Client::enable_write_staging(std::unique_ptr<shm::Write_Staging> staging) {
+    if (write_staging) throw std::logic_error("write staging already enabled");
+
+    write_staging = std::move(staging);
+}
+
+void Client::enable_read_doorbell(std::unique_ptr<shm::Read_Doorbell> doorbell) {
+    if (read_doorbell) throw std::logic_error("read doorbell already enabled");
+
+    read_doorbell = std::move(doorbell);
+}
+
+void Client::add_plugin(std::unique_ptr<Plugin> plugin) {
+    const auto function_codes = plugin->get_function_codes();
+    for (auto it = function_codes.begin(); it != function_codes.end(); ++it) {
+        if (function_handlers[*it].handler || std::find(function_codes.begin(), it, *it) != it)  // NOLINT
+            throw std::runtime_error("function code " + std::to_string(*it) + " of plugin '" + plugin->get_name() +
+                                     "' is already handled");
+    }
+
+    // the plugin accesses the register tables: the semaphore is acquired while the handler is called
+    // (with write staging, the plugin gets the tables of the master like the requests that are served by libmodbus)
+    for (const auto function : function_codes) {
+        set_function_handler(
+                function,
+                [this, handler = plugin.get()](const Request &request, uint8_t *response) {
+                    return handler->handle_request(
+                            request, write_staging ? &write_staging->get_view() : mapping, response);
+                },
+                true);
+    }
+
+    plugins.emplace_back(std::move(plugin));
+}
+
+void Client::enable_aliases(std::unique_ptr<Alias_Map> aliases) {
+    if (alias_map) throw std::logic_error("aliases already enabled");
+
+    alias_map = std::move(aliases);
+}
+
+void Client::enable_paged_windows(std::unique_ptr<Paged_Windows> windows) {
+    if (paged_windows) throw std::logic_error("paged windows already enabled");
+
+    paged_windows = std::move(windows);
+}
+
+void Client::enable_write_mask(std::unique_ptr<Write_Mask> mask) {
+    if (write_mask) throw std::logic_error("write mask already enabled");
+
+    write_mask = std::move(mask);
+}
+
+void Client::enable_recorder(std::unique_ptr<Recorder> rec) {
+    if (recorder) throw std::logic_error("recorder already enabled");
+
+    recorder = std::move(rec);
+}
+
+void Client::enable_device_identification(std::unique_ptr<Device_Identification> identification) {
+    if (device_identification) throw std::logic_error("device identification already enabled");
+
+    // precomputed responses, the register tables are not accessed
+    set_function_handler(Device_Identification::FUNCTION_CODE, [this](const Request &request, uint8_t *response) {
+        const auto pdu = device_identification->response(request);
+        if (pdu.empty()) return -1;
+        std::memcpy(response, pdu.data(), pdu.size());
+        return static_cast<int>(pdu.size());
+    });
+    device_identification = std::move(identification);
+}
+
+void Client::enable_diagnostics(std::unique_ptr<Diagnostics> diag) {
+    if (diagnostics) throw std::logic_error("diagnostics already enabled");
+
+    set_function_handler(Diagnostics::FUNCTION_CODE, [this](const Request &request, uint8_t *response) {
+        return diagnostics->reply(request, response);
+    });
+    diagnostics = std::move(diag);
+}
+
+void Client::enable_file_records(std::unique_ptr<File_Records> files) {
+    if (file_records) throw std::logic_error("file records already enabled");
+
+    // served from the mapped files, the register tables are not accessed
+    const auto handler = [this](const Request &request, uint8_t *response) {
+        return file_records->reply(request, response);
+    };
+    set_function_handler(File_Records::READ_FUNCTION_CODE, handler);
+    set_function_handler(File_Records::WRITE_FUNCTION_CODE, handler);
+    file_records = std::move(files);
+}
+
+void Client::enable_fifo_queues(std::unique_ptr<shm::Fifo_Queues> queues) {
+    if (fifo_queues) throw std::logic_error("fifo queues already enabled");
+
+    // drained from the rings, the register tables are not accessed
+    set_function_handler(shm::Fifo_Queues::FUNCTION_CODE, [this](const Request &request, uint8_t *response) {
+        return fifo_queues->reply(request, response);
+    });
+    fifo_queues = std::move(queues);
+}
+
+void Client::enable_metrics(std::unique_ptr<Metrics> client_metrics) {
+    if (metrics) throw std::logic_error("metrics already enabled");
+
+    metrics = std::move(client_metrics);
+}
+
+void Client::enable_bus_statistics(std::unique_ptr<shm::Bus_Statistics> statistics) {
+    if (bus_statistics) throw std::logic_error("bus statistics already enabled");
+
+    bus_statistics = std::move(statistics);
+}
+
+void Client::set_function_handler(uint8_t function, function_handler_t handler, bool locked) {
+    auto &entry = function_handlers[function];  // NOLINT
+    if (entry.handler) throw std::runtime_error("function code " + std::to_string(function) + " is already handled");
+
+    entry.handler = std::move(handler);
+    entry.locked  = locked;
+}
+
 bool Client::handle_request() {
     // receive modbus request
     std::array<uint8_t, MODBUS_RTU_MAX_ADU_LENGTH> query {};
-    int                                            rc = modbus_receive(modbus, query.data());
+    int                                            rc = receiver->receive(query.data());
+
+    const auto received = receiver->get_timestamp();
 
     if (rc > 0) {
-        // handle request
-        if (semaphore) {
-            if (!semaphore->wait(SEMAPHORE_MAX_TIME)) {
-                std::cerr << Print_Time::iso << " WARNING: Failed to acquire semaphore '" << semaphore->get_name()
-                          << "' within 100ms." << std::endl;  // NOLINT
-
-                semaphore_error_counter += SEMAPHORE_ERROR_INC;
-
-                if (semaphore_error_counter >= SEMAPHORE_ERROR_MAX)
-                    throw std::runtime_error("Repeatedly failed to acquire the semaphore");
-            } else {
-                semaphore_error_counter -= SEMAPHORE_ERROR_DEC;
-                if (semaphore_error_counter < 0) semaphore_error_counter = 0;
-            }
+        const Request request(query.data(), rc, header_length);
+        USDT(frame_received, request.slave, request.function, request.address, request.quantity, monotonic_ns());
+        if (metrics) metrics->count_received(rc);
+        if (bus_statistics) bus_statistics->request(request, received);
+
+        // diagnostics: count the request, ignore it in listen only mode
+        if (diagnostics && !diagnostics->receive(request)) {
+            if (metrics) metrics->count_ignored_request();
+            return false;
         }
-        modbus_reply(modbus, query.data(), rc, mapping);
-        if (semaphore && semaphore->is_acquired()) semaphore->post();
+
+        serve_request(request, query.data(), rc);
+        if (metrics) metrics->observe_request(request.function, monotonic_ns() - received);
+    } else if (rc == 0) {
+        // frame that is addressed to another slave
+        if (diagnostics) diagnostics->count_bus_message();
+        if (metrics) metrics->count_foreign_frame();
+        if (bus_statistics) bus_statistics->foreign(receiver->get_length(), received);
     } else if (rc == -1) {
         if (errno == ECONNRESET) return true;
+        USDT(error, errno, 0, monotonic_ns());
+        if (errno == EMBBADCRC) {
+            if (metrics) metrics->count_checksum_error();
+            if (bus_statistics) bus_statistics->error(receiver->get_length(), received);
+            if (diagnostics) diagnostics->count_bus_error();
+
+            // the frame is counted: continue with the next frame
+            if (metrics || bus_statistics || diagnostics) return false;
+        }
 
         const std::string error_msg = modbus_strerror(errno);
-        throw std::runtime_error("modbus_receive failed: " + error_msg + ' ' + std::to_string(errno));
+        throw std::runtime_error("failed to receive request: " + error_msg + ' ' + std::to_string(errno));
     }
 
     return false;
 }
 
+void Client::serve_request(const Request &request, const uint8_t *query, int length) {
+    // function codes with a registered handler
+    const auto &function_handler = function_handlers[request.function];  // NOLINT
+    if (function_handler.handler) {
+        std::array<uint8_t, MODBUS_MAX_PDU_LENGTH> response {};
+        if (function_handler.locked) {
+            acquire_semaphore();
+            USDT(lock_acquired, request.function, request.address, request.quantity, monotonic_ns());
+        }
+        const int response_length = function_handler.handler(request, response.data());
+        if (function_handler.locked) {
+            release_semaphore();
+            USDT(lock_released, request.function, request.address, request.quantity, monotonic_ns());
+        }
+
+        if (response_length >= 0) {
+            if (response_length > 0) send_response(request, response.data(), response_length);
+            return;
+        }
+    }
+
+    // resolve paged windows and aliases: the request is served from a view of the mapping
+    modbus_mapping_t  view {};
+    modbus_mapping_t *serving  = write_staging ? &write_staging->get_view() : mapping;
+    Request           accessed = request;
+    const bool        paged    = paged_windows && paged_windows->resolve(request, view);
+    if (paged || (alias_map && alias_map->resolve(request, view, accessed))) serving = &view;
+
+    // reject valid writes to protected addresses before the mapping is accessed
+    if (write_mask && accessed.write_table() != NO_TABLE && request.validate(*serving) == 0 &&
+        !write_mask->allows(accessed)) {
+        send_exception(request, MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS);
+        return;
+    }
+
+    // let the producers refresh the requested inputs (without holding the semaphore)
+    if (read_doorbell) read_doorbell->ring(accessed);
+
+    // handle request
+    acquire_semaphore();
+    USDT(lock_acquired, request.function, request.address, request.quantity, monotonic_ns());
+    if (!paged) before_reply(request, accessed, *serving);
+    if (!wire_order || !reply_wire_order(request, *serving)) {
+        if ((diagnostics || metrics) && !request.is_broadcast() && request.validate(*serving)) {
+            if (diagnostics) diagnostics->count_exception();
+            if (metrics) metrics->count_exception(request.function);
+        }
+        const auto sending = bus_statistics ? monotonic_ns() : 0;
+        const int  sent    = modbus_reply(modbus, query, length, serving);
+        if (!request.is_broadcast()) {
+            USDT(reply_sent, request.slave, request.function, sent, monotonic_ns());
+            if (metrics) metrics->count_sent(sent);
+            if (bus_statistics) bus_statistics->response(sent, sending);
+        }
+    }
+    if (!paged) after_reply(request, accessed, *serving);
+    release_semaphore();
+    USDT(lock_released, request.function, request.address, request.quantity, monotonic_ns());
+}
+
+void Client::acquire_semaphore() {
+    if (!semaphore) return;
+
+    const auto start = metrics ? monotonic_ns() : 0;
+    if (!semaphore->wait(SEMAPHORE_MAX_TIME)) {
+        std::cerr << Print_Time::iso << " WARNING: Failed to acquire semaphore '" << semaphore->get_name()
+                  << "' within 100ms." << std::endl;  // NOLINT
+        USDT(error, ETIMEDOUT, 0, monotonic_ns());
+        if (metrics) metrics->count_semaphore_timeout();
+
+        semaphore_error_counter += SEMAPHORE_ERROR_INC;
+
+        if (semaphore_error_counter >= SEMAPHORE_ERROR_MAX)
+            throw std::runtime_error("Repeatedly failed to acquire the semaphore");
+    } else {
+        semaphore_error_counter -= SEMAPHORE_ERROR_DEC;
+        if (semaphore_error_counter < 0) semaphore_error_counter = 0;
+
+        if (metrics) {
+            lock_acquired_at = monotonic_ns();
+            metrics->observe_lock_wait(lock_acquired_at - start);
+        }
+    }
+}
+
+void Client::release_semaphore() {
+    if (!semaphore || !semaphore->is_acquired()) return;
+
+    semaphore->post();
+    if (metrics) metrics->observe_lock_hold(monotonic_ns() - lock_acquired_at);
+}
+
+bool Client::run_locked(const std::function<void()> &function) {
+    acquire_semaphore();
+    if (semaphore && !semaphore->is_acquired()) return false;
+
+    try {
+        function();
+    } catch (...) {
+        release_semaphore();
+        throw;
+    }
+    release_semaphore();
+    return true;
+}
+
+void Client::before_reply(const Request &request, const Request &accessed, const modbus_mapping_t &serving) {
+    if (plugins.empty() || request.read_table() == NO_TABLE || request.validate(serving)) return;
+
+    for (const auto &plugin : plugins)
+        plugin->before_read(accessed);
+}
+
+bool Client::reply_wire_order(const Request &request, const modbus_mapping_t &serving) {
+    uint16_t *table = nullptr;
+    int       start = 0;
+    switch (request.function) {
+        case MODBUS_FC_READ_INPUT_REGISTERS:
+            table = serving.tab_input_registers;
+            start = serving.start_input_registers;
+            break;
+        case MODBUS_FC_READ_HOLDING_REGISTERS:
+        case MODBUS_FC_WRITE_SINGLE_REGISTER:
+        case MODBUS_FC_WRITE_MULTIPLE_REGISTERS:
+        case MODBUS_FC_MASK_WRITE_REGISTER:
+        case MODBUS_FC_WRITE_AND_READ_REGISTERS:
+            table = serving.tab_registers;
+            start = serving.start_registers;
+            break;
+        default: return false;
+    }
+
+    const auto exception_code = request.validate(serving);
+    if (exception_code) {
+        send_exception(request, exception_code);
+        return true;
+    }
+
+    const uint8_t *pdu = request.get_pdu();
+    switch (request.function) {
+        case MODBUS_FC_WRITE_SINGLE_REGISTER:
+            std::memcpy(table + (request.write_address - start), pdu + 3, sizeof(uint16_t));  // NOLINT
+            send_response(request, pdu, request.get_pdu_length());
+            break;
+        case MODBUS_FC_MASK_WRITE_REGISTER: {
+            uint16_t  &reg      = table[request.write_address - start];  // NOLINT
+            const auto and_mask = static_cast<uint16_t>((pdu[3] << 8) | pdu[4]);  // NOLINT
+            const auto or_mask  = static_cast<uint16_t>((pdu[5] << 8) | pdu[6]);  // NOLINT
+            const auto value    = static_cast<uint16_t>((be16toh(reg) & and_mask) | (or_mask & ~and_mask));
+            reg                 = htobe16(value);
+            send_response(request, pdu, request.get_pdu_length());
+            break;
+        }
+        case MODBUS_FC_WRITE_MULTIPLE_REGISTERS: {
+            static constexpr int FC16_HEADER_LENGTH   = 6;
+            static constexpr int FC16_RESPONSE_LENGTH = 5;
+            std::memcpy(table + (request.write_address - start),  // NOLINT
+                        pdu + FC16_HEADER_LENGTH,                  // NOLINT
+                        request.write_quantity * sizeof(uint16_t));
+            send_response(request, pdu, FC16_RESPONSE_LENGTH);
+            break;
+        }
+        case MODBUS_FC_WRITE_AND_READ_REGISTERS: {
+            static constexpr int FC23_HEADER_LENGTH = 10;
+            std::memcpy(table + (request.write_address - start),  // NOLINT
+                        pdu + FC23_HEADER_LENGTH,                  // NOLINT
+                        request.write_quantity * sizeof(uint16_t));
+            reply_wire_order_read(request, table + (request.address - start));  // NOLINT
+            break;
+        }
+        default: reply_wire_order_read(request, table + (request.address - start));  // NOLINT
+    }
+
+    return true;
+}
+
+void Client::reply_wire_order_read(const Request &request, const uint16_t *registers) {
+    const auto byte_count = request.quantity * sizeof(uint16_t);
+
+    std::array<uint8_t, MODBUS_MAX_PDU_LENGTH> response {};
+    response[0] = request.function;
+    response[1] = static_cast<uint8_t>(byte_count);
+    std::memcpy(response.data() + 2, registers, byte_count);
+    send_response(request, response.data(), static_cast<int>(byte_count + 2));
+}
+
+void Client::send_response(const Request &request, const uint8_t *response, int length) {
+    if (request.is_broadcast()) return;
+    if (response[0] & 0x80U) {  // NOLINT
+        if (diagnostics) diagnostics->count_exception();
+        if (metrics) metrics->count_exception(request.function);
+    }
+
+    std::array<uint8_t, MODBUS_MAX_PDU_LENGTH + 1> frame {};
+    frame[0] = request.slave;
+    std::memcpy(frame.data() + 1, response, static_cast<std::size_t>(length));
+    const auto sending = bus_statistics ? monotonic_ns() : 0;
+    const int  sent    = modbus_send_raw_request(modbus, frame.data(), length + 1);
+    USDT(reply_sent, request.slave, response[0], sent, monotonic_ns());
+    if (metrics) metrics->count_sent(sent);
+    if (bus_statistics) bus_statistics->response(sent, sending);
+}
+
+void Client::send_exception(const Request &request, int exception_code) {
+    const std::array<uint8_t, 2> response {static_cast<uint8_t>(request.function | 0x80U),  // NOLINT
+                                           static_cast<uint8_t>(exception_code)};
+    send_response(request, response.data(), static_cast<int>(response.size()));
+}
+
+void Client::after_reply(const Request &request, const Request &accessed, const modbus_mapping_t &serving) {
+    if (request.write_table() == NO_TABLE || !request.write_applied(serving)) return;
+
+    if (write_staging) write_staging->stage(accessed);
+
+    const auto timestamp = monotonic_ns();
+    if (write_journal) write_journal->append(accessed, write_staging ? write_staging->get_view() : *mapping, timestamp);
+    if (write_timestamps) write_timestamps->update(accessed, timestamp);
+    if (recorder) recorder->on_write(accessed);
+
+    for (const auto &plugin : plugins)
+        plugin->after_write(accessed);
+}
+
 struct timeout_t {
     uint32_t sec;
     uint32_t usec;
@@ -165,6 +548,9 @@ void Client::set_byte_timeout(double timeout) {
         const std::string error_msg = modbus_strerror(errno);
         throw std::runtime_error("modbus_receive failed: " + error_msg + ' ' + std::to_string(errno));
     }
+
+    // disabled byte timeout: the complete request must be received within the response timeout
+    receiver->set_byte_timeout(timeout > 0 ? timeout : get_response_timeout());
 }
 
 void Client::set_response_timeout(double timeout) {
@@ -175,6 +561,8 @@ void Client::set_response_timeout(double timeout) {
         const std::string error_msg = modbus_strerror(errno);
         throw std::runtime_error("modbus_receive failed: " + error_msg + ' ' + std::to_string(errno));
     }
+
+    if (get_byte_timeout() <= 0) receiver->set_byte_timeout(timeout);
 }
 
 double Client::get_byte_timeout() {
@@ -5,26 +5,96 @@
 
 #pragma once
 
+#include "Alias_Map.hpp"
+#include "Bus_Statistics.hpp"
+#include "Device_Identification.hpp"
+#include "Diagnostics.hpp"
+#include "Fifo_Queues.hpp"
+#include "File_Records.hpp"
+#include "Frame_Receiver.hpp"
+#include "Metrics.hpp"
+#include "Paged_Windows.hpp"
+#include "Plugin.hpp"
+#include "Read_Doorbell.hpp"
+#include "Recorder.hpp"
+#include "Write_Journal.hpp"
+#include "Write_Mask.hpp"
+#include "Write_Staging.hpp"
+#include "Write_Timestamps.hpp"
+
+#include <array>
 #include <cxxsemaphore.hpp>
+#include <functional>
 #include <memory>
 #include <modbus/modbus.h>
 #include <string>
+#include <vector>
 
 namespace Modbus {
 namespace RTU {
 
 //! Modbus RTU client
 class Client {
+public:
+    /*! \brief handler of a function code
+     *
+     * @param request received request
+     * @param response output: response pdu (MODBUS_MAX_PDU_LENGTH bytes)
+     * @return length of the response pdu, 0 if no response is sent or -1 if the request is served by libmodbus
+     */
+    using function_handler_t = std::function<int(const Request &request, uint8_t *response)>;
+
 private:
-    modbus_t         *modbus;          //!< modbus object (see libmodbus library)
-    modbus_mapping_t *mapping;         //!< modbus data object (see libmodbus library)
-    bool              delete_mapping;  //!< indicates whether the mapping object was created by this instance
-    int               socket = -1;     //!< internal modbus communication socket
+    //! registered handler of a function code
+    struct function_handler_entry_t {
+        function_handler_t handler;         //!< handler (empty: the function code is served by libmodbus)
+        bool               locked = false;  //!< the semaphore is acquired while the handler is called
+    };
+
+    modbus_t         *modbus;             //!< modbus object (see libmodbus library)
+    modbus_mapping_t *mapping;            //!< modbus data object (see libmodbus library)
+    bool              delete_mapping;     //!< indicates whether the mapping object was created by this instance
+    int               socket = -1;        //!< internal modbus communication socket
+    int               header_length = 0;  //!< length of the modbus frame header
+
+    std::unique_ptr<Frame_Receiver> receiver;  //!< receives the frames on the serial line
 
     std::unique_ptr<cxxsemaphore::Semaphore> semaphore;
 
     long semaphore_error_counter = 0;
 
+    std::unique_ptr<shm::Write_Journal>    write_journal;     //!< journal of all applied write requests
+    std::unique_ptr<shm::Write_Timestamps> write_timestamps;  //!< time of the last write access per block
+    std::unique_ptr<shm::Read_Doorbell>    read_doorbell;     //!< notifies producers before inputs are read
+    std::unique_ptr<shm::Write_Staging>    write_staging;     //!< stages writes until they are committed
+
+    std::vector<std::unique_ptr<Plugin>> plugins;  //!< data provider plugins
+
+    bool wire_order = false;  //!< AO/AI registers are stored in modbus byte order (big endian)
+
+    std::unique_ptr<Alias_Map> alias_map;  //!< address ranges that are served from other ranges
+
+    std::unique_ptr<Paged_Windows> paged_windows;  //!< address windows that show a page of a larger region
+
+    std::unique_ptr<Write_Mask> write_mask;  //!< write protected addresses
+
+    std::unique_ptr<Recorder> recorder;  //!< time-series recorder for register changes
+
+    std::unique_ptr<Device_Identification> device_identification;  //!< read device identification responses
+
+    std::unique_ptr<Diagnostics> diagnostics;  //!< bus counters and listen only mode
+
+    std::unique_ptr<File_Records> file_records;  //!< files that are accessed by file record requests
+
+    std::unique_ptr<shm::Fifo_Queues> fifo_queues;  //!< queues that are read by read fifo queue requests
+
+    std::unique_ptr<Metrics> metrics;               //!< pre-aggregated metrics
+    std::uint64_t            lock_acquired_at = 0;  //!< time the semaphore was acquired (only with metrics)
+
+    std::unique_ptr<shm::Bus_Statistics> bus_statistics;  //!< bus utilization and polling cycle statistics
+
+    std::array<function_handler_entry_t, 256> function_handlers;  //!< handlers per function code
+
 public:
     /*! \brief create modbus client (TCP server)
      *
@@ -67,6 +137,155 @@ public:
      */
     void enable_semaphore(const std::string &name, bool force = false);
 
+    /**
+     * @brief record all applied write requests in a write journal
+     *
+     * @param journal write journal
+     */
+    void enable_write_journal(std::unique_ptr<shm::Write_Journal> journal);
+
+    /**
+     * @brief store the time of the last applied write request per register block
+     *
+     * @param timestamps write timestamps
+     */
+    void enable_write_timestamps(std::unique_ptr<shm::Write_Timestamps> timestamps);
+
+    /**
+     * @brief notify producers before DI/AI registers are read
+     *
+     * @param doorbell read doorbell
+     */
+    void enable_read_doorbell(std::unique_ptr<shm::Read_Doorbell> doorbell);
+
+    /**
+     * @brief apply write requests to shadow tables that are committed to the register tables on a trigger
+     *
+     * The modbus master is served from the shadow tables.
+     *
+     * @param staging write staging
+     */
+    void enable_write_staging(std::unique_ptr<shm::Write_Staging> staging);
+
+    /**
+     * @brief add a data provider plugin
+     *
+     * @details plugins are called in the order they are added.
+     * The function codes that are handled by the plugin are registered as function handlers.
+     *
+     * @param plugin plugin
+     * @exception std::runtime_error a function code of the plugin is already handled
+     */
+    void add_plugin(std::unique_ptr<Plugin> plugin);
+
+    /**
+     * @brief store the AO/AI registers in modbus byte order (big endian)
+     *
+     * @details Register read and write requests are served by copying the data between the request/response and the
+     * register tables without byte order conversion.
+     *
+     * @param enable true: registers are stored in modbus byte order, false: registers are stored in host byte order
+     */
+    void set_wire_order(bool enable) noexcept { wire_order = enable; }
+
+    /**
+     * @brief serve alias address ranges from other ranges of the register tables
+     *
+     * @param aliases alias definitions (must refer to the mapping of this client)
+     */
+    void enable_aliases(std::unique_ptr<Alias_Map> aliases);
+
+    /**
+     * @brief serve address windows from pages of larger shared memory regions
+     *
+     * Paged windows take precedence over aliases.
+     * Writes to paged windows are not passed to the write journal, write timestamps, recorder, write staging or
+     * plugins.
+     *
+     * @param windows paged windows
+     */
+    void enable_paged_windows(std::unique_ptr<Paged_Windows> windows);
+
+    /**
+     * @brief reject write requests to protected addresses with an illegal data address exception
+     *
+     * @param mask write protected addresses
+     */
+    void enable_write_mask(std::unique_ptr<Write_Mask> mask);
+
+    /**
+     * @brief record the changes of all applied write requests
+     *
+     * @param rec recorder
+     */
+    void enable_recorder(std::unique_ptr<Recorder> rec);
+
+    /**
+     * @brief answer Read Device Identification requests (FC 0x2B, MEI type 0x0E)
+     *
+     * @details The requests are answered with the precomputed responses without accessing the register tables.
+     *
+     * @param identification device identification
+     */
+    void enable_device_identification(std::unique_ptr<Device_Identification> identification);
+
+    /**
+     * @brief count the frames on the bus and answer Diagnostics requests (FC 0x08)
+     *
+     * @details Frames with checksum errors are counted and ignored.
+     *
+     * @param diag diagnostics
+     */
+    void enable_diagnostics(std::unique_ptr<Diagnostics> diag);
+
+    /**
+     * @brief serve Read/Write File Record requests (FC 0x14, FC 0x15) from memory mapped files
+     *
+     * @details The records are accessed without acquiring the semaphore.
+     *
+     * @param files file records
+     */
+    void enable_file_records(std::unique_ptr<File_Records> files);
+
+    /**
+     * @brief serve Read FIFO Queue requests (FC 0x18) from rings in shared memory
+     *
+     * @details The rings are read without acquiring the semaphore.
+     *
+     * @param queues fifo queues
+     */
+    void enable_fifo_queues(std::unique_ptr<shm::Fifo_Queues> queues);
+
+    /**
+     * @brief enable metrics
+     *
+     * @param client_metrics metrics that are updated by the client
+     * @exception std::logic_error metrics already enabled
+     */
+    void enable_metrics(std::unique_ptr<Metrics> client_metrics);
+
+    /**
+     * @brief enable bus statistics
+     *
+     * @param statistics statistics that are updated with every frame on the bus
+     * @exception std::logic_error bus statistics already enabled
+     */
+    void enable_bus_statistics(std::unique_ptr<shm::Bus_Statistics> statistics);
+
+    /**
+     * @brief register a handler of a function code
+     *
+     * @details Requests with the function code are passed to the handler instead of libmodbus
+     * (after the diagnostics counters are updated, not in listen only mode).
+     *
+     * @param function function code
+     * @param handler handler
+     * @param locked acquire the semaphore while the handler is called (required if the handler accesses the register
+     *               tables)
+     * @exception std::runtime_error the function code is already handled
+     */
+    void set_function_handler(uint8_t function, function_handler_t handler, bool locked = false);
+
     /*! \brief wait for request from Modbus Server and generate reply
      *
      * @return true: connection closed
@@ -103,11 +322,89 @@ public:
      */
     double get_response_timeout();
 
+    /*! \brief execute a function while the semaphore (if used) is acquired
+     *
+     * @details Must be called from the thread that handles the requests (between two requests).
+     *
+     * @param function function to execute
+     * @return false if the semaphore could not be acquired (the function is not executed)
+     */
+    [[nodiscard]] bool run_locked(const std::function<void()> &function);
+
     /*! \brief get the modbus socket
      *
      * @return socket of the modbus connection
      */
     [[nodiscard]] int get_socket() const noexcept { return socket; }
+
+private:
+    /*! \brief acquire the semaphore (if used)
+     *
+     * @details The function waits at most 100ms. If the semaphore can not be acquired, the caller continues without
+     * the semaphore. Repeated failures raise an exception.
+     *
+     * @exception std::runtime_error repeatedly failed to acquire the semaphore
+     */
+    void acquire_semaphore();
+
+    //! release the semaphore (if acquired)
+    void release_semaphore();
+
+    /*! \brief serve a request that is addressed to this client
+     *
+     * @param request received request
+     * @param query received frame
+     * @param length length of the received frame
+     */
+    void serve_request(const Request &request, const uint8_t *query, int length);
+
+    /*! \brief called before a request is answered (semaphore is already acquired)
+     *
+     * The plugins are only called for valid read requests (all requested registers are within the table).
+     *
+     * @param request received request
+     * @param accessed received request with the addresses that are actually accessed
+     * @param serving mapping the request is served from
+     */
+    void before_reply(const Request &request, const Request &accessed, const modbus_mapping_t &serving);
+
+    /*! \brief serve register requests if the registers are stored in modbus byte order
+     *
+     * @param request received request
+     * @param serving mapping that is used to serve the request
+     * @return true if the request was served, false if the request needs to be served by modbus_reply
+     */
+    bool reply_wire_order(const Request &request, const modbus_mapping_t &serving);
+
+    /*! \brief send the response to a register read request (registers are stored in modbus byte order)
+     *
+     * @param request read request (FC3, FC4 or FC23)
+     * @param registers first read register
+     */
+    void reply_wire_order_read(const Request &request, const uint16_t *registers);
+
+    /*! \brief send a response (no response is sent for broadcast requests)
+     *
+     * @param request request that is answered
+     * @param response response pdu (starting with the function code)
+     * @param length length of the response pdu
+     */
+    void send_response(const Request &request, const uint8_t *response, int length);
+
+    /*! \brief send an exception response (no response is sent for broadcast requests)
+     *
+     * @param request request that is answered
+     * @param exception_code modbus exception code
+     */
+    void send_exception(const Request &request, int exception_code);
+
+    /*! \brief called after a request was answered (semaphore is still acquired)
+     *
+     * @param request served request
+     * @param accessed served request with the addresses that are actually accessed
+     * @param serving mapping that was used to serve the request
+     */
+    void after_reply(const Request &request, const Request &accessed, const modbus_mapping_t &serving);
 };
 
 }  // namespace RTU
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Modbus_Request.hpp"
+
+namespace Modbus {
+
+//* length of the crc at the end of a rtu frame
+static constexpr int CHECKSUM_LENGTH = 2;
+
+//* value of a single coil write that sets the coil
+static constexpr std::uint16_t COIL_ON = 0xFF00;
+
+static inline std::uint16_t get_u16(const uint8_t *data) {
+    return static_cast<std::uint16_t>((data[0] << 8) | data[1]);  // NOLINT
+}
+
+//* get the table that is read by a function code
+static table_t get_read_table(std::uint8_t function) noexcept {
+    switch (function) {
+        case MODBUS_FC_READ_COILS: return DO;
+        case MODBUS_FC_READ_DISCRETE_INPUTS: return DI;
+        case MODBUS_FC_READ_HOLDING_REGISTERS:
+        case MODBUS_FC_WRITE_AND_READ_REGISTERS: return AO;
+        case MODBUS_FC_READ_INPUT_REGISTERS: return AI;
+        default: return NO_TABLE;
+    }
+}
+
+//* get the table that is written by a function code
+static table_t get_write_table(std::uint8_t function) noexcept {
+    switch (function) {
+        case MODBUS_FC_WRITE_SINGLE_COIL:
+        case MODBUS_FC_WRITE_MULTIPLE_COILS: return DO;
+        case MODBUS_FC_WRITE_SINGLE_REGISTER:
+        case MODBUS_FC_WRITE_MULTIPLE_REGISTERS:
+        case MODBUS_FC_MASK_WRITE_REGISTER:
+        case MODBUS_FC_WRITE_AND_READ_REGISTERS: return AO;
+        default: return NO_TABLE;
+    }
+}
+
+Request::Request(const uint8_t *adu, int length, int header_length)
+    : adu(adu), adu_length(length), header_length(header_length), read_tab(NO_TABLE), write_tab(NO_TABLE) {
+    if (get_pdu_length() < 1) return;
+
+    const uint8_t *pdu = get_pdu();
+    slave              = adu[header_length - 1];
+    function           = pdu[0];
+    read_tab           = get_read_table(function);
+    write_tab          = get_write_table(function);
+
+    // all supported requests contain at least a function code, an address and a quantity or value
+    static constexpr int MIN_PDU_LENGTH = 5;
+    if (get_pdu_length() < MIN_PDU_LENGTH) return;
+
+    address  = get_u16(pdu + 1);
+    quantity = get_u16(pdu + 3);  // NOLINT
+
+    switch (function) {
+        case MODBUS_FC_WRITE_SINGLE_COIL:
+        case MODBUS_FC_WRITE_SINGLE_REGISTER:
+        case MODBUS_FC_MASK_WRITE_REGISTER:
+            quantity       = 1;
+            write_address  = address;
+            write_quantity = 1;
+            break;
+        case MODBUS_FC_WRITE_MULTIPLE_COILS:
+        case MODBUS_FC_WRITE_MULTIPLE_REGISTERS:
+            write_address  = address;
+            write_quantity = quantity;
+            break;
+        case MODBUS_FC_WRITE_AND_READ_REGISTERS: {
+            static constexpr int FC23_MIN_PDU_LENGTH = 9;
+            if (get_pdu_length() < FC23_MIN_PDU_LENGTH) break;
+            write_address  = get_u16(pdu + 5);  // NOLINT
+            write_quantity = get_u16(pdu + 7);  // NOLINT
+            break;
+        }
+        default: break;
+    }
+}
+
+int Request::get_pdu_length() const noexcept {
+    return adu_length - header_length - CHECKSUM_LENGTH;
+}
+
+Request Request::translated(table_t table, std::uint16_t read_address, std::uint16_t written_address) const {
+    Request request(*this);
+    if (request.read_tab != NO_TABLE) request.read_tab = table;
+    request.address       = read_address;
+    request.write_address = written_address;
+    return request;
+}
+
+/*! \brief check an address range
+ *
+ * @param address first address of the request
+ * @param quantity number of registers
+ * @param start first address of the table
+ * @param count number of registers in the table
+ * @return true if the address range is inside the table
+ */
+static inline bool in_range(int address, int quantity, int start, int count) {
+    const int first = address - start;
+    return first >= 0 && first + quantity <= count;
+}
+
+int Request::validate(const modbus_mapping_t &mapping) const noexcept {
+    const uint8_t *pdu    = get_pdu();
+    const int      length = get_pdu_length();
+
+    if (length < 1) return MODBUS_EXCEPTION_ILLEGAL_FUNCTION;
+
+    // single register/coil and report slave id requests have a fixed length that is checked by the frame receiver
+    static constexpr int MIN_PDU_LENGTH = 5;
+    const bool           has_header     = length >= MIN_PDU_LENGTH;
+
+    switch (function) {
+        case MODBUS_FC_READ_COILS:
+        case MODBUS_FC_READ_DISCRETE_INPUTS: {
+            if (!has_header || quantity < 1 || quantity > MODBUS_MAX_READ_BITS)
+                return MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE;
+            const bool coils = function == MODBUS_FC_READ_COILS;
+            if (!in_range(address,
+                          quantity,
+                          coils ? mapping.start_bits : mapping.start_input_bits,
+                          coils ? mapping.nb_bits : mapping.nb_input_bits))
+                return MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS;
+            return 0;
+        }
+        case MODBUS_FC_READ_HOLDING_REGISTERS:
+        case MODBUS_FC_READ_INPUT_REGISTERS: {
+            if (!has_header || quantity < 1 || quantity > MODBUS_MAX_READ_REGISTERS)
+                return MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE;
+            const bool holding = function == MODBUS_FC_READ_HOLDING_REGISTERS;
+            if (!in_range(address,
+                          quantity,
+                          holding ? mapping.start_registers : mapping.start_input_registers,
+                          holding ? mapping.nb_registers : mapping.nb_input_registers))
+                return MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS;
+            return 0;
+        }
+        case MODBUS_FC_WRITE_SINGLE_COIL: {
+            if (!has_header) return MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE;
+            if (!in_range(address, 1, mapping.start_bits, mapping.nb_bits))
+                return MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS;
+            const auto value = get_u16(pdu + 3);  // NOLINT
+            if (value != COIL_ON && value != 0) return MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE;
+            return 0;
+        }
+        case MODBUS_FC_WRITE_SINGLE_REGISTER:
+            if (!has_header) return MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE;
+            if (!in_range(address, 1, mapping.start_registers, mapping.nb_registers))
+                return MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS;
+            return 0;
+        case MODBUS_FC_MASK_WRITE_REGISTER: {
+            static constexpr int FC22_PDU_LENGTH = 7;
+            if (length < FC22_PDU_LENGTH) return MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE;
+            if (!in_range(address, 1, mapping.start_registers, mapping.nb_registers))
+                return MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS;
+            return 0;
+        }
+        case MODBUS_FC_WRITE_MULTIPLE_COILS: {
+            static constexpr int FC15_HEADER_LENGTH = 6;
+            if (length < FC15_HEADER_LENGTH) return MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE;
+            const int byte_count = pdu[5];  // NOLINT
+            if (write_quantity < 1 || write_quantity > MODBUS_MAX_WRITE_BITS || byte_count * 8 < write_quantity ||
+                length < FC15_HEADER_LENGTH + byte_count)
+                return MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE;
+            if (!in_range(write_address, write_quantity, mapping.start_bits, mapping.nb_bits))
+                return MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS;
+            return 0;
+        }
+        case MODBUS_FC_WRITE_MULTIPLE_REGISTERS: {
+            static constexpr int FC16_HEADER_LENGTH = 6;
+            if (length < FC16_HEADER_LENGTH) return MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE;
+            const int byte_count = pdu[5];  // NOLINT
+            if (write_quantity < 1 || write_quantity > MODBUS_MAX_WRITE_REGISTERS ||
+                byte_count != write_quantity * 2 || length < FC16_HEADER_LENGTH + byte_count)
+                return MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE;
+            if (!in_range(write_address, write_quantity, mapping.start_registers, mapping.nb_registers))
+                return MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS;
+            return 0;
+        }
+        case MODBUS_FC_WRITE_AND_READ_REGISTERS: {
+            static constexpr int FC23_HEADER_LENGTH = 10;
+            if (length < FC23_HEADER_LENGTH) return MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE;
+            const int byte_count = pdu[9];  // NOLINT
+            if (quantity < 1 || quantity > MODBUS_MAX_WR_READ_REGISTERS || write_quantity < 1 ||
+                write_quantity > MODBUS_MAX_WR_WRITE_REGISTERS || byte_count != write_quantity * 2 ||
+                length < FC23_HEADER_LENGTH + byte_count)
+                return MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE;
+            if (!in_range(address, quantity, mapping.start_registers, mapping.nb_registers) ||
+                !in_range(write_address, write_quantity, mapping.start_registers, mapping.nb_registers))
+                return MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS;
+            return 0;
+        }
+        case MODBUS_FC_REPORT_SLAVE_ID: return 0;
+        default: return MODBUS_EXCEPTION_ILLEGAL_FUNCTION;
+    }
+}
+
+bool Request::write_applied(const modbus_mapping_t &mapping) const noexcept {
+    return write_table() != NO_TABLE && validate(mapping) == 0;
+}
+
+}  // namespace Modbus
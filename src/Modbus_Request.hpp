@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <modbus/modbus.h>
+
+namespace Modbus {
+
+//! modbus register tables
+enum table_t : std::uint8_t { DO, DI, AO, AI, TABLE_COUNT, NO_TABLE = TABLE_COUNT };
+
+/*! \brief decoded header of a received modbus request
+ *
+ * Only the fields that are relevant to decide which registers are accessed are decoded.
+ * The request data is not copied, the object is only valid as long as the receive buffer is valid.
+ */
+class Request {
+private:
+    const uint8_t *adu;            //!< received frame (starting with the slave id)
+    int            adu_length;     //!< length of the received frame (including checksum)
+    int            header_length;  //!< length of the frame header (slave id)
+    table_t        read_tab;       //!< table that is read by the request
+    table_t        write_tab;      //!< table that is written by the request
+
+public:
+    std::uint8_t  slave          = 0;  //!< addressed slave id
+    std::uint8_t  function       = 0;  //!< function code
+    std::uint16_t address        = 0;  //!< first address (read address for FC23)
+    std::uint16_t quantity       = 0;  //!< number of registers (read quantity for FC23)
+    std::uint16_t write_address  = 0;  //!< first written address (FC5, FC6, FC15, FC16, FC22, FC23)
+    std::uint16_t write_quantity = 0;  //!< number of written registers (FC5, FC6, FC15, FC16, FC22, FC23)
+
+    /*! \brief decode a request
+     *
+     * @param adu received frame (as returned by RTU::Frame_Receiver::receive)
+     * @param length length of the received frame
+     * @param header_length header length of the modbus backend (see modbus_get_header_length)
+     */
+    Request(const uint8_t *adu, int length, int header_length);
+
+    /*! \brief get the protocol data unit (starting with the function code)
+     *
+     * @return pointer to the pdu
+     */
+    [[nodiscard]] const uint8_t *get_pdu() const noexcept { return adu + header_length; }
+
+    /*! \brief get the length of the protocol data unit (without checksum)
+     *
+     * @return pdu length in bytes
+     */
+    [[nodiscard]] int get_pdu_length() const noexcept;
+
+    /*! \brief get the complete frame
+     *
+     * @return pointer to the received frame
+     */
+    [[nodiscard]] const uint8_t *get_adu() const noexcept { return adu; }
+
+    /*! \brief get the length of the complete frame
+     *
+     * @return frame length in bytes
+     */
+    [[nodiscard]] int get_adu_length() const noexcept { return adu_length; }
+
+    /*! \brief check if the request is a broadcast request
+     *
+     * @return true if the request was sent as broadcast
+     */
+    [[nodiscard]] bool is_broadcast() const noexcept { return slave == MODBUS_BROADCAST_ADDRESS; }
+
+    /*! \brief get the table that is read by the request
+     *
+     * @return register table or NO_TABLE if the request reads no registers
+     */
+    [[nodiscard]] table_t read_table() const noexcept { return read_tab; }
+
+    /*! \brief get the table that is written by the request
+     *
+     * @return register table or NO_TABLE if the request writes no registers
+     */
+    [[nodiscard]] table_t write_table() const noexcept { return write_tab; }
+
+    /*! \brief get a copy of the request that accesses other addresses
+     *
+     * @details Used to translate the addresses of a request that is served from another part of the register
+     * tables (e.g. alias ranges) into the addresses that are actually accessed.
+     * The request data (frame) is not modified.
+     *
+     * @param table table that is actually read
+     * @param read_address first address that is actually read
+     * @param written_address first address that is actually written
+     * @return translated request
+     */
+    [[nodiscard]] Request translated(table_t table, std::uint16_t read_address, std::uint16_t written_address) const;
+
+    /*! \brief check if the request can be served
+     *
+     * @details The same checks as in modbus_reply are performed (function code, quantity, address range and value).
+     *
+     * @param mapping mapping that is used to serve the request
+     * @return 0 if the request is valid, otherwise the modbus exception code that is returned to the master
+     */
+    [[nodiscard]] int validate(const modbus_mapping_t &mapping) const noexcept;
+
+    /*! \brief check if the write part of the request is applied by modbus_reply
+     *
+     * @param mapping mapping that is used to serve the request
+     * @return true if the request writes registers and the written values are applied to the mapping
+     */
+    [[nodiscard]] bool write_applied(const modbus_mapping_t &mapping) const noexcept;
+};
+
+}  // namespace Modbus
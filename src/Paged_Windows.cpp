@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Paged_Windows.hpp"
+
+#include <atomic>
+#include <endian.h>
+#include <stdexcept>
+#include <utility>
+
+namespace Modbus {
+
+Paged_Windows::Paged_Windows(const modbus_mapping_t &mapping,
+                             std::string             shm_prefix,
+                             bool                    force,
+                             mode_t                  permissions,
+                             bool                    wire_order)
+    : mapping(mapping),
+      shm_prefix(std::move(shm_prefix)),
+      force(force),
+      permissions(permissions),
+      wire_order(wire_order) {}
+
+void Paged_Windows::add(const std::string &definition) {
+    const auto separator = definition.find('=');
+    const auto at        = definition.find('@');
+    if (separator == std::string::npos || at == std::string::npos || at < separator)
+        throw std::invalid_argument("invalid paged window '" + definition +
+                                    "' (expected <table>:<first>-<last>=<pages>@<page select register>)");
+
+    window_t window;
+    window.window = parse_address_range(definition.substr(0, separator));
+
+    std::size_t pages_end  = 0;
+    std::size_t select_end = 0;
+    try {
+        const auto pages_str  = definition.substr(separator + 1, at - separator - 1);
+        const auto select_str = definition.substr(at + 1);
+        window.pages          = std::stoul(pages_str, &pages_end, 0);
+        const auto select     = std::stoul(select_str, &select_end, 0);
+        if (pages_end != pages_str.size() || select_end != select_str.size())
+            throw std::invalid_argument("trailing characters");
+        if (select >= static_cast<std::size_t>(mapping.nb_registers)) throw std::out_of_range("select register");
+        window.select = static_cast<std::uint16_t>(select);
+    } catch (const std::logic_error &) {
+        throw std::invalid_argument("invalid paged window '" + definition +
+                                    "': invalid number of pages or page select register");
+    }
+
+    static constexpr std::size_t MAX_PAGES = 0x10000;
+    if (window.pages == 0 || window.pages > MAX_PAGES)
+        throw std::invalid_argument("invalid paged window '" + definition + "': number of pages out of range");
+
+    if (window.window.table == AO && window.window.contains(window.select, 1))
+        throw std::invalid_argument("invalid paged window '" + definition +
+                                    "': the page select register is inside the window");
+
+    for (const auto &other : windows) {
+        if (other.window.overlaps(window.window))
+            throw std::invalid_argument("invalid paged window '" + definition + "': overlaps with another window");
+        if (window.window.table == AO && window.window.contains(other.select, 1))
+            throw std::invalid_argument("invalid paged window '" + definition +
+                                        "': contains the page select register of another window");
+        if (other.window.table == AO && other.window.contains(window.select, 1))
+            throw std::invalid_argument("invalid paged window '" + definition +
+                                        "': the page select register is inside another window");
+    }
+
+    const std::size_t element_size = is_coil_table(window.window.table) ? sizeof(uint8_t) : sizeof(uint16_t);
+    window.shm = std::make_unique<cxxshm::SharedMemory>(
+            shm_prefix + "pages_" + table_name(window.window.table) + '_' + std::to_string(window.window.start),
+            window.pages * window.window.count * element_size,
+            false,
+            !force,
+            permissions);
+
+    windows.emplace_back(std::move(window));
+}
+
+std::uint8_t *Paged_Windows::selected_page(const window_t &window) const noexcept {
+    // the register can be written concurrently by consumers
+    const auto raw  = std::atomic_ref(mapping.tab_registers[window.select]).load(std::memory_order_relaxed);  // NOLINT
+    const auto page = static_cast<std::size_t>(wire_order ? be16toh(raw) : raw);
+    if (page >= window.pages) return nullptr;
+
+    const std::size_t element_size = is_coil_table(window.window.table) ? sizeof(uint8_t) : sizeof(uint16_t);
+    return static_cast<std::uint8_t *>(window.shm->get_addr()) + page * window.window.count * element_size;  // NOLINT
+}
+
+bool Paged_Windows::resolve(const Request &request, modbus_mapping_t &view) const {
+    const auto read_table  = request.read_table();
+    const auto write_table = request.write_table();
+    const auto table       = read_table != NO_TABLE ? read_table : write_table;
+    if (table == NO_TABLE) return false;
+
+    const window_t *window  = nullptr;
+    bool            partial = false;
+    for (const auto &w : windows) {
+        if (w.window.table != table) continue;
+        const bool read_match  = read_table == NO_TABLE || w.window.contains(request.address, request.quantity);
+        const bool write_match = write_table == NO_TABLE ||
+                                 w.window.contains(request.write_address, request.write_quantity);
+        if (read_match && write_match) {
+            window = &w;
+            break;
+        }
+
+        partial = partial || (read_table != NO_TABLE && w.window.intersects(request.address, request.quantity)) ||
+                  (write_table != NO_TABLE && w.window.intersects(request.write_address, request.write_quantity));
+    }
+    if (window == nullptr && !partial) return false;
+
+    // create a view of the mapping: the window is the only range of the table
+    // (no range if the page is invalid or the request is only partially inside a window)
+    std::uint8_t *page  = window ? selected_page(*window) : nullptr;
+    view                = mapping;
+    const auto    start = window ? static_cast<int>(window->window.start) : 0;
+    const auto    count = page ? static_cast<int>(window->window.count) : 0;
+    switch (table) {
+        case DO:
+            view.start_bits = start;
+            view.nb_bits    = count;
+            view.tab_bits   = page;
+            break;
+        case DI:
+            view.start_input_bits = start;
+            view.nb_input_bits    = count;
+            view.tab_input_bits   = page;
+            break;
+        case AO:
+            view.start_registers = start;
+            view.nb_registers    = count;
+            view.tab_registers   = reinterpret_cast<uint16_t *>(page);  // NOLINT
+            break;
+        case AI:
+            view.start_input_registers = start;
+            view.nb_input_registers    = count;
+            view.tab_input_registers   = reinterpret_cast<uint16_t *>(page);  // NOLINT
+            break;
+        case TABLE_COUNT:
+        default: return false;
+    }
+
+    return true;
+}
+
+}  // namespace Modbus
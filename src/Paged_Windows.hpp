@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Address_Range.hpp"
+#include "Modbus_Request.hpp"
+#include "cxxshm.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace Modbus {
+
+/*! \brief address windows that show one page of a larger shared memory region
+ *
+ * Each window has a backing shared memory object that contains <pages> pages of the size of the window.
+ * The page that is visible in the window is selected by a holding register (AO) of the register tables.
+ * The page select register is read for every request to the window, so it can be written by the modbus master,
+ * by consumers or by a commit of staged writes.
+ *
+ * Requests that are completely inside a window are served from a view of the mapping (as aliases).
+ * If the selected page does not exist or the request is only partially inside a window, the request is answered
+ * with an illegal data address exception.
+ */
+class Paged_Windows final {
+private:
+    //! paged window definition
+    struct window_t {
+        Address_Range                         window;  //!< address window that is visible for the master
+        std::uint16_t                         select;  //!< address of the page select register (AO)
+        std::size_t                           pages;   //!< number of pages
+        std::unique_ptr<cxxshm::SharedMemory> shm;     //!< backing shared memory
+    };
+
+    const modbus_mapping_t &mapping;      //!< mapping that contains the page select registers
+    const std::string       shm_prefix;   //!< name prefix of the backing shared memory objects
+    const bool              force;        //!< use existing shared memory objects
+    const mode_t            permissions;  //!< shared memory file permissions
+    const bool              wire_order;   //!< AO/AI registers are stored in modbus byte order (big endian)
+
+    std::vector<window_t> windows;
+
+    //* get the page that is selected by the page select register (nullptr: invalid page)
+    [[nodiscard]] std::uint8_t *selected_page(const window_t &window) const noexcept;
+
+public:
+    /*! \brief create an empty set of paged windows
+     *
+     * @param mapping mapping that contains the page select registers
+     * @param shm_prefix name prefix of the backing shared memory objects
+     * @param force do not fail if a shared memory exist, but use the existing shared memory
+     * @param permissions shared memory file permissions
+     * @param wire_order AO/AI registers are stored in modbus byte order (big endian)
+     */
+    Paged_Windows(const modbus_mapping_t &mapping,
+                  std::string             shm_prefix,
+                  bool                    force,
+                  mode_t                  permissions,
+                  bool                    wire_order);
+
+    /*! \brief add a paged window
+     *
+     * Format: <table>:<first>-<last>=<pages>@<page select register>
+     *
+     * Example: AO:1000-1999=256@999 (holding registers 1000 to 1999 show one of 256 pages,
+     * selected by holding register 999)
+     *
+     * The backing shared memory is named <prefix>pages_<table>_<first> (e.g. modbus_pages_AO_1000).
+     *
+     * @param definition paged window definition
+     * @exception std::invalid_argument invalid definition
+     * @exception std::system_error failed to create the backing shared memory
+     */
+    void add(const std::string &definition);
+
+    /*! \brief resolve the paged windows of a request
+     *
+     * @param request received request
+     * @param view output: view of the mapping that serves the request (only written if a window is used)
+     * @return true if the request is served from a paged window (or rejected: partially inside a window)
+     */
+    bool resolve(const Request &request, modbus_mapping_t &view) const;
+
+    /*! \brief check if paged windows are defined
+     *
+     * @return true if no paged window is defined
+     */
+    [[nodiscard]] bool empty() const noexcept { return windows.empty(); }
+};
+
+}  // namespace Modbus
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Plugin.hpp"
+
+#include <dlfcn.h>
+#include <stdexcept>
+
+namespace Modbus {
+
+static_assert(DO == MODBUS_RTU_CLIENT_PLUGIN_TABLE_DO);
+static_assert(DI == MODBUS_RTU_CLIENT_PLUGIN_TABLE_DI);
+static_assert(AO == MODBUS_RTU_CLIENT_PLUGIN_TABLE_AO);
+static_assert(AI == MODBUS_RTU_CLIENT_PLUGIN_TABLE_AI);
+
+//* maximum exception code (one byte)
+static constexpr int MAX_EXCEPTION_CODE = 0xFF;
+
+Plugin::Plugin(const std::string &path, const std::string &argument, modbus_mapping_t *mapping) : name(path) {
+    handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (handle == nullptr) throw std::runtime_error("failed to load plugin '" + path + "': " + dlerror());
+
+    auto get_plugin = reinterpret_cast<modbus_rtu_client_plugin_get_t>(  // NOLINT
+            dlsym(handle, MODBUS_RTU_CLIENT_PLUGIN_SYMBOL));
+    if (get_plugin == nullptr) {
+        dlclose(handle);
+        throw std::runtime_error("'" + path + "' is not a plugin: symbol " MODBUS_RTU_CLIENT_PLUGIN_SYMBOL
+                                 " not found");
+    }
+
+    plugin = get_plugin();
+    if (plugin == nullptr || plugin->api_version < MODBUS_RTU_CLIENT_PLUGIN_MIN_API_VERSION ||
+        plugin->api_version > MODBUS_RTU_CLIENT_PLUGIN_API_VERSION) {
+        dlclose(handle);
+        throw std::runtime_error("plugin '" + path + "' uses an incompatible plugin api version");
+    }
+
+    if (plugin->name != nullptr) name = plugin->name;
+
+    if (!get_function_codes().empty() && plugin->handle_request == nullptr) {
+        dlclose(handle);
+        throw std::runtime_error("plugin '" + name + "' handles function codes without request handler");
+    }
+
+    if (plugin->init != nullptr && plugin->init(&context, argument.c_str(), mapping) != 0) {
+        dlclose(handle);
+        throw std::runtime_error("failed to initialize plugin '" + name + "'");
+    }
+}
+
+Plugin::~Plugin() {
+    if (plugin->deinit != nullptr) plugin->deinit(context);
+    dlclose(handle);
+}
+
+void Plugin::before_read(const Request &request) const {
+    if (plugin->before_read == nullptr) return;
+    plugin->before_read(context, request.function, request.read_table(), request.address, request.quantity);
+}
+
+void Plugin::after_write(const Request &request) const {
+    if (plugin->after_write == nullptr) return;
+    plugin->after_write(
+            context, request.function, request.write_table(), request.write_address, request.write_quantity);
+}
+
+std::span<const std::uint8_t> Plugin::get_function_codes() const noexcept {
+    // the function codes are only part of the plugin description since api version 2
+    if (plugin->api_version < 2 || plugin->function_codes == nullptr) return {};
+    return {plugin->function_codes, plugin->function_code_count};
+}
+
+int Plugin::handle_request(const Request &request, modbus_mapping_t *mapping, std::uint8_t *response) const {
+    const int length = plugin->handle_request(context, request.get_pdu(), request.get_pdu_length(), mapping, response);
+    if (length >= 0 && length <= MODBUS_MAX_PDU_LENGTH) return length;
+
+    // exception response (a response that exceeds the maximum pdu length or an exception code that does not fit in one
+    // byte is a server failure)
+    const bool valid_exception = length < 0 && length >= -MAX_EXCEPTION_CODE;
+
+    response[0] = request.function | 0x80U;  // NOLINT
+    response[1] = static_cast<std::uint8_t>(valid_exception ? -length : MODBUS_EXCEPTION_SLAVE_OR_SERVER_FAILURE);
+    return 2;
+}
+
+}  // namespace Modbus
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Modbus_Request.hpp"
+#include "modbus_rtu_client_shm/plugin.h"
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace Modbus {
+
+/*! \brief data provider plugin that is loaded from a shared library
+ *
+ * see include/modbus_rtu_client_shm/plugin.h for the plugin interface
+ */
+class Plugin final {
+private:
+    void                             *handle  = nullptr;  //!< handle of the shared library (dlopen)
+    const modbus_rtu_client_plugin_t *plugin  = nullptr;  //!< plugin description
+    void                             *context = nullptr;  //!< plugin specific context
+    std::string                       name;               //!< plugin name
+
+public:
+    /*! \brief load and initialize a plugin
+     *
+     * @param path path of the shared library
+     * @param argument argument that is passed to the plugin
+     * @param mapping register tables that are provided to the plugin
+     */
+    Plugin(const std::string &path, const std::string &argument, modbus_mapping_t *mapping);
+
+    /*! \brief deinitialize and unload the plugin
+     *
+     */
+    ~Plugin();
+
+    Plugin(const Plugin &other)            = delete;
+    Plugin(Plugin &&other)                 = delete;
+    Plugin &operator=(const Plugin &other) = delete;
+    Plugin &operator=(Plugin &&other)      = delete;
+
+    /*! \brief call the before read callback of the plugin
+     *
+     * @param request read request
+     */
+    void before_read(const Request &request) const;
+
+    /*! \brief call the after write callback of the plugin
+     *
+     * @param request applied write request
+     */
+    void after_write(const Request &request) const;
+
+    /*! \brief get the function codes that are handled by the plugin
+     *
+     * @return function codes (empty if the plugin does not handle requests)
+     */
+    [[nodiscard]] std::span<const std::uint8_t> get_function_codes() const noexcept;
+
+    /*! \brief call the request handler of the plugin
+     *
+     * @param request received request with one of the function codes of the plugin
+     * @param mapping register tables
+     * @param response output: response pdu (at least MODBUS_MAX_PDU_LENGTH bytes)
+     * @return length of the response pdu, 0 if no response is sent
+     */
+    int handle_request(const Request &request, modbus_mapping_t *mapping, std::uint8_t *response) const;
+
+    /*! \brief get the plugin name
+     *
+     * @return plugin name
+     */
+    [[nodiscard]] const std::string &get_name() const noexcept { return name; }
+};
+
+}  // namespace Modbus
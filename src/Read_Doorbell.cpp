@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Read_Doorbell.hpp"
+
+#include "Print_Time.hpp"
+#include "futex.hpp"
+#include "modbus_rtu_client_shm/consumer.hpp"
+#include "monotonic_time.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace Modbus::shm {
+
+// the consumer library accesses the doorbell with its own definition
+using consumer_doorbell_t = consumer::Doorbell_Producer::doorbell_t;
+static_assert(consumer::Doorbell_Producer::DOORBELL_MAGIC == Read_Doorbell::MAGIC);
+static_assert(consumer::Doorbell_Producer::DOORBELL_VERSION == Read_Doorbell::VERSION);
+static_assert(consumer::Doorbell_Producer::MAX_PRODUCERS == Read_Doorbell::MAX_PRODUCERS);
+static_assert(sizeof(consumer_doorbell_t) == sizeof(Read_Doorbell::doorbell_t));
+static_assert(offsetof(consumer_doorbell_t, request) == offsetof(Read_Doorbell::doorbell_t, request));
+static_assert(offsetof(consumer_doorbell_t, ack) == offsetof(Read_Doorbell::doorbell_t, ack));
+static_assert(offsetof(consumer_doorbell_t, table) == offsetof(Read_Doorbell::doorbell_t, table));
+static_assert(offsetof(consumer_doorbell_t, address) == offsetof(Read_Doorbell::doorbell_t, address));
+static_assert(offsetof(consumer_doorbell_t, quantity) == offsetof(Read_Doorbell::doorbell_t, quantity));
+static_assert(offsetof(consumer_doorbell_t, producers) == offsetof(Read_Doorbell::doorbell_t, producers));
+
+//* maximum acknowledgement timeout in seconds
+static constexpr double MAX_TIMEOUT = 1.0;
+
+static constexpr std::uint64_t NS_PER_S = 1'000'000'000;
+
+Read_Doorbell::Read_Doorbell(const std::string &name, double timeout, bool force, mode_t permissions) {
+    if (timeout <= 0.0 || timeout > MAX_TIMEOUT)
+        throw std::invalid_argument("read doorbell timeout out of range (0 - 1s).");
+
+    timeout_ns = static_cast<std::uint64_t>(timeout * static_cast<double>(NS_PER_S));
+
+    shm = std::make_unique<cxxshm::SharedMemory>(name, sizeof(doorbell_t), false, !force, permissions);
+
+    doorbell = static_cast<doorbell_t *>(shm->get_addr());
+    std::memset(doorbell, 0, sizeof(doorbell_t));
+    doorbell->version = VERSION;
+    std::atomic_ref(doorbell->magic).store(MAGIC, std::memory_order_release);
+}
+
+bool Read_Doorbell::attached() const noexcept {
+    for (auto &producer : doorbell->producers)
+        if (std::atomic_ref(producer).load(std::memory_order_relaxed) != 0) return true;
+    return false;
+}
+
+void Read_Doorbell::expire_producers() noexcept {
+    for (auto &producer : doorbell->producers) {
+        auto pid = std::atomic_ref(producer).load(std::memory_order_relaxed);
+        if (pid > 0 && kill(pid, 0) == -1 && errno == ESRCH)
+            std::atomic_ref(producer).compare_exchange_strong(pid, 0, std::memory_order_relaxed);
+    }
+}
+
+bool Read_Doorbell::ring(const Request &request) {
+    const auto table = request.read_table();
+    if (table != DI && table != AI) return true;
+    if (!attached()) return true;
+
+    // stalled producers acknowledged the last request
+    if (stalled && std::atomic_ref(doorbell->ack).load(std::memory_order_acquire) == sequence) stalled = false;
+
+    // publish request
+    ++sequence;
+    std::atomic_ref(doorbell->table).store(static_cast<std::uint8_t>(table), std::memory_order_relaxed);
+    std::atomic_ref(doorbell->address).store(request.address, std::memory_order_relaxed);
+    std::atomic_ref(doorbell->quantity).store(request.quantity, std::memory_order_relaxed);
+    std::atomic_ref(doorbell->request).store(sequence, std::memory_order_release);
+    futex_wake_all(&doorbell->request);
+
+    if (stalled) return false;
+
+    // wait for acknowledgement
+    const auto deadline = monotonic_ns() + timeout_ns;
+    while (true) {
+        const auto ack = std::atomic_ref(doorbell->ack).load(std::memory_order_acquire);
+        if (ack == sequence) return true;
+
+        const auto now = monotonic_ns();
+        if (now >= deadline) break;
+
+        const auto      remaining = deadline - now;
+        struct timespec wait_time {};
+        wait_time.tv_sec  = static_cast<time_t>(remaining / NS_PER_S);
+        wait_time.tv_nsec = static_cast<long>(remaining % NS_PER_S);
+        futex_wait(&doorbell->ack, ack, wait_time);
+    }
+
+    ++timeout_counter;
+    expire_producers();
+    stalled = attached();
+    std::cerr << Print_Time::iso << " WARNING: read doorbell request not acknowledged in time. "
+              << "Requests are served without waiting until the producers acknowledge again." << std::endl;  // NOLINT
+    return false;
+}
+
+}  // namespace Modbus::shm
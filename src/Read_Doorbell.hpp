@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Modbus_Request.hpp"
+#include "cxxshm.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Modbus::shm {
+
+/*! \brief shared memory object that notifies producers before input registers are read by the modbus master
+ *
+ * Before a read request for DI or AI registers is served, the client publishes the requested range and increments
+ * the futex word 'request'. A producer waits on 'request', updates the requested registers and acknowledges the
+ * request by storing the value of 'request' into the futex word 'ack' (and wakes it).
+ * The client waits until the request is acknowledged or the timeout expired and serves the current data in both cases.
+ *
+ * The client only rings the doorbell if a producer is attached. A producer attaches by storing its pid in a free
+ * slot of 'producers' and detaches by clearing it. If a request is not acknowledged in time, the slots of terminated
+ * producers are cleared (a crashed producer can not detach) and the client does not wait for acknowledgements until
+ * the producers acknowledge a request again (a stalled producer delays only one request).
+ * All shared fields are accessed atomically.
+ */
+class Read_Doorbell final {
+public:
+    static constexpr std::uint32_t MAGIC         = 0x42444D4D;  //!< "MMDB"
+    static constexpr std::uint32_t VERSION       = 2;           //!< layout version
+    static constexpr std::size_t   MAX_PRODUCERS = 8;           //!< maximum number of attached producers
+
+    //! doorbell shared memory layout
+    struct doorbell_t {
+        std::uint32_t                           magic;     //!< MAGIC
+        std::uint32_t                           version;   //!< VERSION
+        std::uint32_t                           request;   //!< futex word: request sequence number
+        std::uint32_t                           ack;       //!< futex word: last acknowledged sequence number
+        std::uint8_t                            table;     //!< requested table (table_t: DI or AI)
+        std::uint8_t                            reserved;
+        std::uint16_t                           address;   //!< first requested address
+        std::uint16_t                           quantity;  //!< number of requested registers
+        std::uint16_t                           reserved2;
+        std::array<std::int32_t, MAX_PRODUCERS> producers;  //!< pids of the attached producers (0: free slot)
+    };
+
+private:
+    std::unique_ptr<cxxshm::SharedMemory> shm;
+
+    doorbell_t   *doorbell;      //!< doorbell in shared memory
+    std::uint64_t timeout_ns;    //!< maximum time to wait for an acknowledgement in nanoseconds
+    std::uint32_t sequence = 0;      //!< last request sequence number
+    bool          stalled  = false;  //!< the last request was not acknowledged in time
+
+    std::size_t timeout_counter = 0;  //!< number of requests that were not acknowledged in time
+
+    //* check if at least one producer is attached
+    [[nodiscard]] bool attached() const noexcept;
+
+    //* clear the slots of terminated producers
+    void expire_producers() noexcept;
+
+public:
+    /*! \brief create the doorbell shared memory
+     *
+     * @param name name of the shared memory object
+     * @param timeout maximum time to wait for an acknowledgement in seconds
+     * @param force do not fail if the shared memory exist, but use the existing shared memory
+     * @param permissions shared memory file permissions
+     */
+    Read_Doorbell(const std::string &name, double timeout, bool force, mode_t permissions);
+
+    ~Read_Doorbell() = default;
+
+    Read_Doorbell(const Read_Doorbell &other)            = delete;
+    Read_Doorbell(Read_Doorbell &&other)                 = delete;
+    Read_Doorbell &operator=(const Read_Doorbell &other) = delete;
+    Read_Doorbell &operator=(Read_Doorbell &&other)      = delete;
+
+    /*! \brief notify the producers about a read request and wait for the acknowledgement
+     *
+     * Does nothing if the request does not read DI or AI registers or if no producer is attached.
+     * Does not wait while the producers are stalled (the last request was not acknowledged in time).
+     *
+     * @param request received request
+     * @return false if the request was not acknowledged (timeout or stalled producers)
+     */
+    bool ring(const Request &request);
+
+    /*! \brief get the number of requests that were not acknowledged in time
+     *
+     * @return number of timeouts
+     */
+    [[nodiscard]] std::size_t get_timeout_counter() const noexcept { return timeout_counter; }
+};
+
+}  // namespace Modbus::shm
@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Recorder.hpp"
+
+#include "monotonic_time.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <endian.h>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace Modbus {
+
+using recorder::record_header_t;
+
+//* minimum size of the ring
+static constexpr std::size_t MIN_RING_SIZE = 1024 * 1024;
+
+//* maximum number of values per record (larger changes are split)
+static constexpr std::size_t MAX_RECORD_VALUES = 4096;
+
+//* unchanged values between two changes that are recorded to avoid an additional record
+static constexpr std::size_t MERGE_GAP = 8;
+
+//* get the number of values of a table
+static std::size_t table_size(const modbus_mapping_t &mapping, table_t table) {
+    switch (table) {
+        case DO: return static_cast<std::size_t>(mapping.nb_bits);
+        case DI: return static_cast<std::size_t>(mapping.nb_input_bits);
+        case AO: return static_cast<std::size_t>(mapping.nb_registers);
+        case AI: return static_cast<std::size_t>(mapping.nb_input_registers);
+        case TABLE_COUNT:
+        default: return 0;
+    }
+}
+
+Recorder::Recorder(const std::string      &path,
+                   std::size_t             size,
+                   const modbus_mapping_t &mapping,
+                   bool                    wire_order,
+                   double                  keyframe_interval,
+                   mode_t                  permissions)
+    : mapping(mapping), wire_order(wire_order) {
+    if (size < MIN_RING_SIZE) throw std::invalid_argument("recorder size must be at least 1 MiB");
+    if (!(keyframe_interval > 0.0)) throw std::invalid_argument("recorder keyframe interval must be > 0");
+    this->keyframe_interval = static_cast<std::uint64_t>(std::llround(keyframe_interval * 1e9));
+
+    capacity  = size & ~std::uint64_t {recorder::RECORD_ALIGNMENT - 1};
+    file_size = sizeof(recorder::file_header_t) + capacity;
+
+    const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, permissions);  // NOLINT
+    if (fd == -1) throw std::system_error(errno, std::generic_category(), "failed to open '" + path + "'");
+
+    struct stat st {};
+    const bool  keep = fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) == file_size;
+
+    if (!keep && ftruncate(fd, static_cast<off_t>(file_size))) {
+        const int error = errno;
+        close(fd);
+        throw std::system_error(error, std::generic_category(), "failed to resize '" + path + "'");
+    }
+
+    void     *addr  = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int error = errno;
+    close(fd);
+    if (addr == MAP_FAILED)  // NOLINT
+        throw std::system_error(error, std::generic_category(), "failed to map '" + path + "'");
+
+    header = static_cast<recorder::file_header_t *>(addr);
+    ring   = static_cast<std::uint8_t *>(addr) + sizeof(recorder::file_header_t);  // NOLINT
+
+    // continue an existing recording
+    if (keep && header->magic == recorder::MAGIC && header->version == recorder::VERSION &&
+        header->capacity == capacity && header->tail <= header->head && header->head - header->tail <= capacity &&
+        valid_ring())
+        return;
+
+    header->magic    = 0;
+    header->version  = recorder::VERSION;
+    header->capacity = capacity;
+    header->head     = 0;
+    header->tail     = 0;
+    std::atomic_ref(header->magic).store(recorder::MAGIC, std::memory_order_release);
+}
+
+Recorder::~Recorder() {
+    munmap(header, file_size);
+}
+
+bool Recorder::valid_ring() const noexcept {
+    std::uint64_t position = header->tail;
+    if (position % recorder::RECORD_ALIGNMENT) return false;
+
+    while (position < header->head) {
+        const auto *record = reinterpret_cast<const record_header_t *>(ring + position % capacity);  // NOLINT
+        if (record->size == 0 || record->size % recorder::RECORD_ALIGNMENT ||
+            record->size > capacity - position % capacity)
+            return false;
+        position += record->size;
+    }
+
+    return position == header->head;
+}
+
+bool Recorder::keyframe_due() noexcept {
+    const auto now = monotonic_ns();
+    if (now < next_keyframe) return false;
+
+    next_keyframe = now + keyframe_interval;
+    return true;
+}
+
+void Recorder::add_range(const std::string &definition) {
+    range_t range;
+    range.range = parse_address_range(definition);
+
+    if (range.range.start + range.range.count > table_size(mapping, range.range.table))
+        throw std::invalid_argument("invalid recorder range '" + definition + "': exceeds the register table");
+
+    for (const auto &other : ranges) {
+        if (other.range.overlaps(range.range))
+            throw std::invalid_argument("invalid recorder range '" + definition + "': overlaps with another range");
+    }
+
+    range.shadow.resize(range.range.count);
+    read_values(range.range.table, range.range.start, range.range.count, range.shadow.data());
+    values.resize(std::max(values.size(), range.range.count));
+    ranges.emplace_back(std::move(range));
+}
+
+void Recorder::read_values(table_t table, std::size_t address, std::size_t count, std::uint16_t *dst) const noexcept {
+    switch (table) {
+        case DO: std::copy_n(mapping.tab_bits + address, count, dst); break;        // NOLINT
+        case DI: std::copy_n(mapping.tab_input_bits + address, count, dst); break;  // NOLINT
+        case AO:
+        case AI: {
+            const uint16_t *src = table == AO ? mapping.tab_registers : mapping.tab_input_registers;
+            src                += address;  // NOLINT
+            if (wire_order)
+                std::transform(src, src + count, dst, [](std::uint16_t v) { return be16toh(v); });  // NOLINT
+            else
+                std::copy_n(src, count, dst);
+            break;
+        }
+        case TABLE_COUNT:
+        default: break;
+    }
+}
+
+void Recorder::on_write(const Request &request) {
+    const auto table = request.write_table();
+    if (table == NO_TABLE || ranges.empty()) return;
+
+    const auto timestamp = realtime_ns();
+    if (keyframe_due()) {
+        record_keyframes(timestamp);
+        return;
+    }
+
+    const std::size_t first = request.write_address;
+    const std::size_t last  = first + request.write_quantity;
+    for (auto &range : ranges) {
+        if (range.range.table != table) continue;
+
+        const std::size_t begin = std::max<std::size_t>(first, range.range.start);
+        const std::size_t end   = std::min<std::size_t>(last, range.range.start + range.range.count);
+        if (begin < end) record_changes(range, begin - range.range.start, end - begin, timestamp);
+    }
+}
+
+void Recorder::sample() {
+    const auto timestamp = realtime_ns();
+    if (keyframe_due()) {
+        record_keyframes(timestamp);
+        return;
+    }
+
+    for (auto &range : ranges)
+        record_changes(range, 0, range.range.count, timestamp);
+}
+
+void Recorder::record_changes(range_t &range, std::size_t first, std::size_t count, std::uint64_t timestamp) {
+    read_values(range.range.table, range.range.start + first, count, values.data());
+
+    const std::uint16_t *current = values.data();
+    std::uint16_t       *shadow  = range.shadow.data() + first;  // NOLINT
+
+    std::size_t i = 0;
+    while (i < count) {
+        if (current[i] == shadow[i]) {  // NOLINT
+            ++i;
+            continue;
+        }
+
+        // find the end of the run of changes (short gaps of unchanged values are included)
+        std::size_t end       = i + 1;
+        std::size_t unchanged = 0;
+        for (std::size_t j = end; j < count && unchanged <= MERGE_GAP && j - i < MAX_RECORD_VALUES; ++j) {
+            if (current[j] != shadow[j]) {  // NOLINT
+                end       = j + 1;
+                unchanged = 0;
+            } else {
+                ++unchanged;
+            }
+        }
+
+        append(recorder::DELTA, range.range.table, range.range.start + first + i, current + i, end - i, timestamp);
+        std::copy(current + i, current + end, shadow + i);  // NOLINT
+        i = end;
+    }
+}
+
+void Recorder::record_keyframes(std::uint64_t timestamp) {
+    for (auto &range : ranges) {
+        read_values(range.range.table, range.range.start, range.range.count, range.shadow.data());
+        for (std::size_t i = 0; i < range.range.count; i += MAX_RECORD_VALUES) {
+            append(recorder::KEYFRAME,
+                   range.range.table,
+                   range.range.start + i,
+                   range.shadow.data() + i,  // NOLINT
+                   std::min(MAX_RECORD_VALUES, range.range.count - i),
+                   timestamp);
+        }
+    }
+}
+
+void Recorder::make_room(std::uint64_t size) noexcept {
+    std::uint64_t tail = header->tail;
+    while (header->head + size - tail > capacity) {
+        const auto *record = reinterpret_cast<const record_header_t *>(ring + tail % capacity);  // NOLINT
+
+        // corrupted ring (the valid records never exceed the head, at most capacity bytes): drop all records
+        if (record->size == 0 || record->size > header->head - tail) {
+            tail = header->head;
+            break;
+        }
+        tail += record->size;
+    }
+
+    // readers must not use the records that are overwritten
+    std::atomic_ref(header->tail).store(tail, std::memory_order_release);
+}
+
+void Recorder::append(recorder::record_type_t type,
+                      table_t                 table,
+                      std::size_t             address,
+                      const std::uint16_t    *data,
+                      std::size_t             count,
+                      std::uint64_t           timestamp) noexcept {
+    const std::uint64_t size = recorder::record_size(count);
+
+    // records never wrap around the end of the ring
+    const std::uint64_t remaining = capacity - header->head % capacity;
+    if (remaining < size) {
+        make_room(remaining);
+        auto *padding = reinterpret_cast<record_header_t *>(ring + header->head % capacity);  // NOLINT
+        padding->size = static_cast<std::uint32_t>(remaining);
+        padding->type = recorder::PADDING;
+        std::atomic_ref(header->head).store(header->head + remaining, std::memory_order_release);
+    }
+
+    make_room(size);
+    auto *record      = reinterpret_cast<record_header_t *>(ring + header->head % capacity);  // NOLINT
+    record->size      = static_cast<std::uint32_t>(size);
+    record->type      = type;
+    record->table     = table;
+    record->address   = static_cast<std::uint16_t>(address);
+    record->timestamp = timestamp;
+    record->count     = static_cast<std::uint16_t>(count);
+    record->reserved  = {};
+    std::memcpy(record + 1, data, count * sizeof(std::uint16_t));  // NOLINT
+
+    std::atomic_ref(header->head).store(header->head + size, std::memory_order_release);
+}
+
+}  // namespace Modbus
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Address_Range.hpp"
+#include "Modbus_Request.hpp"
+#include "Recorder_Format.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace Modbus {
+
+/*! \brief records changes of selected register ranges in a ring file (see Recorder_Format.hpp)
+ *
+ * Changes are detected by comparing the ranges with a shadow copy of the last recorded values:
+ *   - after each applied write request (only the written part of the ranges)
+ *   - periodically by sample() (complete ranges, e.g. inputs that are written by producers)
+ *
+ * All methods must be called while the register tables are not modified (between requests, semaphore held).
+ */
+class Recorder final {
+private:
+    //! recorded range
+    struct range_t {
+        Address_Range              range;   //!< recorded addresses
+        std::vector<std::uint16_t> shadow;  //!< last recorded values
+    };
+
+    const modbus_mapping_t &mapping;     //!< register tables
+    const bool              wire_order;  //!< AO/AI registers are stored in modbus byte order (big endian)
+
+    std::size_t                file_size = 0;        //!< size of the mapped file
+    recorder::file_header_t   *header    = nullptr;  //!< file header
+    std::uint8_t              *ring      = nullptr;  //!< ring of records
+    std::uint64_t              capacity  = 0;        //!< size of the ring
+    std::vector<range_t>       ranges;               //!< recorded ranges
+    std::vector<std::uint16_t> values;               //!< buffer for the current values of a range
+
+    std::uint64_t keyframe_interval;  //!< time between two keyframes in nanoseconds
+    std::uint64_t next_keyframe = 0;  //!< time of the next keyframe (CLOCK_MONOTONIC)
+
+    //* check if the records of an existing ring are consistent
+    [[nodiscard]] bool valid_ring() const noexcept;
+
+    //* check if the keyframe interval elapsed (starts the next interval)
+    [[nodiscard]] bool keyframe_due() noexcept;
+
+    //* read the current values of a part of a range
+    void read_values(table_t table, std::size_t address, std::size_t count, std::uint16_t *dst) const noexcept;
+
+    //* compare a part of a range with its shadow copy and record the changes
+    void record_changes(range_t &range, std::size_t first, std::size_t count, std::uint64_t timestamp);
+
+    //* record the complete content of all ranges
+    void record_keyframes(std::uint64_t timestamp);
+
+    //* append a record to the ring
+    void append(recorder::record_type_t type,
+                table_t                 table,
+                std::size_t             address,
+                const std::uint16_t    *data,
+                std::size_t             count,
+                std::uint64_t           timestamp) noexcept;
+
+    //* drop the oldest records until size bytes can be written at the head
+    void make_room(std::uint64_t size) noexcept;
+
+public:
+    /*! \brief open or create the ring file
+     *
+     * The records of an existing file with the same size are kept if they are consistent.
+     *
+     * @param path path of the ring file
+     * @param size size of the ring in bytes
+     * @param mapping register tables
+     * @param wire_order AO/AI registers are stored in modbus byte order (big endian)
+     * @param keyframe_interval time between two keyframes in seconds
+     * @param permissions file permissions (if the file is created)
+     * @exception std::invalid_argument invalid size
+     * @exception std::system_error failed to create the file
+     */
+    Recorder(const std::string      &path,
+             std::size_t             size,
+             const modbus_mapping_t &mapping,
+             bool                    wire_order,
+             double                  keyframe_interval,
+             mode_t                  permissions);
+
+    ~Recorder();
+
+    Recorder(const Recorder &other)            = delete;
+    Recorder(Recorder &&other)                 = delete;
+    Recorder &operator=(const Recorder &other) = delete;
+    Recorder &operator=(Recorder &&other)      = delete;
+
+    /*! \brief add a recorded range
+     *
+     * Format: <table>:<first>[-<last>]
+     *
+     * @param definition address range
+     * @exception std::invalid_argument invalid or overlapping range
+     */
+    void add_range(const std::string &definition);
+
+    /*! \brief record the changes of an applied write request
+     *
+     * @param request write request (with the addresses that are actually accessed)
+     */
+    void on_write(const Request &request);
+
+    /*! \brief compare all ranges with the last recorded values and record the changes
+     *
+     * Writes keyframes of all ranges if the keyframe interval elapsed.
+     */
+    void sample();
+};
+
+}  // namespace Modbus
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/*! \brief file format of the register change recorder
+ *
+ * Layout: file_header_t, ring (capacity bytes)
+ *
+ * The ring contains records of variable size (record_header_t followed by the values, padded to RECORD_ALIGNMENT).
+ * Record positions are absolute byte offsets that only increase; the record at position p is stored at ring offset
+ * p % capacity. The records in [tail, head) are valid. A record never wraps around the end of the ring:
+ * if the remaining space is too small, a padding record fills it.
+ *
+ * A keyframe record contains all values of a recorded range, a delta record only a run of changed values.
+ * The state of a range at a time t is the last keyframe before t with all following deltas up to t applied.
+ */
+namespace Modbus::recorder {
+
+static constexpr std::uint32_t MAGIC            = 0x43524D4D;  //!< "MMRC"
+static constexpr std::uint32_t VERSION          = 1;           //!< format version
+static constexpr std::size_t   RECORD_ALIGNMENT = 8;           //!< alignment of the records in the ring
+
+//! file header
+struct file_header_t {
+    std::uint32_t magic;     //!< MAGIC
+    std::uint32_t version;   //!< VERSION
+    std::uint64_t capacity;  //!< size of the ring in bytes
+    std::uint64_t head;      //!< position after the newest record (written last, release)
+    std::uint64_t tail;      //!< position of the oldest valid record
+};
+
+//! record types
+enum record_type_t : std::uint8_t {
+    PADDING  = 0,  //!< unused space until the end of the ring
+    KEYFRAME = 1,  //!< all values of a recorded range
+    DELTA    = 2,  //!< changed values of a recorded range
+};
+
+//! record header (followed by count uint16_t values: coil 0/1 or register value in host byte order)
+struct record_header_t {
+    std::uint32_t                size;       //!< size of the record in bytes (including header and padding)
+    std::uint8_t                 type;       //!< record_type_t
+    std::uint8_t                 table;      //!< table (0: DO, 1: DI, 2: AO, 3: AI)
+    std::uint16_t                address;    //!< first address
+    std::uint64_t                timestamp;  //!< CLOCK_REALTIME in nanoseconds
+    std::uint16_t                count;      //!< number of values
+    std::array<std::uint16_t, 3> reserved;
+};
+
+static_assert(sizeof(file_header_t) % RECORD_ALIGNMENT == 0);
+static_assert(sizeof(record_header_t) % RECORD_ALIGNMENT == 0);
+
+//! size of a record with count values
+constexpr std::size_t record_size(std::size_t count) {
+    return (sizeof(record_header_t) + count * sizeof(std::uint16_t) + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+}
+
+}  // namespace Modbus::recorder
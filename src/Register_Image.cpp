@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Register_Image.hpp"
+
+#include "crc32.hpp"
+
+#include <bit>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <endian.h>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace Modbus::storage {
+
+//* read only mapping of a complete file
+class File_View final {
+private:
+    const std::uint8_t *addr = nullptr;
+    std::size_t         size = 0;
+
+public:
+    explicit File_View(const std::string &path) {
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);  // NOLINT
+        if (fd == -1) throw std::system_error(errno, std::generic_category(), "failed to open '" + path + "'");
+
+        struct stat st {};
+        if (fstat(fd, &st)) {
+            const int error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "failed to stat '" + path + "'");
+        }
+        size = static_cast<std::size_t>(st.st_size);
+        if (size == 0) {
+            close(fd);
+            return;
+        }
+
+        // populate the page tables at once: the complete file is read sequentially
+        void     *map   = mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+        const int error = errno;
+        close(fd);
+        if (map == MAP_FAILED)  // NOLINT
+            throw std::system_error(error, std::generic_category(), "failed to map '" + path + "'");
+        addr = static_cast<const std::uint8_t *>(map);
+    }
+
+    ~File_View() {
+        if (addr) munmap(const_cast<std::uint8_t *>(addr), size);  // NOLINT
+    }
+
+    File_View(const File_View &other)            = delete;
+    File_View(File_View &&other)                 = delete;
+    File_View &operator=(const File_View &other) = delete;
+    File_View &operator=(File_View &&other)      = delete;
+
+    [[nodiscard]] const std::uint8_t *data() const noexcept { return addr; }
+    [[nodiscard]] std::size_t         length() const noexcept { return size; }
+};
+
+//* copy registers and swap the byte order of each register
+static void copy_swapped(std::uint16_t *dst, const std::uint8_t *src, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint16_t value = 0;
+        std::memcpy(&value, src + i * sizeof(std::uint16_t), sizeof(value));  // NOLINT
+        dst[i] = static_cast<std::uint16_t>((value << 8) | (value >> 8));      // NOLINT
+    }
+}
+
+void Register_Image::load(const std::string &path, modbus_mapping_t &mapping, bool wire_order) {
+    const File_View file(path);
+
+    if (file.length() < sizeof(header_t))
+        throw std::runtime_error("invalid register image '" + path + "': file too small");
+
+    header_t header {};
+    std::memcpy(&header, file.data(), sizeof(header));
+    header.magic              = le32toh(header.magic);
+    header.version            = le32toh(header.version);
+    header.flags              = le32toh(header.flags);
+    header.nb_bits            = le32toh(header.nb_bits);
+    header.nb_input_bits      = le32toh(header.nb_input_bits);
+    header.nb_registers       = le32toh(header.nb_registers);
+    header.nb_input_registers = le32toh(header.nb_input_registers);
+    header.crc                = le32toh(header.crc);
+
+    if (header.magic != MAGIC) throw std::runtime_error("invalid register image '" + path + "': invalid magic");
+    if (header.version != VERSION)
+        throw std::runtime_error("invalid register image '" + path + "': unsupported version " +
+                                 std::to_string(header.version));
+
+    if (header.nb_bits > static_cast<std::uint32_t>(mapping.nb_bits) ||
+        header.nb_input_bits > static_cast<std::uint32_t>(mapping.nb_input_bits) ||
+        header.nb_registers > static_cast<std::uint32_t>(mapping.nb_registers) ||
+        header.nb_input_registers > static_cast<std::uint32_t>(mapping.nb_input_registers))
+        throw std::runtime_error("invalid register image '" + path + "': image exceeds the register tables");
+
+    const std::size_t size = data_size(header);
+    if (file.length() != sizeof(header_t) + size)
+        throw std::runtime_error("invalid register image '" + path + "': file size does not match the header");
+
+    const std::uint8_t *data = file.data() + sizeof(header_t);  // NOLINT
+    if (crc32(data, size) != header.crc)
+        throw std::runtime_error("invalid register image '" + path + "': checksum mismatch");
+
+    // the image is valid: copy it to the register tables
+    std::memcpy(mapping.tab_bits, data, header.nb_bits);
+    data += header.nb_bits;  // NOLINT
+    std::memcpy(mapping.tab_input_bits, data, header.nb_input_bits);
+    data += header.nb_input_bits;  // NOLINT
+
+    const bool image_big_endian   = header.flags & FLAG_BIG_ENDIAN;
+    const bool storage_big_endian = wire_order || std::endian::native == std::endian::big;
+    const auto copy_registers     = [&](std::uint16_t *dst, std::size_t count) {
+        if (image_big_endian == storage_big_endian) std::memcpy(dst, data, count * sizeof(std::uint16_t));
+        else
+            copy_swapped(dst, data, count);
+        data += count * sizeof(std::uint16_t);  // NOLINT
+    };
+    copy_registers(mapping.tab_registers, header.nb_registers);
+    copy_registers(mapping.tab_input_registers, header.nb_input_registers);
+}
+
+Register_Image::header_t Register_Image::make_header(const modbus_mapping_t &mapping, bool wire_order) noexcept {
+    header_t header {};
+    header.magic              = MAGIC;
+    header.version            = VERSION;
+    header.flags              = wire_order || std::endian::native == std::endian::big ? FLAG_BIG_ENDIAN : 0;
+    header.nb_bits            = static_cast<std::uint32_t>(mapping.nb_bits);
+    header.nb_input_bits      = static_cast<std::uint32_t>(mapping.nb_input_bits);
+    header.nb_registers       = static_cast<std::uint32_t>(mapping.nb_registers);
+    header.nb_input_registers = static_cast<std::uint32_t>(mapping.nb_input_registers);
+    return header;
+}
+
+std::size_t Register_Image::data_size(const header_t &header) noexcept {
+    return std::size_t {header.nb_bits} + header.nb_input_bits +
+           (std::size_t {header.nb_registers} + header.nb_input_registers) * sizeof(std::uint16_t);
+}
+
+void Register_Image::copy_data(const modbus_mapping_t &mapping, std::uint8_t *data) noexcept {
+    const auto copy = [&data](const void *table, std::size_t size) {
+        std::memcpy(data, table, size);
+        data += size;  // NOLINT
+    };
+    copy(mapping.tab_bits, static_cast<std::size_t>(mapping.nb_bits));
+    copy(mapping.tab_input_bits, static_cast<std::size_t>(mapping.nb_input_bits));
+    copy(mapping.tab_registers, static_cast<std::size_t>(mapping.nb_registers) * sizeof(std::uint16_t));
+    copy(mapping.tab_input_registers, static_cast<std::size_t>(mapping.nb_input_registers) * sizeof(std::uint16_t));
+}
+
+void Register_Image::save(const std::string &path, header_t header, const std::uint8_t *data, mode_t permissions) {
+    const std::size_t size = data_size(header);
+
+    header.crc                = crc32(data, size);
+    header.magic              = htole32(header.magic);
+    header.version            = htole32(header.version);
+    header.flags              = htole32(header.flags);
+    header.nb_bits            = htole32(header.nb_bits);
+    header.nb_input_bits      = htole32(header.nb_input_bits);
+    header.nb_registers       = htole32(header.nb_registers);
+    header.nb_input_registers = htole32(header.nb_input_registers);
+    header.crc                = htole32(header.crc);
+
+    // the temporary file is always created (permissions), never opened through a symbolic link
+    const std::string tmp_path = path + ".tmp";
+    unlink(tmp_path.c_str());
+    const int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, permissions);  // NOLINT
+    if (fd == -1) throw std::system_error(errno, std::generic_category(), "failed to create '" + tmp_path + "'");
+
+    const auto write_all = [fd](const void *buffer, std::size_t length) {
+        const auto *bytes = static_cast<const std::uint8_t *>(buffer);
+        while (length) {
+            const ssize_t written = write(fd, bytes, length);
+            if (written == -1) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            bytes  += written;  // NOLINT
+            length -= static_cast<std::size_t>(written);
+        }
+        return true;
+    };
+
+    if (!write_all(&header, sizeof(header)) || !write_all(data, size) || fsync(fd)) {
+        const int error = errno;
+        close(fd);
+        unlink(tmp_path.c_str());
+        throw std::system_error(error, std::generic_category(), "failed to write '" + tmp_path + "'");
+    }
+    close(fd);
+
+    if (rename(tmp_path.c_str(), path.c_str())) {
+        const int error = errno;
+        unlink(tmp_path.c_str());
+        throw std::system_error(error, std::generic_category(), "failed to rename '" + tmp_path + "'");
+    }
+}
+
+}  // namespace Modbus::storage
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "modbus/modbus.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+
+namespace Modbus::storage {
+
+/*! \brief binary image of the register tables
+ *
+ * Layout: header_t, DO (nb_bits bytes), DI (nb_input_bits bytes), AO (nb_registers * uint16_t),
+ * AI (nb_input_registers * uint16_t)
+ *
+ * All header fields are little endian. The registers are little endian unless FLAG_BIG_ENDIAN is set.
+ * The tables are stored without padding. The crc field contains the CRC-32 of all table data.
+ */
+struct Register_Image {
+    static constexpr std::uint32_t MAGIC   = 0x49524D4D;  //!< "MMRI"
+    static constexpr std::uint32_t VERSION = 1;           //!< format version
+
+    static constexpr std::uint32_t FLAG_BIG_ENDIAN = 0x1;  //!< registers are stored big endian (modbus byte order)
+
+    //! header (at the start of the file)
+    struct header_t {
+        std::uint32_t magic;               //!< MAGIC
+        std::uint32_t version;             //!< VERSION
+        std::uint32_t flags;               //!< FLAG_*
+        std::uint32_t nb_bits;             //!< number of DO values
+        std::uint32_t nb_input_bits;       //!< number of DI values
+        std::uint32_t nb_registers;        //!< number of AO values
+        std::uint32_t nb_input_registers;  //!< number of AI values
+        std::uint32_t crc;                 //!< CRC-32 of the table data
+    };
+
+    /*! \brief copy a register image file into the register tables
+     *
+     * The image can contain fewer values than the register tables. The remaining values are not modified.
+     * The file is validated completely (header, size and checksum) before the tables are modified.
+     *
+     * @param path path of the image file
+     * @param mapping register tables
+     * @param wire_order AO/AI registers are stored in modbus byte order (big endian)
+     * @exception std::system_error failed to read the file
+     * @exception std::runtime_error invalid image file
+     */
+    static void load(const std::string &path, modbus_mapping_t &mapping, bool wire_order);
+
+    /*! \brief create the header of an image of the register tables (without checksum)
+     *
+     * @param mapping register tables
+     * @param wire_order AO/AI registers are stored in modbus byte order (big endian)
+     * @return header (host byte order)
+     */
+    static header_t make_header(const modbus_mapping_t &mapping, bool wire_order) noexcept;
+
+    /*! \brief get the size of the table data of an image
+     *
+     * @param header image header
+     * @return size in bytes
+     */
+    static std::size_t data_size(const header_t &header) noexcept;
+
+    /*! \brief copy the register tables to a buffer (in the layout of the image data)
+     *
+     * @param mapping register tables
+     * @param data output buffer (at least data_size() bytes)
+     */
+    static void copy_data(const modbus_mapping_t &mapping, std::uint8_t *data) noexcept;
+
+    /*! \brief write an image file
+     *
+     * The file is written to a temporary file that replaces the file afterward.
+     *
+     * @param path path of the image file
+     * @param header image header (host byte order, the checksum is calculated)
+     * @param data table data (data_size() bytes)
+     * @param permissions file permissions
+     * @exception std::system_error failed to write the file
+     */
+    static void save(const std::string &path, header_t header, const std::uint8_t *data, mode_t permissions);
+};
+
+}  // namespace Modbus::storage
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Register_Storage.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace Modbus::storage {
+
+static constexpr std::size_t MAX_MODBUS_REGISTERS = 0x10000;
+
+//* alignment of the tables in a memory region
+static constexpr std::size_t TABLE_ALIGNMENT = 64;
+
+//* size of a huge page (default huge page size on x86_64 and aarch64)
+static constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+static constexpr std::size_t align(std::size_t size, std::size_t alignment) {
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+Register_Storage::Register_Storage(std::size_t nb_bits,             // NOLINT
+                                   std::size_t nb_input_bits,       // NOLINT
+                                   std::size_t nb_registers,        // NOLINT
+                                   std::size_t nb_input_registers)  // NOLINT
+{
+    // check argument ranges
+    if (nb_bits > MAX_MODBUS_REGISTERS || !nb_bits)
+        throw std::invalid_argument("invalid number of digital output registers.");
+    if (nb_input_bits > MAX_MODBUS_REGISTERS || !nb_input_bits)
+        throw std::invalid_argument("invalid number of digital input registers.");
+    if (nb_registers > MAX_MODBUS_REGISTERS || !nb_registers)
+        throw std::invalid_argument("invalid number of analog output registers.");
+    if (nb_input_registers > MAX_MODBUS_REGISTERS || !nb_input_registers)
+        throw std::invalid_argument("invalid number of analog input registers.");
+
+    // set register count
+    mapping.nb_bits            = static_cast<int>(nb_bits);
+    mapping.nb_input_bits      = static_cast<int>(nb_input_bits);
+    mapping.nb_registers       = static_cast<int>(nb_registers);
+    mapping.nb_input_registers = static_cast<int>(nb_input_registers);
+}
+
+void Register_Storage::resize(table_t, std::size_t) {
+    throw std::runtime_error("the storage backend does not support resizing");
+}
+
+std::size_t Register_Storage::region_size() const noexcept {
+    return align(static_cast<std::size_t>(mapping.nb_bits), TABLE_ALIGNMENT) +
+           align(static_cast<std::size_t>(mapping.nb_input_bits), TABLE_ALIGNMENT) +
+           align(static_cast<std::size_t>(mapping.nb_registers) * sizeof(uint16_t), TABLE_ALIGNMENT) +
+           align(static_cast<std::size_t>(mapping.nb_input_registers) * sizeof(uint16_t), TABLE_ALIGNMENT);
+}
+
+void Register_Storage::assign_region(void *addr) noexcept {
+    auto *region = static_cast<uint8_t *>(addr);
+
+    mapping.tab_bits  = region;
+    region           += align(static_cast<std::size_t>(mapping.nb_bits), TABLE_ALIGNMENT);  // NOLINT
+
+    mapping.tab_input_bits  = region;
+    region                 += align(static_cast<std::size_t>(mapping.nb_input_bits), TABLE_ALIGNMENT);  // NOLINT
+
+    mapping.tab_registers  = reinterpret_cast<uint16_t *>(region);  // NOLINT
+    region                += align(static_cast<std::size_t>(mapping.nb_registers) * sizeof(uint16_t),  // NOLINT
+                                   TABLE_ALIGNMENT);
+
+    mapping.tab_input_registers = reinterpret_cast<uint16_t *>(region);  // NOLINT
+}
+
+Heap_Memory::Heap_Memory(std::size_t size) {
+    addr = std::aligned_alloc(TABLE_ALIGNMENT, align(size, TABLE_ALIGNMENT));
+    if (addr == nullptr) throw std::system_error(ENOMEM, std::generic_category(), "failed to allocate memory");
+    std::memset(addr, 0, size);
+}
+
+Heap_Memory::~Heap_Memory() {
+    std::free(addr);  // NOLINT
+}
+
+Sparse_Memory::Sparse_Memory(std::size_t size) : size(size) {
+    addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (addr == MAP_FAILED) throw std::system_error(errno, std::generic_category(), "failed to map memory");  // NOLINT
+}
+
+Sparse_Memory::~Sparse_Memory() {
+    munmap(addr, size);
+}
+
+Hugepage_Memory::Hugepage_Memory(std::size_t size) : size(align(size, HUGE_PAGE_SIZE)) {
+    addr = mmap(nullptr, this->size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (addr == MAP_FAILED)  // NOLINT
+        throw std::system_error(errno, std::generic_category(), "failed to map huge pages (check vm.nr_hugepages)");
+}
+
+Hugepage_Memory::~Hugepage_Memory() {
+    munmap(addr, size);
+}
+
+File_Memory::File_Memory(std::size_t size, const std::string &path, mode_t permissions) : size(size) {
+    const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, permissions);  // NOLINT
+    if (fd == -1) throw std::system_error(errno, std::generic_category(), "failed to open '" + path + "'");
+
+    // keep the existing content (only the size is adjusted)
+    if (ftruncate(fd, static_cast<off_t>(size))) {
+        const int error = errno;
+        close(fd);
+        throw std::system_error(error, std::generic_category(), "failed to resize '" + path + "'");
+    }
+
+    addr            = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int error = errno;
+    close(fd);
+    if (addr == MAP_FAILED)  // NOLINT
+        throw std::system_error(error, std::generic_category(), "failed to map '" + path + "'");
+}
+
+File_Memory::~File_Memory() {
+    munmap(addr, size);
+}
+
+}  // namespace Modbus::storage
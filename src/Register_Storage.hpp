@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Modbus_Request.hpp"
+#include "modbus/modbus.h"
+
+#include <cstddef>
+#include <string>
+#include <sys/types.h>
+#include <utility>
+
+namespace Modbus::storage {
+
+/*! \brief storage of the modbus register tables
+ *
+ * The client only uses the modbus_mapping_t that is provided by a storage backend.
+ * Therefore, the backend is only relevant when the storage is created and does not affect the request handling.
+ */
+class Register_Storage {
+protected:
+    //! modbus lib storage object
+    modbus_mapping_t mapping {};
+
+    /*! \brief check and set the number of registers
+     *
+     * @param nb_bits number of digital output registers (DO)
+     * @param nb_input_bits number of digital input registers (DI)
+     * @param nb_registers number of analog output registers (AO)
+     * @param nb_input_registers number of analog input registers (AI)
+     * @exception std::invalid_argument invalid number of registers
+     */
+    Register_Storage(std::size_t nb_bits,
+                     std::size_t nb_input_bits,
+                     std::size_t nb_registers,
+                     std::size_t nb_input_registers);
+
+    /*! \brief get the size that is required to store all tables in one memory region
+     *
+     * @return size in bytes
+     */
+    [[nodiscard]] std::size_t region_size() const noexcept;
+
+    /*! \brief place all tables in one memory region
+     *
+     * Layout: DO, DI, AO, AI. Each table starts at a cache line boundary.
+     *
+     * @param addr start of the memory region (at least region_size() bytes)
+     */
+    void assign_region(void *addr) noexcept;
+
+public:
+    virtual ~Register_Storage() = default;
+
+    Register_Storage(const Register_Storage &other)            = delete;
+    Register_Storage(Register_Storage &&other)                 = delete;
+    Register_Storage &operator=(const Register_Storage &other) = delete;
+    Register_Storage &operator=(Register_Storage &&other)      = delete;
+
+    /*! \brief get a pointer to the modbus_mapping_t object
+     *
+     * @return pointer to modbus_mapping_t object
+     */
+    modbus_mapping_t *get_mapping() { return &mapping; }
+
+    /*! \brief change the number of registers of a table
+     *
+     * The address of the table does not change. Registers that are added are 0.
+     * Must be called between two requests.
+     *
+     * @param table register table
+     * @param count new number of registers
+     * @exception std::invalid_argument invalid number of registers
+     * @exception std::runtime_error the backend does not support resizing
+     * @exception std::system_error failed to resize the table
+     */
+    virtual void resize(table_t table, std::size_t count);
+
+    /*! \brief get a pointer to the modbus_mapping_t object
+     *
+     * @return pointer to modbus_mapping_t object
+     */
+    [[nodiscard]] const modbus_mapping_t *get_mapping() const { return &mapping; }
+};
+
+/*! \brief register tables that are stored in one memory region
+ *
+ * The memory is provided by a memory class that is selected at compile time.
+ * A memory class allocates the region on construction and releases it on destruction.
+ * It provides the method get_addr() to get the start of the memory region.
+ *
+ * @tparam Memory memory class
+ */
+template <typename Memory>
+class Region_Storage final : public Register_Storage {
+private:
+    Memory memory;
+
+public:
+    /*! \brief create the register tables
+     *
+     * @param nb_bits number of digital output registers (DO)
+     * @param nb_input_bits number of digital input registers (DI)
+     * @param nb_registers number of analog output registers (AO)
+     * @param nb_input_registers number of analog input registers (AI)
+     * @param args additional arguments for the memory class (after the region size)
+     */
+    template <typename... Args>
+    Region_Storage(std::size_t nb_bits,
+                   std::size_t nb_input_bits,
+                   std::size_t nb_registers,
+                   std::size_t nb_input_registers,
+                   Args &&...args)
+        : Register_Storage(nb_bits, nb_input_bits, nb_registers, nb_input_registers),
+          memory(region_size(), std::forward<Args>(args)...) {
+        assign_region(memory.get_addr());
+    }
+};
+
+//! private memory that is allocated on the heap
+class Heap_Memory final {
+private:
+    void *addr;
+
+public:
+    explicit Heap_Memory(std::size_t size);
+    ~Heap_Memory();
+    Heap_Memory(const Heap_Memory &other)            = delete;
+    Heap_Memory(Heap_Memory &&other)                 = delete;
+    Heap_Memory &operator=(const Heap_Memory &other) = delete;
+    Heap_Memory &operator=(Heap_Memory &&other)      = delete;
+
+    [[nodiscard]] void *get_addr() const noexcept { return addr; }
+};
+
+/*! \brief private anonymous mapping without reserved swap space. Pages are only allocated when they are accessed.
+ *
+ * The tables are contiguous (as required by libmodbus): there is no allocation per address range, only untouched
+ * pages are not backed by physical memory.
+ */
+class Sparse_Memory final {
+private:
+    void       *addr;
+    std::size_t size;
+
+public:
+    explicit Sparse_Memory(std::size_t size);
+    ~Sparse_Memory();
+    Sparse_Memory(const Sparse_Memory &other)            = delete;
+    Sparse_Memory(Sparse_Memory &&other)                 = delete;
+    Sparse_Memory &operator=(const Sparse_Memory &other) = delete;
+    Sparse_Memory &operator=(Sparse_Memory &&other)      = delete;
+
+    [[nodiscard]] void *get_addr() const noexcept { return addr; }
+};
+
+//! private anonymous mapping that uses huge pages (requires configured huge pages, see /proc/sys/vm/nr_hugepages)
+class Hugepage_Memory final {
+private:
+    void       *addr;
+    std::size_t size;
+
+public:
+    explicit Hugepage_Memory(std::size_t size);
+    ~Hugepage_Memory();
+    Hugepage_Memory(const Hugepage_Memory &other)            = delete;
+    Hugepage_Memory(Hugepage_Memory &&other)                 = delete;
+    Hugepage_Memory &operator=(const Hugepage_Memory &other) = delete;
+    Hugepage_Memory &operator=(Hugepage_Memory &&other)      = delete;
+
+    [[nodiscard]] void *get_addr() const noexcept { return addr; }
+};
+
+//! shared mapping of a regular file. The register values are kept in the file after the client terminated.
+class File_Memory final {
+private:
+    void       *addr;
+    std::size_t size;
+
+public:
+    /*! \brief map a file
+     *
+     * @param size size of the region
+     * @param path path of the file (created if it does not exist)
+     * @param permissions file permissions (if the file is created)
+     */
+    File_Memory(std::size_t size, const std::string &path, mode_t permissions);
+    ~File_Memory();
+    File_Memory(const File_Memory &other)            = delete;
+    File_Memory(File_Memory &&other)                 = delete;
+    File_Memory &operator=(const File_Memory &other) = delete;
+    File_Memory &operator=(File_Memory &&other)      = delete;
+
+    [[nodiscard]] void *get_addr() const noexcept { return addr; }
+};
+
+using Heap_Storage     = Region_Storage<Heap_Memory>;      //!< register tables on the heap
+using Sparse_Storage   = Region_Storage<Sparse_Memory>;    //!< register tables in sparse anonymous memory
+using Hugepage_Storage = Region_Storage<Hugepage_Memory>;  //!< register tables in huge pages
+using File_Storage     = Region_Storage<File_Memory>;      //!< register tables in a memory mapped file
+
+}  // namespace Modbus::storage
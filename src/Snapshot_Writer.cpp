@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Snapshot_Writer.hpp"
+
+#include "Print_Time.hpp"
+
+#include <csignal>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace Modbus {
+
+//* get the directory of a file
+static std::string directory_of(const std::string &path) {
+    const auto directory = std::filesystem::path(path).parent_path();
+    return directory.empty() ? std::string(".") : directory.string();
+}
+
+Snapshot_Writer::Snapshot_Writer(const modbus_mapping_t &mapping,
+                                 bool                    wire_order,
+                                 std::string             default_path,
+                                 mode_t                  permissions)
+    : mapping(mapping),
+      wire_order(wire_order),
+      default_path(std::move(default_path)),
+      directory(directory_of(this->default_path)),
+      permissions(permissions) {
+    // allocate (and touch) the buffer now: capture() only copies
+    buffer.resize(storage::Register_Image::data_size(storage::Register_Image::make_header(mapping, wire_order)));
+
+    // signals are handled by the main thread only (the worker inherits the signal mask)
+    sigset_t all_signals;
+    sigset_t old_signals;
+    sigfillset(&all_signals);
+    pthread_sigmask(SIG_SETMASK, &all_signals, &old_signals);
+    worker = std::thread(&Snapshot_Writer::work, this);
+    pthread_sigmask(SIG_SETMASK, &old_signals, nullptr);
+}
+
+Snapshot_Writer::~Snapshot_Writer() {
+    {
+        const std::lock_guard lock(mutex);
+        stop = true;
+    }
+    cv.notify_one();
+    worker.join();
+}
+
+bool Snapshot_Writer::ready() {
+    const std::lock_guard lock(mutex);
+    return !pending;
+}
+
+void Snapshot_Writer::capture(const std::string &file) {
+    if (file.find('/') != std::string::npos || file == "." || file == "..")
+        throw std::invalid_argument("invalid snapshot file name '" + file + "' (no path allowed)");
+
+    // the worker does not access the buffer while no snapshot is pending
+    header = storage::Register_Image::make_header(mapping, wire_order);
+    buffer.resize(storage::Register_Image::data_size(header));  // tables may have been resized
+    storage::Register_Image::copy_data(mapping, buffer.data());
+    path = file.empty() ? default_path : directory + '/' + file;
+
+    {
+        const std::lock_guard lock(mutex);
+        pending = true;
+    }
+    cv.notify_one();
+}
+
+void Snapshot_Writer::work() {
+    std::unique_lock lock(mutex);
+    for (;;) {
+        cv.wait(lock, [this] { return pending || stop; });
+        if (!pending) return;
+
+        // write the pending snapshot (also if termination is requested)
+        lock.unlock();
+        try {
+            storage::Register_Image::save(path, header, buffer.data(), permissions);
+            std::cerr << Print_Time::iso << " INFO: snapshot written to '" << path << "'" << '\n';
+        } catch (const std::system_error &e) {
+            std::cerr << Print_Time::iso << " ERROR: failed to write snapshot: " << e.what() << '\n';
+        }
+        lock.lock();
+        pending = false;
+    }
+}
+
+}  // namespace Modbus
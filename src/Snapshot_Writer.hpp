@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Register_Image.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <thread>
+#include <vector>
+
+namespace Modbus {
+
+/*! \brief writes snapshots of the register tables to register image files
+ *
+ * A snapshot is captured by copying all tables to a buffer (between two requests, while the semaphore is held).
+ * The image file is written asynchronously by a worker thread.
+ * Only one snapshot can be pending at a time.
+ * Snapshots are only written to the directory of the default file.
+ */
+class Snapshot_Writer final {
+private:
+    const modbus_mapping_t &mapping;       //!< register tables
+    const bool              wire_order;    //!< AO/AI registers are stored in modbus byte order
+    const std::string       default_path;  //!< file that is written if no path is specified
+    const std::string       directory;     //!< directory of the snapshot files
+    const mode_t            permissions;   //!< file permissions of the snapshot files
+
+    storage::Register_Image::header_t header {};  //!< header of the captured snapshot
+    std::vector<std::uint8_t>         buffer;     //!< captured table data
+    std::string                       path;       //!< file of the captured snapshot
+
+    std::mutex              mutex;
+    std::condition_variable cv;
+    bool                    pending = false;  //!< a captured snapshot is not written yet (protected by mutex)
+    bool                    stop    = false;  //!< terminate the worker thread (protected by mutex)
+    std::thread             worker;
+
+    //* worker thread: write captured snapshots
+    void work();
+
+public:
+    /*! \brief create the snapshot writer
+     *
+     * @param mapping register tables
+     * @param wire_order AO/AI registers are stored in modbus byte order (big endian)
+     * @param default_path file that is written if no file name is specified
+     * @param permissions file permissions of the snapshot files
+     */
+    Snapshot_Writer(const modbus_mapping_t &mapping, bool wire_order, std::string default_path, mode_t permissions);
+
+    ~Snapshot_Writer();
+
+    Snapshot_Writer(const Snapshot_Writer &other)            = delete;
+    Snapshot_Writer(Snapshot_Writer &&other)                 = delete;
+    Snapshot_Writer &operator=(const Snapshot_Writer &other) = delete;
+    Snapshot_Writer &operator=(Snapshot_Writer &&other)      = delete;
+
+    /*! \brief check if a snapshot can be captured
+     *
+     * @return true if the previous snapshot is written
+     */
+    [[nodiscard]] bool ready();
+
+    /*! \brief capture a snapshot of the register tables (must be called between two requests)
+     *
+     * The tables are copied to the snapshot buffer. The file is written asynchronously.
+     * Must only be called if ready() returned true.
+     *
+     * @param file name of the image file in the directory of the default file (empty: default file)
+     * @exception std::invalid_argument the file name is a path, "." or ".."
+     */
+    void capture(const std::string &file);
+};
+
+}  // namespace Modbus
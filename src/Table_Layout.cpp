@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Table_Layout.hpp"
+
+#include "futex.hpp"
+#include "modbus_rtu_client_shm/consumer.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+
+namespace Modbus::shm {
+
+// the consumer library accesses the layout with its own definition
+using consumer_layout_t = consumer::Table_Layout::layout_t;
+static_assert(consumer::Table_Layout::LAYOUT_MAGIC == Table_Layout::MAGIC);
+static_assert(consumer::Table_Layout::LAYOUT_VERSION == Table_Layout::VERSION);
+static_assert(sizeof(consumer_layout_t) == sizeof(Table_Layout::layout_t));
+static_assert(offsetof(consumer_layout_t, generation) == offsetof(Table_Layout::layout_t, generation));
+static_assert(offsetof(consumer_layout_t, counts) == offsetof(Table_Layout::layout_t, counts));
+
+Table_Layout::Table_Layout(const std::string &name, const modbus_mapping_t &mapping, bool force, mode_t permissions) {
+    shm = std::make_unique<cxxshm::SharedMemory>(name, sizeof(layout_t), false, !force, permissions);
+
+    layout = static_cast<layout_t *>(shm->get_addr());
+    std::memset(layout, 0, sizeof(layout_t));
+    layout->version = VERSION;
+    store(mapping);
+    std::atomic_ref(layout->magic).store(MAGIC, std::memory_order_release);
+}
+
+void Table_Layout::store(const modbus_mapping_t &mapping) noexcept {
+    std::atomic_ref(layout->counts[0]).store(static_cast<std::uint32_t>(mapping.nb_bits), std::memory_order_relaxed);
+    std::atomic_ref(layout->counts[1]).store(static_cast<std::uint32_t>(mapping.nb_input_bits),
+                                             std::memory_order_relaxed);
+    std::atomic_ref(layout->counts[2]).store(static_cast<std::uint32_t>(mapping.nb_registers),
+                                             std::memory_order_relaxed);
+    std::atomic_ref(layout->counts[3]).store(static_cast<std::uint32_t>(mapping.nb_input_registers),
+                                             std::memory_order_relaxed);
+}
+
+void Table_Layout::update(const modbus_mapping_t &mapping) noexcept {
+    store(mapping);
+    std::atomic_ref(layout->generation).fetch_add(1, std::memory_order_release);
+    futex_wake_all(&layout->generation);
+}
+
+}  // namespace Modbus::shm
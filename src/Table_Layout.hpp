@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "cxxshm.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <modbus/modbus.h>
+#include <string>
+
+namespace Modbus::shm {
+
+/*! \brief shared memory object that publishes the current size of the register tables
+ *
+ * The futex word 'generation' is incremented (and woken) after a table was resized.
+ * Consumers have to map the shared memory objects of the tables again if the generation changed.
+ */
+class Table_Layout final {
+public:
+    static constexpr std::uint32_t MAGIC   = 0x4C544D4D;  //!< "MMTL"
+    static constexpr std::uint32_t VERSION = 1;           //!< layout version
+
+    //! layout shared memory
+    struct layout_t {
+        std::uint32_t                magic;       //!< MAGIC
+        std::uint32_t                version;     //!< VERSION
+        std::uint32_t                generation;  //!< futex word: incremented after each resize
+        std::uint32_t                reserved;
+        std::array<std::uint32_t, 4> counts;  //!< number of registers per table (DO, DI, AO, AI)
+    };
+
+private:
+    std::unique_ptr<cxxshm::SharedMemory> shm;
+
+    layout_t *layout;  //!< layout in shared memory
+
+    //* store the table sizes
+    void store(const modbus_mapping_t &mapping) noexcept;
+
+public:
+    /*! \brief create the layout shared memory
+     *
+     * @param name name of the shared memory object
+     * @param mapping register tables
+     * @param force do not fail if the shared memory exist, but use the existing shared memory
+     * @param permissions shared memory file permissions
+     */
+    Table_Layout(const std::string &name, const modbus_mapping_t &mapping, bool force, mode_t permissions);
+
+    /*! \brief publish the sizes after a table was resized and notify the consumers
+     *
+     * @param mapping register tables
+     */
+    void update(const modbus_mapping_t &mapping) noexcept;
+};
+
+}  // namespace Modbus::shm
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Write_Journal.hpp"
+
+#include "futex.hpp"
+#include "modbus_rtu_client_shm/consumer.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+namespace Modbus::shm {
+
+//* maximum number of journal entries
+static constexpr std::size_t MAX_CAPACITY = 0x100000;
+
+static_assert(sizeof(Write_Journal::header_t) % alignof(Write_Journal::entry_t) == 0);
+static_assert(MODBUS_MAX_WRITE_BITS <= Write_Journal::MAX_VALUES * 16);
+static_assert(MODBUS_MAX_WRITE_REGISTERS <= Write_Journal::MAX_VALUES);
+
+// the consumer library accesses the header with its own definition
+using consumer_header_t = consumer::Change_Notifier::journal_header_t;
+static_assert(consumer::Change_Notifier::JOURNAL_MAGIC == Write_Journal::MAGIC);
+static_assert(consumer::Change_Notifier::JOURNAL_VERSION == Write_Journal::VERSION);
+static_assert(sizeof(consumer_header_t) == sizeof(Write_Journal::header_t));
+static_assert(offsetof(consumer_header_t, head) == offsetof(Write_Journal::header_t, head));
+static_assert(offsetof(consumer_header_t, notify) == offsetof(Write_Journal::header_t, notify));
+
+Write_Journal::Write_Journal(const std::string &name, std::size_t capacity, bool force, mode_t permissions) {
+    if (capacity > MAX_CAPACITY || !capacity) throw std::invalid_argument("invalid number of write journal entries.");
+
+    const std::size_t size = sizeof(header_t) + capacity * sizeof(entry_t);
+    shm                    = std::make_unique<cxxshm::SharedMemory>(name, size, false, !force, permissions);
+
+    auto *addr = static_cast<std::uint8_t *>(shm->get_addr());
+    std::memset(addr, 0, size);
+
+    header  = reinterpret_cast<header_t *>(addr);                    // NOLINT
+    entries = reinterpret_cast<entry_t *>(addr + sizeof(header_t));  // NOLINT
+
+    header->capacity   = static_cast<std::uint32_t>(capacity);
+    header->entry_size = sizeof(entry_t);
+    header->version    = VERSION;
+    std::atomic_ref(header->magic).store(MAGIC, std::memory_order_release);
+}
+
+void Write_Journal::append(const Request &request, const modbus_mapping_t &mapping, std::uint64_t timestamp) {
+    ++sequence;
+    entry_t &entry = entries[(sequence - 1) % header->capacity];  // NOLINT
+
+    // invalidate entry
+    std::atomic_ref(entry.sequence).store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    entry.timestamp = timestamp;
+    entry.function  = request.function;
+    entry.table     = request.write_table();
+    entry.address   = request.write_address;
+    entry.count     = request.write_quantity;
+
+    if (entry.table == DO) {
+        // pack coils
+        std::array<std::uint8_t, MAX_VALUES * 2> bits {};
+        const uint8_t *src = mapping.tab_bits + (request.write_address - mapping.start_bits);  // NOLINT
+        for (std::size_t i = 0; i < request.write_quantity; ++i) {
+            if (src[i]) bits[i / 8] |= static_cast<std::uint8_t>(1U << (i % 8));  // NOLINT
+        }
+        std::memcpy(entry.data.data(), bits.data(), bits.size());
+    } else {
+        const uint16_t *src = mapping.tab_registers + (request.write_address - mapping.start_registers);  // NOLINT
+        std::memcpy(entry.data.data(), src, request.write_quantity * sizeof(uint16_t));
+    }
+
+    // publish entry
+    std::atomic_ref(entry.sequence).store(sequence, std::memory_order_release);
+    std::atomic_ref(header->head).store(sequence, std::memory_order_release);
+    std::atomic_ref(header->notify).fetch_add(1, std::memory_order_release);
+    futex_wake_all(&header->notify);
+}
+
+}  // namespace Modbus::shm
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Modbus_Request.hpp"
+#include "cxxshm.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Modbus::shm {
+
+/*! \brief ring buffer in a shared memory object that records all write requests of the modbus master
+ *
+ * The journal has a single writer (the client) and any number of readers.
+ * Every applied write request is stored as one entry with a sequence number and a monotonic timestamp.
+ *
+ * Entry n (starting with 1) is stored at index (n - 1) % capacity.
+ * The sequence number of an entry is set to 0 while the entry is written.
+ * A reader copies the entry and verifies that the sequence number is unchanged afterward.
+ * If the sequence number is greater than expected, the reader was too slow and the entry was overwritten.
+ */
+class Write_Journal final {
+public:
+    static constexpr std::uint32_t MAGIC      = 0x4A574D4D;  //!< "MMWJ"
+    static constexpr std::uint32_t VERSION    = 1;           //!< layout version
+    static constexpr std::size_t   MAX_VALUES = 124;         //!< maximum number of 16 bit data words per entry
+
+    //! journal header (at the start of the shared memory)
+    struct header_t {
+        std::uint32_t magic;       //!< MAGIC
+        std::uint32_t version;     //!< VERSION
+        std::uint32_t capacity;    //!< number of entries
+        std::uint32_t entry_size;  //!< size of one entry in bytes
+        std::uint64_t head;        //!< sequence number of the newest complete entry (0: empty)
+        std::uint32_t notify;      //!< futex word, incremented (and woken) after each new entry
+        std::uint32_t reserved;
+    };
+
+    //! journal entry
+    struct entry_t {
+        std::uint64_t sequence;   //!< sequence number of the entry (0: currently written)
+        std::uint64_t timestamp;  //!< CLOCK_MONOTONIC in nanoseconds
+        std::uint8_t  function;   //!< modbus function code of the request
+        std::uint8_t  table;      //!< written table (table_t: DO or AO)
+        std::uint16_t address;    //!< first written address
+        std::uint16_t count;      //!< number of written coils/registers
+        std::uint16_t reserved;
+
+        /*! \brief values after the write was applied
+         *
+         * registers: one value per register (byte order of the register table)
+         * coils: packed bits (LSB of the first byte is the first coil)
+         */
+        std::array<std::uint16_t, MAX_VALUES> data;
+    };
+
+private:
+    std::unique_ptr<cxxshm::SharedMemory> shm;
+
+    header_t     *header;        //!< journal header in shared memory
+    entry_t      *entries;       //!< journal entries in shared memory
+    std::uint64_t sequence = 0;  //!< sequence number of the last written entry
+
+public:
+    /*! \brief create the journal shared memory
+     *
+     * @param name name of the shared memory object
+     * @param capacity number of entries
+     * @param force do not fail if the shared memory exist, but use the existing shared memory
+     * @param permissions shared memory file permissions
+     */
+    Write_Journal(const std::string &name, std::size_t capacity, bool force, mode_t permissions);
+
+    ~Write_Journal() = default;
+
+    Write_Journal(const Write_Journal &other)            = delete;
+    Write_Journal(Write_Journal &&other)                 = delete;
+    Write_Journal &operator=(const Write_Journal &other) = delete;
+    Write_Journal &operator=(Write_Journal &&other)      = delete;
+
+    /*! \brief append an applied write request to the journal
+     *
+     * @param request write request (must be applied to the mapping)
+     * @param mapping mapping the request was applied to
+     * @param timestamp CLOCK_MONOTONIC timestamp in nanoseconds
+     */
+    void append(const Request &request, const modbus_mapping_t &mapping, std::uint64_t timestamp);
+};
+
+}  // namespace Modbus::shm
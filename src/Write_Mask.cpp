@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Write_Mask.hpp"
+
+#include <stdexcept>
+
+namespace Modbus {
+
+//* get the mask of the bits first to last (inclusive) of a 64 bit word
+static constexpr std::uint64_t bit_mask(std::size_t first, std::size_t last) {
+    const std::uint64_t upper = last == 63 ? ~std::uint64_t {0} : (std::uint64_t {1} << (last + 1)) - 1;
+    return upper & ~((std::uint64_t {1} << first) - 1);
+}
+
+void Write_Mask::protect(const std::string &range) {
+    const auto addresses = parse_address_range(range);
+    if (addresses.table != DO && addresses.table != AO)
+        throw std::invalid_argument("invalid write protection '" + range + "': only DO and AO can be protected");
+
+    auto &bitmap = addresses.table == DO ? protected_do : protected_ao;
+    for (std::size_t address = addresses.start; address < addresses.start + addresses.count; ++address)
+        bitmap[address / WORD_BITS] |= std::uint64_t {1} << (address % WORD_BITS);  // NOLINT
+}
+
+bool Write_Mask::allows(const Request &request) const noexcept {
+    const auto table = request.write_table();
+    if (table != DO && table != AO) return true;
+    if (!request.write_quantity) return true;
+
+    const auto &bitmap = table == DO ? protected_do : protected_ao;
+
+    const std::size_t first      = request.write_address;
+    const std::size_t last       = first + request.write_quantity - 1;
+    const std::size_t first_word = first / WORD_BITS;
+    const std::size_t last_word  = last / WORD_BITS;
+    if (last_word >= WORDS) return true;  // invalid address range (rejected by the request validation)
+
+    if (first_word == last_word)
+        return !(bitmap[first_word] & bit_mask(first % WORD_BITS, last % WORD_BITS));  // NOLINT
+
+    std::uint64_t hits  = bitmap[first_word] & bit_mask(first % WORD_BITS, WORD_BITS - 1);  // NOLINT
+    hits               |= bitmap[last_word] & bit_mask(0, last % WORD_BITS);               // NOLINT
+    for (std::size_t word = first_word + 1; word < last_word; ++word)
+        hits |= bitmap[word];  // NOLINT
+    return !hits;
+}
+
+}  // namespace Modbus
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Address_Range.hpp"
+#include "Modbus_Request.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace Modbus {
+
+/*! \brief write protection of DO and AO addresses
+ *
+ * One bit per address of the writable tables (set: protected).
+ * A write request is checked by testing all 64 bit words of the bitmap that cover the written range.
+ * A write request covers at most 1968 coils or 123 registers, so at most 32 words are tested.
+ */
+class Write_Mask final {
+private:
+    static constexpr std::size_t WORD_BITS = 64;
+    static constexpr std::size_t WORDS     = 0x10000 / WORD_BITS;
+
+    using bitmap_t = std::array<std::uint64_t, WORDS>;
+
+    bitmap_t protected_do {};  //!< protected coils
+    bitmap_t protected_ao {};  //!< protected holding registers
+
+public:
+    /*! \brief protect an address range
+     *
+     * Format: <table>:<first>[-<last>] (table: DO or AO)
+     *
+     * @param range address range
+     * @exception std::invalid_argument invalid address range
+     */
+    void protect(const std::string &range);
+
+    /*! \brief check if a write request only writes unprotected addresses
+     *
+     * @param request write request (with the addresses that are actually accessed)
+     * @return true if the write is allowed
+     */
+    [[nodiscard]] bool allows(const Request &request) const noexcept;
+};
+
+}  // namespace Modbus
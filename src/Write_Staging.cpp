@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Write_Staging.hpp"
+
+#include "futex.hpp"
+#include "modbus_rtu_client_shm/consumer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <sys/eventfd.h>
+#include <system_error>
+
+namespace Modbus::shm {
+
+// the consumer library accesses the staging state with its own definition
+using consumer_staging_t = consumer::Commit_Sync::staging_t;
+static_assert(consumer::Commit_Sync::STAGING_MAGIC == Write_Staging::MAGIC);
+static_assert(consumer::Commit_Sync::STAGING_VERSION == Write_Staging::VERSION);
+static_assert(sizeof(consumer_staging_t) == sizeof(Write_Staging::staging_t));
+static_assert(offsetof(consumer_staging_t, sequence) == offsetof(Write_Staging::staging_t, sequence));
+static_assert(offsetof(consumer_staging_t, tick) == offsetof(Write_Staging::staging_t, tick));
+static_assert(offsetof(consumer_staging_t, commits) == offsetof(Write_Staging::staging_t, commits));
+
+//* interval in which the watcher thread checks the stop flag
+static constexpr struct timespec WATCH_INTERVAL = {1, 0};
+
+//* mark an address range in a dirty bitmap
+static void mark(std::vector<std::uint64_t> &bitmap, std::size_t first, std::size_t count) noexcept {
+    for (std::size_t address = first; address < first + count; ++address)
+        bitmap[address / 64] |= std::uint64_t {1} << (address % 64);  // NOLINT
+}
+
+//* copy all marked values and clear the bitmap
+template <typename T>
+static void copy_marked(std::vector<std::uint64_t> &bitmap, const T *src, T *dst) noexcept {
+    for (std::size_t word = 0; word < bitmap.size(); ++word) {
+        auto bits = bitmap[word];  // NOLINT
+        while (bits) {
+            const auto address = word * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+            dst[address]       = src[address];  // NOLINT
+            bits              &= bits - 1;
+        }
+        bitmap[word] = 0;  // NOLINT
+    }
+}
+
+Write_Staging::Write_Staging(const std::string &name, modbus_mapping_t &mapping, bool force, mode_t permissions)
+    : mapping(mapping), view(mapping) {
+    shm = std::make_unique<cxxshm::SharedMemory>(name, sizeof(staging_t), false, !force, permissions);
+
+    staging = static_cast<staging_t *>(shm->get_addr());
+    std::memset(staging, 0, sizeof(staging_t));
+    staging->version = VERSION;
+    std::atomic_ref(staging->magic).store(MAGIC, std::memory_order_release);
+
+    const auto nb_bits      = static_cast<std::size_t>(mapping.nb_bits);
+    const auto nb_registers = static_cast<std::size_t>(mapping.nb_registers);
+    shadow_bits.assign(mapping.tab_bits, mapping.tab_bits + nb_bits);                        // NOLINT
+    shadow_registers.assign(mapping.tab_registers, mapping.tab_registers + nb_registers);  // NOLINT
+    dirty_bits.resize((nb_bits + 63) / 64);
+    dirty_registers.resize((nb_registers + 63) / 64);
+
+    view.tab_bits      = shadow_bits.data();
+    view.tab_registers = shadow_registers.data();
+}
+
+Write_Staging::~Write_Staging() {
+    if (tick_watcher.joinable()) {
+        stop = true;
+        futex_wake_all(&staging->tick);
+        tick_watcher.join();
+    }
+    if (tick_fd != -1) close(tick_fd);
+}
+
+void Write_Staging::set_commit_coil(std::size_t address) {
+    if (address >= shadow_bits.size()) throw std::invalid_argument("commit coil out of range");
+
+    commit_coil = static_cast<int>(address);
+}
+
+int Write_Staging::watch_ticks() {
+    if (tick_fd != -1) throw std::logic_error("tick watcher already started");
+
+    tick_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (tick_fd == -1) throw std::system_error(errno, std::generic_category(), "failed to create eventfd");
+
+    // signals are handled by the main thread only (the watcher inherits the signal mask)
+    sigset_t all_signals;
+    sigset_t old_signals;
+    sigfillset(&all_signals);
+    pthread_sigmask(SIG_SETMASK, &all_signals, &old_signals);
+    const auto seen = std::atomic_ref(staging->tick).load(std::memory_order_acquire);
+    tick_watcher    = std::thread(&Write_Staging::watch, this, seen);
+    pthread_sigmask(SIG_SETMASK, &old_signals, nullptr);
+
+    return tick_fd;
+}
+
+void Write_Staging::watch(std::uint32_t seen) {
+    while (!stop) {
+        futex_wait(&staging->tick, seen, WATCH_INTERVAL);
+
+        const auto current = std::atomic_ref(staging->tick).load(std::memory_order_acquire);
+        if (current == seen) continue;
+
+        seen                      = current;
+        static constexpr auto ONE = std::uint64_t {1};
+        [[maybe_unused]] auto rc  = write(tick_fd, &ONE, sizeof(ONE));
+    }
+}
+
+void Write_Staging::stage(const Request &request) {
+    switch (request.write_table()) {
+        case DO: mark(dirty_bits, request.write_address, request.write_quantity); break;
+        case AO: mark(dirty_registers, request.write_address, request.write_quantity); break;
+        case DI:
+        case AI:
+        case TABLE_COUNT:
+        default: return;
+    }
+    dirty = true;
+
+    if (commit_coil != -1 && request.write_table() == DO && commit_coil >= request.write_address &&
+        commit_coil < request.write_address + request.write_quantity &&
+        shadow_bits[static_cast<std::size_t>(commit_coil)]) {
+        shadow_bits[static_cast<std::size_t>(commit_coil)] = 0;
+        commit();
+    }
+}
+
+bool Write_Staging::commit() {
+    const bool committed = dirty;
+    if (dirty) publish();
+
+    // changes of other processes become visible for the modbus master
+    std::copy_n(mapping.tab_bits, shadow_bits.size(), shadow_bits.data());                // NOLINT
+    std::copy_n(mapping.tab_registers, shadow_registers.size(), shadow_registers.data());  // NOLINT
+
+    return committed;
+}
+
+void Write_Staging::publish() noexcept {
+    // sequence lock: odd while the visible tables are modified
+    std::atomic_ref sequence(staging->sequence);
+    const auto      current = sequence.load(std::memory_order_relaxed);
+    sequence.store(current + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    copy_marked(dirty_bits, shadow_bits.data(), mapping.tab_bits);
+    copy_marked(dirty_registers, shadow_registers.data(), mapping.tab_registers);
+
+    sequence.store(current + 2, std::memory_order_release);
+    std::atomic_ref(staging->commits).fetch_add(1, std::memory_order_relaxed);
+    futex_wake_all(&staging->sequence);
+
+    dirty = false;
+}
+
+}  // namespace Modbus::shm
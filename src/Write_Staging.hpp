@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Modbus_Request.hpp"
+#include "cxxshm.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Modbus::shm {
+
+/*! \brief stages the write requests of the modbus master and commits them to the register tables on a trigger
+ *
+ * Write requests are applied to a shadow copy of the DO and AO tables. The modbus master is served from the shadow
+ * tables (it reads back its staged writes). A commit copies all staged registers to the visible tables at once.
+ * The visible tables are copied back to the shadow tables after each commit, so changes of other processes become
+ * visible for the master.
+ *
+ * Commit triggers:
+ *   - commit(): called by the client (e.g. timer, control command)
+ *   - consumers increment the futex word 'tick' (see watch_ticks())
+ *   - the modbus master writes 1 to the commit coil (see set_commit_coil())
+ *
+ * The futex word 'sequence' is a sequence lock: it is odd while a commit is in progress and incremented
+ * (and woken) after each commit. Consumers can read consistent tables without the semaphore by retrying
+ * if the sequence changed or was odd, and can wait on it for commit points.
+ */
+class Write_Staging final {
+public:
+    static constexpr std::uint32_t MAGIC   = 0x53574D4D;  //!< "MMWS"
+    static constexpr std::uint32_t VERSION = 1;           //!< layout version
+
+    //! staging shared memory layout
+    struct staging_t {
+        std::uint32_t magic;     //!< MAGIC
+        std::uint32_t version;   //!< VERSION
+        std::uint32_t sequence;  //!< futex word: sequence lock (odd while a commit is in progress)
+        std::uint32_t tick;      //!< futex word: incremented by consumers to request a commit
+        std::uint64_t commits;   //!< number of commits
+    };
+
+private:
+    std::unique_ptr<cxxshm::SharedMemory> shm;
+
+    staging_t        *staging;  //!< staging state in shared memory
+    modbus_mapping_t &mapping;  //!< visible register tables
+    modbus_mapping_t  view;     //!< register tables with the shadow DO and AO tables
+
+    std::vector<std::uint8_t>  shadow_bits;       //!< shadow DO table
+    std::vector<std::uint16_t> shadow_registers;  //!< shadow AO table
+    std::vector<std::uint64_t> dirty_bits;        //!< staged DO addresses (one bit per address)
+    std::vector<std::uint64_t> dirty_registers;   //!< staged AO addresses (one bit per address)
+    bool                       dirty = false;     //!< at least one address is staged
+
+    int commit_coil = -1;  //!< address of the commit coil (-1: none)
+
+    int               tick_fd = -1;  //!< eventfd that is signaled if a consumer requested a commit
+    std::atomic<bool> stop    = false;
+    std::thread       tick_watcher;
+
+    //* watcher thread: wait for ticks of the consumers (seen: value of 'tick' when the thread was started)
+    void watch(std::uint32_t seen);
+
+    //* copy the staged registers to the visible tables (sequence lock)
+    void publish() noexcept;
+
+public:
+    /*! \brief create the staging shared memory and the shadow tables
+     *
+     * @param name name of the shared memory object
+     * @param mapping visible register tables
+     * @param force do not fail if the shared memory exist, but use the existing shared memory
+     * @param permissions shared memory file permissions
+     */
+    Write_Staging(const std::string &name, modbus_mapping_t &mapping, bool force, mode_t permissions);
+
+    ~Write_Staging();
+
+    Write_Staging(const Write_Staging &other)            = delete;
+    Write_Staging(Write_Staging &&other)                 = delete;
+    Write_Staging &operator=(const Write_Staging &other) = delete;
+    Write_Staging &operator=(Write_Staging &&other)      = delete;
+
+    /*! \brief get the register tables that are used to serve the modbus master
+     *
+     * @return mapping with the shadow DO and AO tables
+     */
+    [[nodiscard]] modbus_mapping_t &get_view() noexcept { return view; }
+
+    /*! \brief commit staged writes if the modbus master writes 1 to a coil
+     *
+     * The coil is reset to 0 by the commit.
+     *
+     * @param address DO address
+     * @exception std::invalid_argument address out of range
+     */
+    void set_commit_coil(std::size_t address);
+
+    /*! \brief start a thread that waits for commit requests of the consumers (futex word 'tick')
+     *
+     * @return eventfd that becomes readable if a commit is requested. commit() has to be called by the owner.
+     * @exception std::system_error failed to create the eventfd
+     * @exception std::logic_error already started
+     */
+    int watch_ticks();
+
+    /*! \brief mark the addresses of an applied write request as staged
+     *
+     * Commits if the request set the commit coil.
+     *
+     * @param request applied write request (with the addresses that are actually accessed)
+     */
+    void stage(const Request &request);
+
+    /*! \brief copy all staged registers to the visible tables and refresh the shadow tables
+     *
+     * Must be called between two requests (semaphore held).
+     *
+     * @return true if staged registers were committed
+     */
+    bool commit();
+};
+
+}  // namespace Modbus::shm
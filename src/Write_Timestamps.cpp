@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Write_Timestamps.hpp"
+
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+namespace Modbus::shm {
+
+//* maximum block size (one block per table)
+static constexpr std::size_t MAX_BLOCK_SIZE = 0x10000;
+
+Write_Timestamps::Write_Timestamps(const std::string &name,
+                                   std::size_t        block_size,
+                                   std::size_t        nb_bits,
+                                   std::size_t        nb_registers,
+                                   bool               force,
+                                   mode_t             permissions) {
+    if (block_size > MAX_BLOCK_SIZE || !std::has_single_bit(block_size))
+        throw std::invalid_argument("write timestamp block size must be a power of 2 (1 - 65536).");
+
+    block_shift = static_cast<unsigned>(std::countr_zero(block_size));
+
+    const std::size_t do_blocks = (nb_bits + block_size - 1) >> block_shift;
+    const std::size_t ao_blocks = (nb_registers + block_size - 1) >> block_shift;
+
+    const std::size_t size = sizeof(header_t) + (do_blocks + ao_blocks) * sizeof(std::uint64_t);
+    shm                    = std::make_unique<cxxshm::SharedMemory>(name, size, false, !force, permissions);
+
+    auto *addr = static_cast<std::uint8_t *>(shm->get_addr());
+    std::memset(addr, 0, size);
+
+    auto *header  = reinterpret_cast<header_t *>(addr);                           // NOLINT
+    do_timestamps = reinterpret_cast<std::uint64_t *>(addr + sizeof(header_t));  // NOLINT
+    ao_timestamps = do_timestamps + do_blocks;                                    // NOLINT
+
+    header->version    = VERSION;
+    header->block_size = static_cast<std::uint32_t>(block_size);
+    header->do_blocks  = static_cast<std::uint32_t>(do_blocks);
+    header->ao_blocks  = static_cast<std::uint32_t>(ao_blocks);
+    std::atomic_ref(header->magic).store(MAGIC, std::memory_order_release);
+}
+
+void Write_Timestamps::update(const Request &request, std::uint64_t timestamp) {
+    std::uint64_t *timestamps = request.write_table() == DO ? do_timestamps : ao_timestamps;
+
+    const std::size_t first = request.write_address >> block_shift;
+    const std::size_t last  = (static_cast<std::size_t>(request.write_address) + request.write_quantity - 1) >>
+                             block_shift;
+
+    for (std::size_t i = first; i <= last; ++i)
+        std::atomic_ref(timestamps[i]).store(timestamp, std::memory_order_release);  // NOLINT
+}
+
+}  // namespace Modbus::shm
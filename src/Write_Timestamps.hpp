@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Modbus_Request.hpp"
+#include "cxxshm.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Modbus::shm {
+
+/*! \brief shared memory object that stores the time of the last write access per block of registers
+ *
+ * The writable tables (DO and AO) are divided into blocks of a fixed number of coils/registers.
+ * For each block the CLOCK_MONOTONIC timestamp (in nanoseconds) of the last applied write request is stored.
+ * A timestamp of 0 indicates that the block was never written.
+ *
+ * Layout: header_t, DO timestamps (do_blocks * uint64_t), AO timestamps (ao_blocks * uint64_t)
+ */
+class Write_Timestamps final {
+public:
+    static constexpr std::uint32_t MAGIC   = 0x53544D4D;  //!< "MMTS"
+    static constexpr std::uint32_t VERSION = 1;           //!< layout version
+
+    //! header (at the start of the shared memory)
+    struct header_t {
+        std::uint32_t magic;       //!< MAGIC
+        std::uint32_t version;     //!< VERSION
+        std::uint32_t block_size;  //!< number of coils/registers per block
+        std::uint32_t do_blocks;   //!< number of DO blocks
+        std::uint32_t ao_blocks;   //!< number of AO blocks
+        std::uint32_t reserved;
+    };
+
+private:
+    std::unique_ptr<cxxshm::SharedMemory> shm;
+
+    unsigned       block_shift;    //!< log2 of the block size
+    std::uint64_t *do_timestamps;  //!< DO timestamps in shared memory
+    std::uint64_t *ao_timestamps;  //!< AO timestamps in shared memory
+
+public:
+    /*! \brief create the timestamp shared memory
+     *
+     * @param name name of the shared memory object
+     * @param block_size number of coils/registers per block (power of 2)
+     * @param nb_bits number of digital output registers (DO)
+     * @param nb_registers number of analog output registers (AO)
+     * @param force do not fail if the shared memory exist, but use the existing shared memory
+     * @param permissions shared memory file permissions
+     */
+    Write_Timestamps(const std::string &name,
+                     std::size_t        block_size,
+                     std::size_t        nb_bits,
+                     std::size_t        nb_registers,
+                     bool               force,
+                     mode_t             permissions);
+
+    ~Write_Timestamps() = default;
+
+    Write_Timestamps(const Write_Timestamps &other)            = delete;
+    Write_Timestamps(Write_Timestamps &&other)                 = delete;
+    Write_Timestamps &operator=(const Write_Timestamps &other) = delete;
+    Write_Timestamps &operator=(Write_Timestamps &&other)      = delete;
+
+    /*! \brief update the timestamps of all blocks touched by an applied write request
+     *
+     * @param request write request (must be applied)
+     * @param timestamp CLOCK_MONOTONIC timestamp in nanoseconds
+     */
+    void update(const Request &request, std::uint64_t timestamp);
+};
+
+}  // namespace Modbus::shm
@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "crc32.hpp"
+
+#include <array>
+
+namespace Modbus {
+
+//* reversed polynomial of the CRC-32
+static constexpr std::uint32_t CRC32_POLYNOMIAL = 0xEDB88320;
+
+static constexpr std::array<std::uint32_t, 256> CRC32_TABLE = [] {
+    std::array<std::uint32_t, 256> table {};
+    for (std::uint32_t i = 0; i < table.size(); ++i) {
+        std::uint32_t value = i;
+        for (int bit = 0; bit < 8; ++bit)
+            value = (value & 1) ? (value >> 1) ^ CRC32_POLYNOMIAL : value >> 1;
+        table[i] = value;  // NOLINT
+    }
+    return table;
+}();
+
+std::uint32_t crc32(const void *data, std::size_t size, std::uint32_t crc) noexcept {
+    const auto *bytes = static_cast<const std::uint8_t *>(data);
+
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; ++i)
+        crc = CRC32_TABLE[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);  // NOLINT
+    return ~crc;
+}
+
+}  // namespace Modbus
@@ -0,0 +1,24 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Modbus {
+
+/*! \brief calculate the CRC-32 (IEEE 802.3, as used by zlib) of a memory region
+ *
+ * The calculation can be split in multiple calls by passing the result of the previous call as crc.
+ *
+ * @param data start of the memory region
+ * @param size size of the memory region in bytes
+ * @param crc result of the previous call (0 for the first call)
+ * @return CRC-32
+ */
+std::uint32_t crc32(const void *data, std::size_t size, std::uint32_t crc = 0) noexcept;
+
+}  // namespace Modbus
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/*! \brief wake all processes that wait on a futex word
+ *
+ * The futex is not process private and can be used on shared memory.
+ *
+ * @param word futex word
+ */
+inline void futex_wake_all(std::uint32_t *word) noexcept {
+    syscall(SYS_futex, word, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+/*! \brief wait until a futex word is woken or the timeout expires
+ *
+ * The function returns immediately if the futex word does not contain the expected value.
+ *
+ * @param word futex word
+ * @param expected expected value of the futex word
+ * @param timeout relative timeout
+ * @return true if the call returned because of a timeout
+ */
+inline bool futex_wait(std::uint32_t *word, std::uint32_t expected, const struct timespec &timeout) noexcept {
+    return syscall(SYS_futex, word, FUTEX_WAIT, expected, &timeout, nullptr, 0) == -1 && errno == ETIMEDOUT;
+}
@@ -0,0 +1,14 @@
+/*
+ * Copyright (C) 2024 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+// This file is automatically generated. DO NOT CHANGE!
+
+#include "version_info.hpp"
+
+const std::string Modbus_RTU_client_shm_version_info::VERSION_STR(PROJECT_VERSION);
+const std::string Modbus_RTU_client_shm_version_info::NAME(PROJECT_NAME);
+const std::string Modbus_RTU_client_shm_version_info::COMPILER(COMPILER_INFO);
+const std::string Modbus_RTU_client_shm_version_info::SYSTEM(SYSTEM_INFO);
+const std::string Modbus_RTU_client_shm_version_info::GIT_HASH("84e6d1affc156c1425ca0e1f38ee06ba977bb33d-dirty");
@@ -3,36 +3,61 @@
  * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
  */
 
+#include "Address_Range.hpp"
+#include "Alias_Map.hpp"
+#include "Control_Socket.hpp"
+#include "Event_Loop.hpp"
+#include "Memfd_Server.hpp"
+#include "Metrics.hpp"
+#include "Metrics_Socket.hpp"
 #include "Modbus_RTU_Client.hpp"
+#include "Paged_Windows.hpp"
+#include "Plugin.hpp"
 #include "Print_Time.hpp"
+#include "Read_Doorbell.hpp"
+#include "Recorder.hpp"
+#include "Register_Image.hpp"
+#include "Register_Storage.hpp"
+#include "Snapshot_Writer.hpp"
+#include "Table_Layout.hpp"
+#include "Write_Journal.hpp"
+#include "Write_Staging.hpp"
+#include "Write_Timestamps.hpp"
 #include "generated/version_info.hpp"
 #include "license.hpp"
 #include "modbus_shm.hpp"
 
+#include <chrono>
 #include <csignal>
+#include <cstdlib>
 #include <cxxopts.hpp>
 #include <filesystem>
 #include <iostream>
 #include <sys/ioctl.h>
 #include <sys/resource.h>
 #include <sys/signalfd.h>
+#include <sys/timerfd.h>
 #include <sysexits.h>
 #include <unistd.h>
+#include <utility>
 
 //! Max number of modbus registers
 static constexpr std::size_t MAX_MODBUS_REGISTERS = 0x10000;
 
+//! time in seconds between two keyframes of the recorder
+static constexpr double RECORDER_KEYFRAME_INTERVAL = 60.0;
+
 //! terminate flag
 static volatile bool terminate = false;  // NOLINT
 
 //! modbus socket (to be closed if termination is requested)
-static int socket = -1;  // NOLINT
+static int modbus_socket = -1;  // NOLINT
 
 /*! \brief signal handler (SIGINT and SIGTERM)
  *
  */
 static void sig_term_handler(int) {
-    if (socket != -1) close(socket);
+    if (modbus_socket != -1) close(modbus_socket);
     terminate = true;
 }
 
@@ -47,6 +72,46 @@ constexpr std::array<int, 10> TERM_SIGNALS = {SIGINT,
                                               SIGUSR2,
                                               SIGVTALRM};
 
+/*! \brief create a periodic timer
+ *
+ * @param interval interval in seconds
+ * @return timerfd (nonblocking) or -1 on error (errno is set)
+ */
+static int create_periodic_timer(double interval) {
+    const auto interval_ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(interval)).count();
+
+    itimerspec timer {};
+    timer.it_interval.tv_sec  = interval_ns / 1'000'000'000;
+    timer.it_interval.tv_nsec = interval_ns % 1'000'000'000;
+    timer.it_value            = timer.it_interval;
+
+    const int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd == -1) return -1;
+    if (timerfd_settime(fd, 0, &timer, nullptr)) {
+        const int error = errno;
+        close(fd);
+        errno = error;
+        return -1;
+    }
+    return fd;
+}
+
+/*! \brief parse the interval of a write staging trigger 'period:<seconds>'
+ *
+ * @param trigger write staging trigger
+ * @return interval in seconds or 0 if the interval is invalid (not a number or trailing characters)
+ */
+static double parse_period(const std::string &trigger) {
+    static constexpr std::size_t PREFIX_LENGTH = sizeof "period:" - 1;
+
+    const char *begin    = trigger.c_str() + PREFIX_LENGTH;  // NOLINT
+    char       *end      = nullptr;
+    const auto  interval = std::strtod(begin, &end);
+    if (end == begin || *end != '\0') return 0.0;
+    return interval;
+}
+
 /*! \brief main function
  *
  * @param argc number of arguments
@@ -96,6 +161,19 @@ int main(int argc, char **argv) {
     options.add_options("serial")("rs232", "force to use rs232 mode");
     options.add_options("shared memory")(
             "n,name-prefix", "shared memory name prefix", cxxopts::value<std::string>()->default_value("modbus_"));
+    options.add_options("shared memory")(
+            "storage",
+            "storage backend of the register tables: "
+            "shm (shared memory objects <name-prefix>DO/DI/AO/AI), "
+            "heap (private memory), "
+            "sparse (private memory without reserved swap space, pages are allocated on first access; "
+            "all addresses of the tables exist, there is no allocation per address range), "
+            "hugepage (private memory in huge pages), "
+            "file:<path> (memory mapped file, the values are kept after termination), "
+            "memfd:<socket> (anonymous memory files that are sent to consumers that connect to the unix domain "
+            "socket <socket>). "
+            "The private backends are only accessible by plugins.",
+            cxxopts::value<std::string>()->default_value("shm"));
     options.add_options("modbus")("do-registers",
                                   "number of digital output registers",
                                   cxxopts::value<std::size_t>()->default_value("65536"));
@@ -106,6 +184,41 @@ int main(int argc, char **argv) {
     options.add_options("modbus")(
             "ai-registers", "number of analog input registers", cxxopts::value<std::size_t>()->default_value("65536"));
     options.add_options("modbus")("m,monitor", "output all incoming and outgoing packets to stdout");
+    options.add_options("modbus")("wire-order",
+                                  "store the AO and AI registers in modbus byte order (big endian) instead of the "
+                                  "host byte order. Register requests are served without byte order conversion.");
+    options.add_options("modbus")("write-protect",
+                                  "reject write requests to an address range of DO or AO with an illegal data address "
+                                  "exception: <table>:<first>[-<last>] (e.g. AO:100-199). "
+                                  "Can be specified multiple times.",
+                                  cxxopts::value<std::vector<std::string>>());
+    options.add_options("modbus")("initial-image",
+                                  "initialize the register tables with the content of a register image file "
+                                  "before the first request is served.",
+                                  cxxopts::value<std::string>());
+    options.add_options("modbus")("alias",
+                                  "serve an address range from another range of the register tables: "
+                                  "<table>:<first>-<last>=<source table>:<source first> "
+                                  "(e.g. AI:100-199=AO:0). Can be specified multiple times.",
+                                  cxxopts::value<std::vector<std::string>>());
+    options.add_options("modbus")("paged-window",
+                                  "serve an address window from one page of a larger shared memory region "
+                                  "(shared memory: <name-prefix>pages_<table>_<first>). The page is selected by a "
+                                  "holding register: <table>:<first>-<last>=<pages>@<page select register> "
+                                  "(e.g. AO:1000-1999=256@999). Can be specified multiple times.",
+                                  cxxopts::value<std::vector<std::string>>());
+    options.add_options("modbus")("device-identification",
+                                  "answer Read Device Identification requests (FC 43/14) with the objects of the "
+                                  "given file (one object per line: <object>=<value>, e.g. VendorName=ACME).",
+                                  cxxopts::value<std::string>());
+    options.add_options("modbus")("diagnostics",
+                                  "count the frames on the bus and answer Diagnostics requests (FC 8) including "
+                                  "'Force Listen Only Mode'. Frames with checksum errors are counted and ignored.");
+    options.add_options("modbus")("file-records",
+                                  "serve Read/Write File Record requests (FC 20, FC 21) from the files of the given "
+                                  "directory. The name of a file is its file number (1 - 65535). "
+                                  "The files are not resized.",
+                                  cxxopts::value<std::string>());
     options.add_options("modbus")("byte-timeout",
                                   "timeout interval in seconds between two consecutive bytes of the same message. "
                                   "In most cases it is sufficient to set the response timeout. "
@@ -135,9 +248,94 @@ int main(int argc, char **argv) {
             "Do not use this option per default! "
             "It should only be used if the semaphore of an improperly terminated instance continues "
             "to exist as an orphan and is no longer used.");
+    options.add_options("shared memory")("write-journal",
+                                         "record all write requests of the modbus master in a ring buffer with the "
+                                         "given number of entries (shared memory: <name-prefix>write_journal)",
+                                         cxxopts::value<std::size_t>());
+    options.add_options("shared memory")("write-timestamps",
+                                         "store the time of the last write request per block of DO/AO registers. "
+                                         "The argument is the number of registers per block (power of 2) "
+                                         "(shared memory: <name-prefix>write_timestamps)",
+                                         cxxopts::value<std::size_t>());
+    options.add_options("shared memory")("read-doorbell",
+                                         "notify producers before DI/AI registers are read and wait up to the given "
+                                         "time in seconds for them to acknowledge that the values are up to date "
+                                         "(shared memory: <name-prefix>read_doorbell). "
+                                         "Fractional values are possible.",
+                                         cxxopts::value<double>());
+    options.add_options("shared memory")(
+            "write-staging",
+            "apply write requests of the modbus master to shadow DO/AO tables and commit them to the register tables "
+            "on a trigger (shared memory: <name-prefix>staging). Triggers: "
+            "'tick' (consumers increment the futex word 'tick'), "
+            "'period:<seconds>' (fractional values are possible), "
+            "'coil:<address>' (the master writes 1 to the DO coil). "
+            "Can be specified multiple times.",
+            cxxopts::value<std::vector<std::string>>());
+    options.add_options("shared memory")(
+            "fifo-queue",
+            "serve Read FIFO Queue requests (FC 24) for the given FIFO pointer address from a ring in shared memory "
+            "that producers push registers to (shared memory: <name-prefix>fifo_<address>): "
+            "<address>[:<capacity>] (capacity: number of registers, power of 2, default: 1024). "
+            "Can be specified multiple times.",
+            cxxopts::value<std::vector<std::string>>());
+    options.add_options("shared memory")(
+            "bus-statistics",
+            "publish bus utilization statistics (bus occupancy, inter-frame gaps, share of the traffic of this client) "
+            "and the polling cycle period and jitter per request of the master "
+            "(shared memory: <name-prefix>bus_stats).");
+    options.add_options("shared memory")(
+            "resizable",
+            "allow to resize the register tables at runtime with the control command 'resize' "
+            "(shared memory: <name-prefix>layout). Requires the storage backend 'shm' and --control-socket. "
+            "Can not be combined with --alias, --paged-window, --write-staging, --write-timestamps and --recorder.");
     options.add_options("shared memory")("permissions",
-                                         "permission bits that are applied when creating a shared memory.",
+                                         "permission bits that are applied when creating a shared memory or a file "
+                                         "(sockets, recorder, snapshots, metrics).",
                                          cxxopts::value<std::string>()->default_value("0640"));
+    options.add_options("other")("control-socket",
+                                 "create a unix domain socket that accepts text commands (one per line). "
+                                 "The command 'help' lists all available commands.",
+                                 cxxopts::value<std::string>());
+    options.add_options("other")("snapshot",
+                                 "enable snapshots of all register tables. A snapshot is written to the specified "
+                                 "register image file if SIGUSR1 is received or by the control command 'snapshot' "
+                                 "(optionally with a file name in the directory of the specified file).",
+                                 cxxopts::value<std::string>());
+    options.add_options("other")("recorder",
+                                 "record the changes of the address ranges that are specified with --record in a ring "
+                                 "file. Existing records of the file are kept if the size of the ring is unchanged.",
+                                 cxxopts::value<std::string>());
+    options.add_options("other")("recorder-size",
+                                 "size of the recorder ring file in MiB (at least 1)",
+                                 cxxopts::value<std::size_t>()->default_value("64"));
+    options.add_options("other")("record",
+                                 "address range that is recorded: <table>:<first>[-<last>] (e.g. AI:0-99). "
+                                 "Can be specified multiple times.",
+                                 cxxopts::value<std::vector<std::string>>());
+    options.add_options("other")("record-interval",
+                                 "interval in seconds in which the recorded ranges are sampled to detect changes "
+                                 "that are not written by the modbus master (e.g. inputs). "
+                                 "Fractional values are possible.",
+                                 cxxopts::value<double>()->default_value("0.1"));
+    options.add_options("other")("metrics-socket",
+                                 "serve metrics (request latency per function code, errors, lock times, bus "
+                                 "utilization, table sizes) in the Prometheus text format to each connection of the "
+                                 "given unix domain socket. The socket serves raw text, not HTTP.",
+                                 cxxopts::value<std::string>());
+    options.add_options("other")("metrics-file",
+                                 "write the metrics periodically to the given file "
+                                 "(e.g. for the node_exporter textfile collector). The file is replaced atomically.",
+                                 cxxopts::value<std::string>());
+    options.add_options("other")("metrics-interval",
+                                 "interval in seconds in which the metrics file is written. "
+                                 "Fractional values are possible.",
+                                 cxxopts::value<double>()->default_value("15"));
+    options.add_options("other")("plugin",
+                                 "load a data provider plugin (shared library). "
+                                 "An argument can be passed to the plugin: <path>:<argument>. "
+                                 "Can be specified multiple times.",
+                                 cxxopts::value<std::vector<std::string>>());
     options.add_options("other")("h,help", "print usage");
     options.add_options("version information")("version", "print version and exit");
     options.add_options("version information")("longversion",
@@ -187,6 +385,18 @@ int main(int argc, char **argv) {
         std::cout << "    AO   | Discrete Output Registers | read-write       | <name-prefix>AO" << '\n';
         std::cout << "    AI   | Discrete Input Registers  | read-only        | <name-prefix>AI" << '\n';
         std::cout << '\n';
+        std::cout << "Optional shared memory objects:" << '\n';
+        std::cout << "    option             | shm name" << '\n';
+        std::cout << "    -------------------|-------------------------------" << '\n';
+        std::cout << "    --write-journal    | <name-prefix>write_journal" << '\n';
+        std::cout << "    --write-timestamps | <name-prefix>write_timestamps" << '\n';
+        std::cout << "    --read-doorbell    | <name-prefix>read_doorbell" << '\n';
+        std::cout << "    --write-staging    | <name-prefix>staging" << '\n';
+        std::cout << "    --paged-window     | <name-prefix>pages_<table>_<first>" << '\n';
+        std::cout << "    --resizable        | <name-prefix>layout" << '\n';
+        std::cout << "    --fifo-queue       | <name-prefix>fifo_<address>" << '\n';
+        std::cout << "    --bus-statistics   | <name-prefix>bus_stats" << '\n';
+        std::cout << '\n';
         std::cout << "This application uses the following libraries:" << '\n';
         std::cout << "  - cxxopts by jarro2783 (https://github.com/jarro2783/cxxopts)" << '\n';
         std::cout << "  - libmodbus by Stéphane Raimbault (https://github.com/stephane/libmodbus)" << '\n';
@@ -306,19 +516,93 @@ int main(int argc, char **argv) {
         }
     }
 
-    // create shared memory object for modbus registers
-    std::unique_ptr<Modbus::shm::Shm_Mapping> mapping;
-    try {
-        mapping = std::make_unique<Modbus::shm::Shm_Mapping>(args["do-registers"].as<std::size_t>(),
-                                                             args["di-registers"].as<std::size_t>(),
-                                                             args["ao-registers"].as<std::size_t>(),
-                                                             args["ai-registers"].as<std::size_t>(),
-                                                             args["name-prefix"].as<std::string>(),
-                                                             args.count("force") > 0,
-                                                             shm_permissions);
-    } catch (const std::system_error &e) {
-        std::cerr << e.what() << '\n';
-        return EX_OSERR;
+    const auto SHM_PREFIX = args["name-prefix"].as<std::string>();
+    const bool SHM_FORCE  = args.count("force") > 0;
+
+    // create storage (shared memory objects by default) for modbus registers
+    std::unique_ptr<Modbus::storage::Register_Storage> mapping;
+    std::unique_ptr<Modbus::Memfd_Server>               memfd_server;
+    {
+        const auto STORAGE = args["storage"].as<std::string>();
+        const auto NB_DO   = args["do-registers"].as<std::size_t>();
+        const auto NB_DI   = args["di-registers"].as<std::size_t>();
+        const auto NB_AO   = args["ao-registers"].as<std::size_t>();
+        const auto NB_AI   = args["ai-registers"].as<std::size_t>();
+
+        static const std::string FILE_STORAGE_PREFIX  = "file:";
+        static const std::string MEMFD_STORAGE_PREFIX = "memfd:";
+        try {
+            if (STORAGE == "shm") {
+                mapping = std::make_unique<Modbus::shm::Shm_Mapping>(
+                        NB_DO, NB_DI, NB_AO, NB_AI, SHM_PREFIX, SHM_FORCE, shm_permissions);
+            } else if (STORAGE == "heap") {
+                mapping = std::make_unique<Modbus::storage::Heap_Storage>(NB_DO, NB_DI, NB_AO, NB_AI);
+            } else if (STORAGE == "sparse") {
+                mapping = std::make_unique<Modbus::storage::Sparse_Storage>(NB_DO, NB_DI, NB_AO, NB_AI);
+            } else if (STORAGE == "hugepage") {
+                mapping = std::make_unique<Modbus::storage::Hugepage_Storage>(NB_DO, NB_DI, NB_AO, NB_AI);
+            } else if (STORAGE.starts_with(FILE_STORAGE_PREFIX)) {
+                mapping = std::make_unique<Modbus::storage::File_Storage>(
+                        NB_DO, NB_DI, NB_AO, NB_AI, STORAGE.substr(FILE_STORAGE_PREFIX.size()), shm_permissions);
+            } else if (STORAGE.starts_with(MEMFD_STORAGE_PREFIX)) {
+                auto memfd_storage =
+                        std::make_unique<Modbus::storage::Memfd_Storage>(NB_DO, NB_DI, NB_AO, NB_AI, SHM_PREFIX);
+                memfd_server = std::make_unique<Modbus::Memfd_Server>(STORAGE.substr(MEMFD_STORAGE_PREFIX.size()),
+                                                                      *memfd_storage,
+                                                                      args.count("wire-order") > 0,
+                                                                      shm_permissions);
+                mapping      = std::move(memfd_storage);
+            } else {
+                std::cerr << Print_Time::iso << " ERROR: invalid storage backend '" << STORAGE << "'" << '\n';
+                return exit_usage();
+            }
+        } catch (const std::system_error &e) {
+            std::cerr << e.what() << '\n';
+            return EX_OSERR;
+        } catch (const std::invalid_argument &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return exit_usage();
+        }
+    }
+
+    // publish the table sizes if the tables can be resized
+    std::unique_ptr<Modbus::shm::Table_Layout> table_layout;
+    if (args.count("resizable")) {
+        // these features keep state that depends on the table sizes
+        for (const char *option :
+             {"alias", "paged-window", "write-staging", "write-timestamps", "recorder", "plugin"}) {
+            if (args.count(option)) {
+                std::cerr << Print_Time::iso << " ERROR: --resizable can not be combined with --" << option << '\n';
+                return exit_usage();
+            }
+        }
+        if (args["storage"].as<std::string>() != "shm" || !args.count("control-socket")) {
+            std::cerr << Print_Time::iso
+                      << " ERROR: --resizable requires the storage backend 'shm' and --control-socket" << '\n';
+            return exit_usage();
+        }
+
+        try {
+            table_layout = std::make_unique<Modbus::shm::Table_Layout>(
+                    SHM_PREFIX + "layout", *mapping->get_mapping(), SHM_FORCE, shm_permissions);
+        } catch (const std::system_error &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return EX_OSERR;
+        }
+    }
+
+    // load initial register values (before the first request can be received)
+    if (args.count("initial-image")) {
+        try {
+            Modbus::storage::Register_Image::load(
+                    args["initial-image"].as<std::string>(), *mapping->get_mapping(), args.count("wire-order") > 0);
+        } catch (const std::system_error &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return EX_NOINPUT;
+        } catch (const std::runtime_error &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return EX_DATAERR;
+        }
     }
 
     // create client
@@ -334,6 +618,7 @@ int main(int argc, char **argv) {
                                                        args.count("rs485"),
                                                        mapping->get_mapping());
         client->set_debug(args.count("monitor"));
+        client->set_wire_order(args.count("wire-order"));
     } catch (const std::runtime_error &e) {
         std::cerr << e.what() << '\n';
         return EX_SOFTWARE;
@@ -341,7 +626,7 @@ int main(int argc, char **argv) {
         std::cerr << e.what() << '\n';
         return exit_usage();
     }
-    socket = client->get_socket();
+    modbus_socket = client->get_socket();
 
     // set timeouts if required
     try {
@@ -363,13 +648,452 @@ int main(int argc, char **argv) {
         return EX_SOFTWARE;
     }
 
+    // add write journal, write timestamps and read doorbell if required
+    try {
+        if (args.count("write-journal")) {
+            client->enable_write_journal(std::make_unique<Modbus::shm::Write_Journal>(
+                    SHM_PREFIX + "write_journal", args["write-journal"].as<std::size_t>(), SHM_FORCE, shm_permissions));
+        }
+
+        if (args.count("write-timestamps")) {
+            client->enable_write_timestamps(
+                    std::make_unique<Modbus::shm::Write_Timestamps>(SHM_PREFIX + "write_timestamps",
+                                                                    args["write-timestamps"].as<std::size_t>(),
+                                                                    args["do-registers"].as<std::size_t>(),
+                                                                    args["ao-registers"].as<std::size_t>(),
+                                                                    SHM_FORCE,
+                                                                    shm_permissions));
+        }
+
+        if (args.count("read-doorbell")) {
+            client->enable_read_doorbell(std::make_unique<Modbus::shm::Read_Doorbell>(
+                    SHM_PREFIX + "read_doorbell", args["read-doorbell"].as<double>(), SHM_FORCE, shm_permissions));
+        }
+    } catch (const std::system_error &e) {
+        std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+        return EX_OSERR;
+    } catch (const std::invalid_argument &e) {
+        std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+        return exit_usage();
+    }
+
+    // add write staging (the master is served from the shadow tables, also through aliases)
+    Modbus::shm::Write_Staging *write_staging = nullptr;
+    if (args.count("write-staging")) {
+        try {
+            auto staging = std::make_unique<Modbus::shm::Write_Staging>(
+                    SHM_PREFIX + "staging", *mapping->get_mapping(), SHM_FORCE, shm_permissions);
+
+            bool tick   = false;
+            bool period = false;
+            bool coil   = false;
+            for (const auto &trigger : args["write-staging"].as<std::vector<std::string>>()) {
+                if (trigger.starts_with("coil:")) {
+                    if (std::exchange(coil, true))
+                        throw std::invalid_argument("write staging coil specified multiple times");
+                    std::size_t idx     = 0;
+                    const auto  address = std::stoul(trigger.substr(5), &idx, 0);  // NOLINT
+                    if (idx != trigger.size() - 5)                                  // NOLINT
+                        throw std::invalid_argument("invalid write staging trigger '" + trigger + "'");
+                    staging->set_commit_coil(address);
+                } else if (trigger == "tick") {
+                    if (std::exchange(tick, true))
+                        throw std::invalid_argument("write staging trigger 'tick' specified multiple times");
+                } else if (trigger.starts_with("period:") && parse_period(trigger) > 0.0) {
+                    if (std::exchange(period, true))
+                        throw std::invalid_argument("write staging period specified multiple times");
+                } else {
+                    throw std::invalid_argument("invalid write staging trigger '" + trigger + "'");
+                }
+            }
+
+            write_staging = staging.get();
+            client->enable_write_staging(std::move(staging));
+        } catch (const std::system_error &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return EX_OSERR;
+        } catch (const std::logic_error &e) {
+            // std::invalid_argument and std::out_of_range (std::stoul)
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return exit_usage();
+        }
+    }
+
+    // add aliases
+    if (args.count("alias")) {
+        auto aliases = std::make_unique<Modbus::Alias_Map>(write_staging ? write_staging->get_view()
+                                                                         : *mapping->get_mapping());
+        try {
+            for (const auto &alias : args["alias"].as<std::vector<std::string>>())
+                aliases->add(alias);
+        } catch (const std::invalid_argument &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return exit_usage();
+        }
+        client->enable_aliases(std::move(aliases));
+    }
+
+    // add paged windows
+    if (args.count("paged-window")) {
+        auto windows = std::make_unique<Modbus::Paged_Windows>(
+                write_staging ? write_staging->get_view() : *mapping->get_mapping(),
+                SHM_PREFIX,
+                SHM_FORCE,
+                shm_permissions,
+                args.count("wire-order") > 0);
+        try {
+            for (const auto &window : args["paged-window"].as<std::vector<std::string>>())
+                windows->add(window);
+        } catch (const std::system_error &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return EX_OSERR;
+        } catch (const std::invalid_argument &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return exit_usage();
+        }
+        client->enable_paged_windows(std::move(windows));
+    }
+
+    // add write protection
+    if (args.count("write-protect")) {
+        auto mask = std::make_unique<Modbus::Write_Mask>();
+        try {
+            for (const auto &range : args["write-protect"].as<std::vector<std::string>>())
+                mask->protect(range);
+        } catch (const std::invalid_argument &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return exit_usage();
+        }
+        client->enable_write_mask(std::move(mask));
+    }
+
+    // add diagnostics
+    if (args.count("diagnostics")) client->enable_diagnostics(std::make_unique<Modbus::Diagnostics>());
+
+    // add device identification
+    if (args.count("device-identification")) {
+        try {
+            client->enable_device_identification(std::make_unique<Modbus::Device_Identification>(
+                    args["device-identification"].as<std::string>()));
+        } catch (const std::system_error &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return EX_NOINPUT;
+        } catch (const std::runtime_error &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return EX_DATAERR;
+        }
+    }
+
+    // add file records
+    if (args.count("file-records")) {
+        try {
+            client->enable_file_records(
+                    std::make_unique<Modbus::File_Records>(args["file-records"].as<std::string>()));
+        } catch (const std::system_error &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return EX_NOINPUT;
+        } catch (const std::invalid_argument &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return exit_usage();
+        }
+    }
+
+    // add fifo queues
+    if (args.count("fifo-queue")) {
+        auto queues = std::make_unique<Modbus::shm::Fifo_Queues>(
+                SHM_PREFIX, SHM_FORCE, shm_permissions, args.count("wire-order") > 0);
+        try {
+            for (const auto &queue : args["fifo-queue"].as<std::vector<std::string>>())
+                queues->add(queue);
+        } catch (const std::system_error &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return EX_OSERR;
+        } catch (const std::invalid_argument &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return exit_usage();
+        }
+        client->enable_fifo_queues(std::move(queues));
+    }
+
+    // add metrics
+    Modbus::Metrics *metrics = nullptr;
+    if (args.count("metrics-socket") || args.count("metrics-file")) {
+        if (!(args["metrics-interval"].as<double>() > 0.0)) {
+            std::cerr << Print_Time::iso << " ERROR: metrics interval must be > 0" << '\n';
+            return exit_usage();
+        }
+
+        auto client_metrics =
+                std::make_unique<Modbus::Metrics>(BAUD, DATA_BITS, static_cast<char>(PARITY), STOP_BITS);
+        metrics = client_metrics.get();
+        client->enable_metrics(std::move(client_metrics));
+    }
+
+    // add bus statistics
+    if (args.count("bus-statistics")) {
+        try {
+            client->enable_bus_statistics(std::make_unique<Modbus::shm::Bus_Statistics>(SHM_PREFIX + "bus_stats",
+                                                                                        BAUD,
+                                                                                        DATA_BITS,
+                                                                                        static_cast<char>(PARITY),
+                                                                                        STOP_BITS,
+                                                                                        SHM_FORCE,
+                                                                                        shm_permissions));
+        } catch (const std::system_error &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return EX_OSERR;
+        }
+    }
+
+    // add recorder
+    Modbus::Recorder *recorder = nullptr;
+    if ((args.count("recorder") > 0) != (args.count("record") > 0)) {
+        std::cerr << Print_Time::iso << " ERROR: --recorder and --record must be used together" << '\n';
+        return exit_usage();
+    }
+    if (args.count("recorder")) {
+        try {
+            const auto record_interval = args["record-interval"].as<double>();
+            if (!(record_interval > 0.0)) throw std::invalid_argument("record interval must be > 0");
+
+            auto rec = std::make_unique<Modbus::Recorder>(args["recorder"].as<std::string>(),
+                                                          args["recorder-size"].as<std::size_t>() * 1024 * 1024,
+                                                          *mapping->get_mapping(),
+                                                          args.count("wire-order") > 0,
+                                                          RECORDER_KEYFRAME_INTERVAL,
+                                                          shm_permissions);
+            for (const auto &range : args["record"].as<std::vector<std::string>>())
+                rec->add_range(range);
+            recorder = rec.get();
+            client->enable_recorder(std::move(rec));
+        } catch (const std::system_error &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return EX_OSERR;
+        } catch (const std::invalid_argument &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return exit_usage();
+        }
+    }
+
+    // load plugins
+    if (args.count("plugin")) {
+        for (const auto &plugin_arg : args["plugin"].as<std::vector<std::string>>()) {
+            const auto        separator = plugin_arg.find(':');
+            const std::string path      = plugin_arg.substr(0, separator);
+            const std::string argument  = separator == std::string::npos ? "" : plugin_arg.substr(separator + 1);
+            try {
+                client->add_plugin(std::make_unique<Modbus::Plugin>(
+                        path, argument, write_staging ? &write_staging->get_view() : mapping->get_mapping()));
+            } catch (const std::runtime_error &e) {
+                std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+                return EX_SOFTWARE;
+            }
+            std::cerr << Print_Time::iso << " INFO: Plugin '" << path << "' loaded." << '\n';
+        }
+    }
+
     std::cerr << Print_Time::iso << " INFO: Connected to bus." << '\n';
 
+    bool               connection_closed = false;
+    Modbus::Event_Loop event_loop;
+    event_loop.add(modbus_socket, [&] { connection_closed = client->handle_request(); });
+    if (memfd_server) event_loop.add(memfd_server->get_fd(), [&] { memfd_server->handle_connections(); });
+
+    // control socket
+    std::unique_ptr<Modbus::Control_Socket> control_socket;
+    if (args.count("control-socket")) {
+        try {
+            control_socket = std::make_unique<Modbus::Control_Socket>(
+                    args["control-socket"].as<std::string>(), shm_permissions, event_loop);
+        } catch (const std::system_error &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return EX_OSERR;
+        }
+    }
+
+    // resize a table between two requests (control command "resize <table> <count>")
+    if (table_layout) {
+        control_socket->add_command(
+                "resize",
+                "change the number of registers of a table: resize <table> <count>",
+                [&client, &mapping, &table_layout](const std::string &arguments) {
+                    const auto separator = arguments.find(' ');
+                    if (separator == std::string::npos) throw std::invalid_argument("usage: resize <table> <count>");
+
+                    const auto  table = Modbus::parse_table(arguments.substr(0, separator));
+                    std::size_t idx   = 0;
+                    std::size_t count = 0;
+                    try {
+                        count = std::stoul(arguments.substr(separator + 1), &idx, 0);
+                    } catch (const std::logic_error &) { idx = 0; }
+                    if (idx == 0 || idx != arguments.size() - separator - 1)
+                        throw std::invalid_argument("invalid number of registers");
+
+                    if (!client->run_locked([&] {
+                            mapping->resize(table, count);
+                            table_layout->update(*mapping->get_mapping());
+                        }))
+                        throw std::runtime_error("failed to acquire the semaphore");
+                    return std::string(Modbus::table_name(table)) + " resized to " + std::to_string(count);
+                });
+    }
+
+    // snapshots (SIGUSR1 or control command "snapshot [<file>]")
+    std::unique_ptr<Modbus::Snapshot_Writer> snapshot_writer;
+    int                                      snapshot_signal_fd = -1;
+    if (args.count("snapshot")) {
+        snapshot_writer = std::make_unique<Modbus::Snapshot_Writer>(*mapping->get_mapping(),
+                                                                    args.count("wire-order") > 0,
+                                                                    args["snapshot"].as<std::string>(),
+                                                                    shm_permissions);
+
+        // the tables are copied between two requests while the semaphore is held
+        auto take_snapshot = [&client, &snapshot_writer](const std::string &file) {
+            if (!snapshot_writer->ready()) throw std::runtime_error("previous snapshot is not written yet");
+            if (!client->run_locked([&] { snapshot_writer->capture(file); }))
+                throw std::runtime_error("failed to acquire the semaphore");
+        };
+
+        // SIGUSR1 triggers a snapshot instead of terminating the application
+        sigset_t snapshot_signals;
+        sigemptyset(&snapshot_signals);
+        sigaddset(&snapshot_signals, SIGUSR1);
+        if (sigprocmask(SIG_BLOCK, &snapshot_signals, nullptr) ||
+            (snapshot_signal_fd = signalfd(-1, &snapshot_signals, SFD_NONBLOCK | SFD_CLOEXEC)) == -1) {
+            perror("Failed to set up snapshot signal");
+            return EX_OSERR;
+        }
+        event_loop.add(snapshot_signal_fd, [snapshot_signal_fd, take_snapshot] {
+            signalfd_siginfo info {};
+            while (read(snapshot_signal_fd, &info, sizeof(info)) == sizeof(info)) {
+                try {
+                    take_snapshot("");
+                } catch (const std::runtime_error &e) {
+                    std::cerr << Print_Time::iso << " WARNING: snapshot skipped: " << e.what() << '\n';
+                }
+            }
+        });
+
+        if (control_socket) {
+            control_socket->add_command("snapshot",
+                                        "write a snapshot of all register tables: snapshot [<file name>]",
+                                        [take_snapshot](const std::string &file) {
+                                            take_snapshot(file);
+                                            return std::string("snapshot captured");
+                                        });
+        }
+    }
+
+    // periodic sampling of the recorded ranges
+    int record_timer_fd = -1;
+    if (recorder) {
+        record_timer_fd = create_periodic_timer(args["record-interval"].as<double>());
+        if (record_timer_fd == -1) {
+            perror("Failed to set up recorder timer");
+            return EX_OSERR;
+        }
+        event_loop.add(record_timer_fd, [&client, recorder, record_timer_fd] {
+            std::uint64_t expirations = 0;
+            if (read(record_timer_fd, &expirations, sizeof(expirations)) != sizeof(expirations)) return;
+            // skipped if the semaphore is not acquired (logged by the client): sampled again by the next event
+            static_cast<void>(client->run_locked([recorder] { recorder->sample(); }));
+        });
+    }
+
+    // commit triggers of the write staging
+    int staging_timer_fd = -1;
+    if (write_staging) {
+        const auto commit = [&client, write_staging] {
+            bool committed = false;
+            if (!client->run_locked([&] { committed = write_staging->commit(); }))
+                throw std::runtime_error("failed to acquire the semaphore");
+            return committed;
+        };
+
+        // fd handler: consume the event and commit
+        const auto commit_on = [commit](int fd) {
+            return [commit, fd] {
+                std::uint64_t events = 0;
+                if (read(fd, &events, sizeof(events)) != sizeof(events)) return;
+                try {
+                    commit();
+                } catch (const std::runtime_error &e) {
+                    // the staged writes are committed by the next trigger
+                    std::cerr << Print_Time::iso << " WARNING: commit skipped: " << e.what() << '\n';
+                }
+            };
+        };
+
+        for (const auto &trigger : args["write-staging"].as<std::vector<std::string>>()) {
+            if (trigger == "tick") {
+                int tick_fd = -1;
+                try {
+                    tick_fd = write_staging->watch_ticks();
+                } catch (const std::system_error &e) {
+                    std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+                    return EX_OSERR;
+                }
+                event_loop.add(tick_fd, commit_on(tick_fd));
+            } else if (trigger.starts_with("period:")) {
+                staging_timer_fd = create_periodic_timer(parse_period(trigger));
+                if (staging_timer_fd == -1) {
+                    perror("Failed to set up write staging timer");
+                    return EX_OSERR;
+                }
+                event_loop.add(staging_timer_fd, commit_on(staging_timer_fd));
+            }
+        }
+
+        if (control_socket) {
+            control_socket->add_command(
+                    "commit", "commit the staged writes of the modbus master", [commit](const std::string &) {
+                        return std::string(commit() ? "committed" : "nothing staged");
+                    });
+        }
+    }
+
+    // metrics (unix domain socket and textfile), rendered from the counters between two requests
+    std::unique_ptr<Modbus::Metrics_Socket> metrics_socket;
+    int                                     metrics_timer_fd = -1;
+    if (args.count("metrics-socket")) {
+        try {
+            metrics_socket = std::make_unique<Modbus::Metrics_Socket>(
+                    args["metrics-socket"].as<std::string>(), shm_permissions, event_loop, [metrics, &mapping] {
+                        return metrics->render_prometheus(*mapping->get_mapping());
+                    });
+        } catch (const std::system_error &e) {
+            std::cerr << Print_Time::iso << " ERROR: " << e.what() << '\n';
+            return EX_OSERR;
+        }
+    }
+    if (args.count("metrics-file")) {
+        metrics_timer_fd = create_periodic_timer(args["metrics-interval"].as<double>());
+        if (metrics_timer_fd == -1) {
+            perror("Failed to set up metrics timer");
+            return EX_OSERR;
+        }
+        event_loop.add(metrics_timer_fd,
+                       [metrics,
+                        &mapping,
+                        metrics_timer_fd,
+                        shm_permissions,
+                        path = args["metrics-file"].as<std::string>()] {
+                           std::uint64_t expirations = 0;
+                           if (read(metrics_timer_fd, &expirations, sizeof(expirations)) != sizeof(expirations))
+                               return;
+                           try {
+                               metrics->write_file(path, *mapping->get_mapping(), shm_permissions);
+                           } catch (const std::system_error &e) {
+                               std::cerr << Print_Time::iso << " WARNING: " << e.what() << '\n';
+                           }
+                       });
+    }
+
     // ========== MAIN LOOP ========== (handle requests)
-    bool connection_closed = false;
+
     while (!terminate && !connection_closed) {
         try {
-            connection_closed = client->handle_request();
+            event_loop.run_once();
         } catch (const std::runtime_error &e) {
             // clang-tidy (LLVM 12.0.1) warning "Condition is always true" is not correct
             if (!terminate) std::cerr << e.what() << '\n';
@@ -380,4 +1104,8 @@ int main(int argc, char **argv) {
     if (connection_closed) std::cerr << Print_Time::iso << " INFO: Modbus Server closed connection." << '\n';
 
     std::cerr << "Terminating..." << '\n';
+    if (snapshot_signal_fd != -1) close(snapshot_signal_fd);
+    if (record_timer_fd != -1) close(record_timer_fd);
+    if (staging_timer_fd != -1) close(staging_timer_fd);
+    if (metrics_timer_fd != -1) close(metrics_timer_fd);
 }
@@ -5,47 +5,125 @@
 
 #include "modbus_shm.hpp"
 
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
 #include <stdexcept>
+#include <sys/mman.h>
+#include <system_error>
+#include <unistd.h>
 
 namespace Modbus::shm {
 
+//* maximum number of registers per table
 static constexpr std::size_t MAX_MODBUS_REGISTERS = 0x10000;
 
+//* round up to the page size
+static std::size_t page_align(std::size_t size) noexcept {
+    const auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return (size + page_size - 1) & ~(page_size - 1);
+}
+
+void Shm_Mapping::create(shm_data_t &shm, std::size_t size, std::size_t max_size, bool force, mode_t permissions) {
+    shm.fd = shm_open(shm.name.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | (force ? 0 : O_EXCL), permissions);
+    if (shm.fd == -1) throw std::system_error(errno, std::generic_category(), "failed to create '" + shm.name + "'");
+    if (ftruncate(shm.fd, static_cast<off_t>(size)))
+        throw std::system_error(errno, std::generic_category(), "failed to resize '" + shm.name + "'");
+    shm.size = size;
+
+    // reserve the address range for the maximum size
+    shm.reserved   = page_align(max_size);
+    void *reserved = mmap(nullptr, shm.reserved, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (reserved == MAP_FAILED)  // NOLINT
+        throw std::system_error(errno, std::generic_category(), "failed to reserve memory for '" + shm.name + "'");
+    shm.addr = reserved;
+
+    if (mmap(shm.addr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, shm.fd, 0) == MAP_FAILED)  // NOLINT
+        throw std::system_error(errno, std::generic_category(), "failed to map '" + shm.name + "'");
+}
+
 Shm_Mapping::Shm_Mapping(std::size_t        nb_bits,             // NOLINT
                          std::size_t        nb_input_bits,       // NOLINT
                          std::size_t        nb_registers,        // NOLINT
                          std::size_t        nb_input_registers,  // NOLINT
                          const std::string &prefix,
                          bool               force,
-                         mode_t             permissions) {
-    // check argument ranges
-    if (nb_bits > MAX_MODBUS_REGISTERS || !nb_bits)
-        throw std::invalid_argument("invalid number of digital output registers.");
-    if (nb_input_bits > MAX_MODBUS_REGISTERS || !nb_input_bits)
-        throw std::invalid_argument("invalid number of digital input registers.");
-    if (nb_registers > MAX_MODBUS_REGISTERS || !nb_registers)
-        throw std::invalid_argument("invalid number of analog output registers.");
-    if (nb_input_registers > MAX_MODBUS_REGISTERS || !nb_input_registers)
-        throw std::invalid_argument("invalid number of analog input registers.");
-
-    // set register count
-    mapping.nb_bits            = static_cast<int>(nb_bits);
-    mapping.nb_input_bits      = static_cast<int>(nb_input_bits);
-    mapping.nb_registers       = static_cast<int>(nb_registers);
-    mapping.nb_input_registers = static_cast<int>(nb_input_registers);
-
-    // create shm objects
-    shm_data[DO] = std::make_unique<cxxshm::SharedMemory>(prefix + "DO", nb_bits, false, !force, permissions);
-    shm_data[DI] = std::make_unique<cxxshm::SharedMemory>(prefix + "DI", nb_input_bits, false, !force, permissions);
-    shm_data[AO] = std::make_unique<cxxshm::SharedMemory>(prefix + "AO", 2 * nb_registers, false, !force, permissions);
-    shm_data[AI] =
-            std::make_unique<cxxshm::SharedMemory>(prefix + "AI", 2 * nb_input_registers, false, !force, permissions);
+                         mode_t             permissions)
+    : Register_Storage(nb_bits, nb_input_bits, nb_registers, nb_input_registers) {
+    // create shm objects (already created objects are removed by the destructor if one fails)
+    shm_data[DO].name = prefix + "DO";
+    shm_data[DI].name = prefix + "DI";
+    shm_data[AO].name = prefix + "AO";
+    shm_data[AI].name = prefix + "AI";
+    try {
+        create(shm_data[DO], nb_bits, MAX_MODBUS_REGISTERS, force, permissions);
+        create(shm_data[DI], nb_input_bits, MAX_MODBUS_REGISTERS, force, permissions);
+        create(shm_data[AO], 2 * nb_registers, 2 * MAX_MODBUS_REGISTERS, force, permissions);
+        create(shm_data[AI], 2 * nb_input_registers, 2 * MAX_MODBUS_REGISTERS, force, permissions);
+    } catch (const std::system_error &) {
+        release();
+        throw;
+    }
 
     // set shm objects as modbus register storage
-    mapping.tab_bits            = static_cast<uint8_t *>(shm_data[DO]->get_addr());
-    mapping.tab_input_bits      = static_cast<uint8_t *>(shm_data[DI]->get_addr());
-    mapping.tab_registers       = static_cast<uint16_t *>(shm_data[AO]->get_addr());
-    mapping.tab_input_registers = static_cast<uint16_t *>(shm_data[AI]->get_addr());
+    mapping.tab_bits            = static_cast<uint8_t *>(shm_data[DO].addr);
+    mapping.tab_input_bits      = static_cast<uint8_t *>(shm_data[DI].addr);
+    mapping.tab_registers       = static_cast<uint16_t *>(shm_data[AO].addr);
+    mapping.tab_input_registers = static_cast<uint16_t *>(shm_data[AI].addr);
+}
+
+Shm_Mapping::~Shm_Mapping() {
+    release();
+}
+
+void Shm_Mapping::release() noexcept {
+    for (auto &shm : shm_data) {
+        if (shm.addr != nullptr) munmap(shm.addr, shm.reserved);
+        if (shm.fd != -1) {
+            close(shm.fd);
+            shm_unlink(shm.name.c_str());
+        }
+        shm.addr = nullptr;
+        shm.fd   = -1;
+    }
+}
+
+void Shm_Mapping::resize(table_t table, std::size_t count) {
+    if (count == 0 || count > MAX_MODBUS_REGISTERS) throw std::invalid_argument("invalid number of registers");
+
+    auto      &shm = shm_data[table];  // NOLINT
+    int       *nb  = nullptr;
+    const bool bits = table == Modbus::DO || table == Modbus::DI;
+    switch (table) {
+        case Modbus::DO: nb = &mapping.nb_bits; break;
+        case Modbus::DI: nb = &mapping.nb_input_bits; break;
+        case Modbus::AO: nb = &mapping.nb_registers; break;
+        case Modbus::AI: nb = &mapping.nb_input_registers; break;
+        case Modbus::TABLE_COUNT:
+        default: throw std::invalid_argument("invalid table");
+    }
+    const std::size_t size     = bits ? count : 2 * count;
+    const std::size_t old_size = bits ? static_cast<std::size_t>(*nb) : 2 * static_cast<std::size_t>(*nb);
+
+    // the object is only enlarged: consumers that still use a larger size of a shrunk table access valid memory
+    if (size > shm.size) {
+        if (ftruncate(shm.fd, static_cast<off_t>(size)))
+            throw std::system_error(errno, std::generic_category(), "failed to resize '" + shm.name + "'");
+
+        // map the new size at the same address
+        if (mmap(shm.addr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, shm.fd, 0) == MAP_FAILED) {  // NOLINT
+            const int error = errno;
+            // the table keeps its size
+            [[maybe_unused]] const auto rc = ftruncate(shm.fd, static_cast<off_t>(shm.size));
+            throw std::system_error(error, std::generic_category(), "failed to map '" + shm.name + "'");
+        }
+        shm.size = size;
+    }
+
+    // registers that are added are 0 (also registers that were removed by a previous shrink)
+    if (size > old_size) std::memset(static_cast<uint8_t *>(shm.addr) + old_size, 0, size - old_size);  // NOLINT
+
+    *nb = static_cast<int>(count);
 }
 
 }  // namespace Modbus::shm
@@ -5,13 +5,13 @@
 
 #pragma once
 
-#include "cxxshm.hpp"
+#include "Register_Storage.hpp"
 #include "modbus/modbus.h"
 #include <array>
 #include <cstddef>
 #include <cstdint>
-#include <memory>
 #include <string>
+#include <sys/types.h>
 
 
 namespace Modbus::shm {
@@ -19,24 +19,31 @@ namespace Modbus::shm {
 /*! \brief class that creates a modbus_mapping_t object that uses shared memory (shm) objects.
  *
  * All required shm objects are created on construction and and deleted on destruction.
+ *
+ * Each shm object is mapped into an address range that is reserved for the maximum table size.
+ * Therefore, a table can be resized without changing its address.
  */
-class Shm_Mapping final {
+class Shm_Mapping final : public storage::Register_Storage {
 private:
     enum reg_index_t : std::uint8_t { DO, DI, AO, AI, REG_COUNT };
 
     //! data for a shared memory object
     struct shm_data_t {
-        std::string name = std::string();  //!< name of the object
-        int         fd   = -1;             //!< file descriptor
-        std::size_t size;                  //!< size in bytes
-        void       *addr = nullptr;        //!< mapped address
+        std::string name     = std::string();  //!< name of the object
+        int         fd       = -1;             //!< file descriptor
+        std::size_t size     = 0;              //!< size in bytes
+        std::size_t reserved = 0;              //!< size of the reserved address range in bytes
+        void       *addr     = nullptr;        //!< mapped address
     };
 
-    //! modbus lib storage object
-    modbus_mapping_t mapping {};
-
     //! info for all shared memory objects
-    std::array<std::unique_ptr<cxxshm::SharedMemory>, reg_index_t::REG_COUNT> shm_data;
+    std::array<shm_data_t, reg_index_t::REG_COUNT> shm_data;
+
+    //* create a shared memory object and map it into a reserved address range
+    static void create(shm_data_t &shm, std::size_t size, std::size_t max_size, bool force, mode_t permissions);
+
+    //* unmap and remove all created shared memory objects
+    void release() noexcept;
 
 public:
     /*! \brief creates a new modbus_mapping_t. Like modbus_mapping_new(), but creates shared memory objects to store its
@@ -55,6 +62,7 @@ public:
      * @param shm_name_prefix name prefix of the created shared memory object
      * @param force do not fail if the shared memory exist, but use the existing shared memory
      * @param permissions shared memory file permissions
+     * @exception std::system_error failed to create a shared memory object
      */
     Shm_Mapping(std::size_t        nb_bits,
                 std::size_t        nb_input_bits,
@@ -64,18 +72,24 @@ public:
                 bool               force,
                 mode_t             permissions);
 
-    ~Shm_Mapping() = default;
+    ~Shm_Mapping() override;
 
     Shm_Mapping(const Shm_Mapping &other)            = delete;
     Shm_Mapping(Shm_Mapping &&other)                 = delete;
     Shm_Mapping &operator=(const Shm_Mapping &other) = delete;
     Shm_Mapping &operator=(Shm_Mapping &&other)      = delete;
 
-    /*! \brief get a pointer to the created modbus_mapping_t object
+    /*! \brief change the size of a table (and its shared memory object)
+     *
+     * The shared memory object is only enlarged. If a table is shrunk, the object keeps its size and only the number
+     * of registers changes. Other processes have to map the shared memory object again (see Table_Layout).
      *
-     * @return pointer to modbus_mapping_t object
+     * @param table register table
+     * @param count new number of registers
+     * @exception std::invalid_argument invalid number of registers
+     * @exception std::system_error failed to resize the shared memory object
      */
-    modbus_mapping_t *get_mapping() { return &mapping; }
+    void resize(table_t table, std::size_t count) override;
 };
 
 }  // namespace Modbus::shm
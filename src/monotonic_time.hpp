@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+/*! \brief get the current monotonic time
+ *
+ * The value is compatible to clock_gettime(CLOCK_MONOTONIC) and can be compared with timestamps of other processes.
+ *
+ * @return monotonic time in nanoseconds
+ */
+inline std::uint64_t monotonic_ns() noexcept {
+    return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+                    .count());
+}
+
+/*! \brief get the current wall clock time
+ *
+ * The value is compatible to clock_gettime(CLOCK_REALTIME).
+ *
+ * @return time since the unix epoch in nanoseconds
+ */
+inline std::uint64_t realtime_ns() noexcept {
+    return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+                    .count());
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "unix_socket.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace Modbus {
+
+//* maximum number of pending connections
+static constexpr int LISTEN_BACKLOG = 16;
+
+//* check if a path is a socket file of a terminated instance (only such a file may be replaced)
+static bool stale_socket(const sockaddr_un &addr, int type) {
+    struct stat st {};
+    if (lstat(addr.sun_path, &st) || !S_ISSOCK(st.st_mode)) return false;  // NOLINT
+
+    const int sock = socket(AF_UNIX, type | SOCK_CLOEXEC, 0);
+    if (sock == -1) return false;
+    const bool stale = connect(sock, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) == -1 &&  // NOLINT
+                       errno == ECONNREFUSED;
+    close(sock);
+    return stale;
+}
+
+int create_unix_listener(const std::string &path, int type, mode_t permissions) {
+    sockaddr_un addr {};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path))
+        throw std::system_error(ENAMETOOLONG, std::generic_category(), "invalid socket path '" + path + "'");
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);  // NOLINT
+
+    const int fd = socket(AF_UNIX, type | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd == -1) throw std::system_error(errno, std::generic_category(), "failed to create socket '" + path + "'");
+
+    int rc = bind(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr));  // NOLINT
+    if (rc == -1 && errno == EADDRINUSE) {
+        if (stale_socket(addr, type)) {
+            unlink(path.c_str());
+            rc = bind(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr));  // NOLINT
+        } else {
+            errno = EADDRINUSE;
+        }
+    }
+    if (rc == -1) {
+        const int error = errno;
+        close(fd);
+        throw std::system_error(error, std::generic_category(), "failed to bind socket '" + path + "'");
+    }
+
+    if (chmod(path.c_str(), permissions) || listen(fd, LISTEN_BACKLOG)) {
+        const int error = errno;
+        close(fd);
+        unlink(path.c_str());
+        throw std::system_error(error, std::generic_category(), "failed to set up socket '" + path + "'");
+    }
+
+    return fd;
+}
+
+}  // namespace Modbus
@@ -0,0 +1,26 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include <string>
+#include <sys/types.h>
+
+namespace Modbus {
+
+/*! \brief create a non-blocking listening unix domain socket
+ *
+ * A stale socket file of a terminated instance (connection refused) is replaced.
+ * Any other existing file is never replaced (EADDRINUSE).
+ *
+ * @param path path of the socket
+ * @param type socket type (SOCK_STREAM or SOCK_SEQPACKET)
+ * @param permissions file permissions of the socket
+ * @return listening socket
+ * @exception std::system_error failed to create the socket
+ */
+int create_unix_listener(const std::string &path, int type, mode_t permissions);
+
+}  // namespace Modbus
@@ -0,0 +1,23 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "usdt.hpp"
+
+#ifdef USDT_ENABLED
+
+// the semaphores are located in the section .probes, the tracer finds them via the probe notes
+#    define USDT_DEFINE_SEMAPHORE(probe)                                                                               \
+        __extension__ volatile unsigned short USDT_SEMAPHORE(probe) __attribute__((unused))                            \
+        __attribute__((section(".probes"))) = 0
+
+extern "C" {
+USDT_DEFINE_SEMAPHORE(frame_received);  // NOLINT
+USDT_DEFINE_SEMAPHORE(lock_acquired);   // NOLINT
+USDT_DEFINE_SEMAPHORE(lock_released);   // NOLINT
+USDT_DEFINE_SEMAPHORE(reply_sent);      // NOLINT
+USDT_DEFINE_SEMAPHORE(error);           // NOLINT
+}
+
+#endif
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+/*! \file
+ * USDT static tracepoints of the request path (provider modbus_rtu_client_shm)
+ *
+ * The probes are compiled if the build option USDT_PROBES is enabled and sys/sdt.h is available.
+ * A probe is a nop until a tracer (bpftrace, perf, ...) attaches to it. Each probe has a semaphore that is
+ * incremented by the tracer: the arguments (e.g. the timestamps) are only evaluated while a tracer is attached.
+ *
+ * Probes (timestamp: CLOCK_MONOTONIC in nanoseconds):
+ *  - frame_received(slave, function, address, quantity, timestamp)
+ *  - lock_acquired(function, address, quantity, timestamp)
+ *  - lock_released(function, address, quantity, timestamp)
+ *  - reply_sent(slave, function, length, timestamp)        (function | 0x80: exception response)
+ *  - error(error, function, timestamp)                     (errno value, function 0: no request)
+ */
+
+#if defined(USDT_PROBES) && __has_include(<sys/sdt.h>)
+#    define USDT_ENABLED 1
+#    define _SDT_HAS_SEMAPHORES 1  // NOLINT
+#    include <sys/sdt.h>
+
+//! name of the semaphore of a probe (referenced by the probe note)
+#    define USDT_SEMAPHORE(probe) modbus_rtu_client_shm_##probe##_semaphore
+
+extern "C" {
+extern volatile unsigned short USDT_SEMAPHORE(frame_received);  // NOLINT
+extern volatile unsigned short USDT_SEMAPHORE(lock_acquired);   // NOLINT
+extern volatile unsigned short USDT_SEMAPHORE(lock_released);   // NOLINT
+extern volatile unsigned short USDT_SEMAPHORE(reply_sent);      // NOLINT
+extern volatile unsigned short USDT_SEMAPHORE(error);           // NOLINT
+}
+
+//! fire a probe (the arguments are only evaluated if a tracer is attached)
+#    define USDT(probe, ...)                                                                                           \
+        do {                                                                                                           \
+            if (__builtin_expect(USDT_SEMAPHORE(probe) != 0, 0))                                                       \
+                STAP_PROBEV(modbus_rtu_client_shm, probe, __VA_ARGS__);                                                \
+        } while (false)
+#else
+#    define USDT(probe, ...) static_cast<void>(0)
+#endif
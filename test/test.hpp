@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#pragma once
+
+#include "Modbus_Request.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <iostream>
+#include <source_location>
+#include <vector>
+
+/*! \brief minimal helpers for the unit tests
+ *
+ * Each test is an executable that is registered with ctest. A failed check is reported with its location and the
+ * test continues. The exit code of the test is EXIT_FAILURE if at least one check failed.
+ */
+namespace test {
+
+//! number of failed checks
+inline int failures = 0;
+
+/*! \brief check a condition
+ *
+ * @param condition condition that has to be true
+ * @param location location of the check (reported if the check fails)
+ */
+inline void check(bool condition, const std::source_location location = std::source_location::current()) {
+    if (condition) return;
+
+    ++failures;
+    std::cerr << location.file_name() << ':' << location.line() << ": check failed\n";
+}
+
+/*! \brief check that a function throws an exception of a specific type
+ *
+ * @param function function that has to throw
+ * @param location location of the check (reported if the check fails)
+ */
+template <typename Exception, typename Function>
+void check_throws(Function &&function, const std::source_location location = std::source_location::current()) {
+    try {
+        function();
+    } catch (const Exception &) {
+        return;
+    } catch (...) {}
+
+    check(false, location);
+}
+
+/*! \brief get the exit code of the test
+ *
+ * @return EXIT_SUCCESS if all checks passed
+ */
+inline int result() {
+    if (failures == 0) return EXIT_SUCCESS;
+
+    std::cerr << failures << " check(s) failed\n";
+    return EXIT_FAILURE;
+}
+
+/*! \brief modbus crc16 (polynomial 0xA001, initial value 0xFFFF)
+ *
+ * @param data data
+ * @param length number of bytes
+ * @return checksum (transmitted low byte first)
+ */
+inline std::uint16_t crc16(const std::uint8_t *data, std::size_t length) {
+    std::uint16_t crc = 0xFFFF;
+    for (std::size_t i = 0; i < length; ++i) {
+        crc ^= data[i];  // NOLINT
+        for (int bit = 0; bit < 8; ++bit)
+            crc = static_cast<std::uint16_t>(crc & 1U ? (crc >> 1U) ^ 0xA001U : crc >> 1U);  // NOLINT
+    }
+    return crc;
+}
+
+//! rtu frame (slave id, pdu and checksum)
+class Frame final {
+private:
+    std::vector<std::uint8_t> adu;
+
+    void append_checksum() {
+        const auto crc = crc16(adu.data(), adu.size());
+        adu.insert(adu.end(), {static_cast<std::uint8_t>(crc), static_cast<std::uint8_t>(crc >> 8U)});
+    }
+
+public:
+    Frame(std::uint8_t slave, std::initializer_list<std::uint8_t> pdu) : adu {slave} {
+        adu.insert(adu.end(), pdu.begin(), pdu.end());
+        append_checksum();
+    }
+
+    //! append bytes to the pdu
+    void append(std::initializer_list<std::uint8_t> bytes) {
+        adu.resize(adu.size() - 2);
+        adu.insert(adu.end(), bytes.begin(), bytes.end());
+        append_checksum();
+    }
+
+    //! decode the frame (the frame must outlive the request)
+    [[nodiscard]] Modbus::Request request() const { return {adu.data(), static_cast<int>(adu.size()), 1}; }
+
+    //! get the frame (starting with the slave id)
+    [[nodiscard]] const std::uint8_t *data() const noexcept { return adu.data(); }
+
+    //! get the length of the frame (including the checksum)
+    [[nodiscard]] std::size_t size() const noexcept { return adu.size(); }
+};
+
+}  // namespace test
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Alias_Map.hpp"
+
+#include "test.hpp"
+
+#include <array>
+#include <stdexcept>
+
+using Modbus::Alias_Map;
+using test::check;
+using test::Frame;
+
+int main() {
+    std::array<std::uint8_t, 16>   bits {};
+    std::array<std::uint8_t, 16>   input_bits {};
+    std::array<std::uint16_t, 200> registers {};
+    std::array<std::uint16_t, 200> input_registers {};
+
+    modbus_mapping_t mapping {};
+    mapping.nb_bits             = static_cast<int>(bits.size());
+    mapping.nb_input_bits       = static_cast<int>(input_bits.size());
+    mapping.nb_registers        = static_cast<int>(registers.size());
+    mapping.nb_input_registers  = static_cast<int>(input_registers.size());
+    mapping.tab_bits            = bits.data();
+    mapping.tab_input_bits      = input_bits.data();
+    mapping.tab_registers       = registers.data();
+    mapping.tab_input_registers = input_registers.data();
+
+    Alias_Map aliases(mapping);
+    check(aliases.empty());
+
+    // invalid definitions
+    test::check_throws<std::invalid_argument>([&] { aliases.add("AI:100-199"); });
+    test::check_throws<std::invalid_argument>([&] { aliases.add("DI:0-3=AO:0"); });
+    test::check_throws<std::invalid_argument>([&] { aliases.add("AO:100-109=AI:0"); });
+    test::check_throws<std::invalid_argument>([&] { aliases.add("AI:300-399=AO:150"); });
+    check(aliases.empty());
+
+    aliases.add("AI:100-199=AO:0");
+    aliases.add("AO:1000-1009=AO:10");
+    aliases.add("DI:50-53=DO:4");
+    check(!aliases.empty());
+    test::check_throws<std::invalid_argument>([&] { aliases.add("AI:150-250=AI:0"); });
+
+    modbus_mapping_t view {};
+
+    // read completely inside a window: served from the source table
+    {
+        const Frame     frame(1, {MODBUS_FC_READ_INPUT_REGISTERS, 0x00, 0x6E, 0x00, 0x0A});  // AI 110, 10 registers
+        const auto      request    = frame.request();
+        Modbus::Request translated = request;
+        check(aliases.resolve(request, view, translated));
+        check(view.start_input_registers == 100);
+        check(view.nb_input_registers == 100);
+        check(view.tab_input_registers == registers.data());
+        check(request.validate(view) == 0);
+        check(translated.read_table() == Modbus::AO);
+        check(translated.address == 10);
+        check(translated.quantity == 10);
+    }
+
+    // read partially inside a window: illegal data address
+    {
+        const Frame     frame(1, {MODBUS_FC_READ_INPUT_REGISTERS, 0x00, 0x5F, 0x00, 0x0A});  // AI 95, 10 registers
+        const auto      request    = frame.request();
+        Modbus::Request translated = request;
+        check(aliases.resolve(request, view, translated));
+        check(view.nb_input_registers == 0);
+        check(request.validate(view) == MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS);
+        check(translated.address == 95);
+    }
+
+    // read outside of all windows: served from the table itself
+    {
+        const Frame     frame(1, {MODBUS_FC_READ_INPUT_REGISTERS, 0x00, 0x00, 0x00, 0x0A});
+        const auto      request    = frame.request();
+        Modbus::Request translated = request;
+        check(!aliases.resolve(request, view, translated));
+    }
+
+    // write inside a window of a writable table
+    {
+        const Frame     frame(1, {MODBUS_FC_WRITE_SINGLE_REGISTER, 0x03, 0xED, 0x12, 0x34});  // AO 1005
+        const auto      request    = frame.request();
+        Modbus::Request translated = request;
+        check(aliases.resolve(request, view, translated));
+        check(view.start_registers == 1000);
+        check(view.nb_registers == 10);
+        check(view.tab_registers == registers.data() + 10);
+        check(translated.write_table() == Modbus::AO);
+        check(translated.write_address == 15);
+    }
+
+    // discrete inputs served from coils
+    {
+        const Frame     frame(1, {MODBUS_FC_READ_DISCRETE_INPUTS, 0x00, 0x32, 0x00, 0x04});  // DI 50, 4 inputs
+        const auto      request    = frame.request();
+        Modbus::Request translated = request;
+        check(aliases.resolve(request, view, translated));
+        check(view.start_input_bits == 50);
+        check(view.tab_input_bits == bits.data() + 4);
+        check(translated.read_table() == Modbus::DO);
+        check(translated.address == 4);
+    }
+
+    return test::result();
+}
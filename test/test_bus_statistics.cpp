@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Bus_Statistics.hpp"
+
+#include "test.hpp"
+
+#include <modbus_rtu_client_shm/consumer.hpp>
+
+#include <cmath>
+#include <string>
+#include <unistd.h>
+
+using test::check;
+
+//* time between two frames in nanoseconds
+static constexpr std::uint64_t FRAME_INTERVAL = 10'000'000;
+
+int main() {
+    const std::string prefix = "modbus_rtu_client_shm_test_" + std::to_string(getpid()) + '_';
+
+    Modbus::shm::Bus_Statistics statistics(prefix + "bus_stats", 19200, 8, 'E', 1, false, 0600);
+    const Modbus::consumer::Bus_Statistics consumer(prefix);
+
+    std::uint64_t timestamp = FRAME_INTERVAL;
+
+    // duration of a frame (19200 baud, 11 bits per character)
+    const auto duration = [](int length) {
+        return static_cast<std::uint64_t>(std::llround(length * 11 * 1e9 / 19200));  // NOLINT
+    };
+
+    // frames are accounted with the length that was received
+    statistics.foreign(8, timestamp += FRAME_INTERVAL);
+    statistics.foreign(13, timestamp += FRAME_INTERVAL);
+    statistics.error(11, timestamp += FRAME_INTERVAL);
+    auto stats = consumer.read();
+    check(stats.has_value());
+    if (stats) {
+        check(stats->foreign.frames == 2);
+        check(stats->foreign.bytes == 21);
+        check(stats->errors.frames == 1);
+        check(stats->errors.bytes == 11);
+        check(stats->requests.frames == 0);
+        check(stats->busy_time == duration(8) + duration(13) + duration(11));
+        check(stats->first_frame == 2 * FRAME_INTERVAL - duration(8));
+        check(stats->last_frame == 4 * FRAME_INTERVAL);
+
+        // gaps of 4.4 and 6.4 character times
+        check(stats->gaps == 2);
+        check(stats->gap_min == FRAME_INTERVAL - duration(13));
+        check(stats->gap_max == FRAME_INTERVAL - duration(11));
+        check(stats->gap_histogram[1] == 1 && stats->gap_histogram[2] == 1);
+    }
+
+    // back-to-back frames: no gap, frames that seem to overlap (wake-up latency) are not counted as negative gaps
+    statistics.foreign(8, timestamp += duration(8));
+    statistics.foreign(8, timestamp += duration(8) / 2);
+    stats = consumer.read();
+    check(stats.has_value());
+    if (stats) {
+        check(stats->gaps == 4);
+        check(stats->gap_min == 0);
+        check(stats->gap_histogram[0] == 2);
+    }
+
+    return test::result();
+}
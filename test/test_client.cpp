@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Modbus_RTU_Client.hpp"
+
+#include "test.hpp"
+
+#include <modbus_rtu_client_shm/consumer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <poll.h>
+#include <span>
+#include <string>
+#include <system_error>
+#include <termios.h>
+#include <unistd.h>
+#include <vector>
+
+using Modbus::RTU::Client;
+using test::check;
+using test::Frame;
+
+//* id of the client
+static constexpr std::uint8_t SLAVE = 1;
+
+//* time to wait for the first byte of a response in milliseconds
+static constexpr int RESPONSE_TIMEOUT = 200;
+
+//* silence after the last byte of a response in milliseconds
+static constexpr int RESPONSE_END = 20;
+
+//! master side of a pseudo terminal (the client is connected to the slave side)
+class Bus final {
+private:
+    int         fd;
+    std::string device;
+
+public:
+    Bus() : fd(posix_openpt(O_RDWR | O_NOCTTY)) {
+        if (fd == -1 || grantpt(fd) || unlockpt(fd))
+            throw std::system_error(errno, std::generic_category(), "failed to open pseudo terminal");
+        device = ptsname(fd);  // NOLINT
+
+        termios tio {};
+        tcgetattr(fd, &tio);
+        cfmakeraw(&tio);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    ~Bus() { close(fd); }
+
+    Bus(const Bus &other)            = delete;
+    Bus(Bus &&other)                 = delete;
+    Bus &operator=(const Bus &other) = delete;
+    Bus &operator=(Bus &&other)      = delete;
+
+    [[nodiscard]] const std::string &get_device() const noexcept { return device; }
+
+    //* send raw bytes to the client
+    void send(const std::uint8_t *data, std::size_t size) const {
+        while (size) {
+            const auto written = write(fd, data, size);
+            if (written == -1) throw std::system_error(errno, std::generic_category(), "failed to write");
+            data += written;  // NOLINT
+            size -= static_cast<std::size_t>(written);
+        }
+    }
+
+    //* send a frame to the client
+    void send(const Frame &frame) const { send(frame.data(), frame.size()); }
+
+    //* receive the response of the client (pdu, empty: no response or invalid response)
+    [[nodiscard]] std::vector<std::uint8_t> receive() const {
+        std::vector<std::uint8_t> adu;
+        pollfd                    pfd {fd, POLLIN, 0};
+        while (poll(&pfd, 1, adu.empty() ? RESPONSE_TIMEOUT : RESPONSE_END) == 1) {
+            std::array<std::uint8_t, MODBUS_RTU_MAX_ADU_LENGTH> buffer {};
+            const auto                                          received = read(fd, buffer.data(), buffer.size());
+            if (received <= 0) break;
+            adu.insert(adu.end(), buffer.begin(), buffer.begin() + received);
+        }
+
+        if (adu.size() < 4 || adu[0] != SLAVE) return {};
+        const auto crc = test::crc16(adu.data(), adu.size() - 2);
+        if (adu[adu.size() - 2] != static_cast<std::uint8_t>(crc) || adu.back() != crc >> 8U) return {};
+        return {adu.begin() + 1, adu.end() - 2};
+    }
+};
+
+//* diagnostics request with one data word
+static Frame diagnostics_request(std::uint16_t sub_function, std::uint16_t data = 0, std::uint8_t slave = SLAVE) {
+    return {slave,
+            {Modbus::Diagnostics::FUNCTION_CODE,
+             static_cast<std::uint8_t>(sub_function >> 8),
+             static_cast<std::uint8_t>(sub_function),
+             static_cast<std::uint8_t>(data >> 8),
+             static_cast<std::uint8_t>(data)}};
+}
+
+int main() {
+    const Bus bus;
+
+    std::array<std::uint16_t, 16> registers {};
+    modbus_mapping_t              mapping {};
+    mapping.nb_registers  = static_cast<int>(registers.size());
+    mapping.tab_registers = registers.data();
+
+    Client client(bus.get_device(), SLAVE, 'N', 8, 1, 19200, false, false, &mapping);  // NOLINT
+    client.enable_diagnostics(std::make_unique<Modbus::Diagnostics>());
+
+    const auto id_path = std::filesystem::temp_directory_path() /
+                         ("modbus_rtu_client_shm_test_" + std::to_string(getpid()) + ".id");
+    std::ofstream(id_path) << "VendorName=v\nProductCode=p\nMajorMinorRevision=1\n";
+    client.enable_device_identification(std::make_unique<Modbus::Device_Identification>(id_path.string()));
+    std::filesystem::remove(id_path);
+
+    const auto files_path = std::filesystem::temp_directory_path() /
+                            ("modbus_rtu_client_shm_test_" + std::to_string(getpid()) + ".files");
+    std::filesystem::create_directory(files_path);
+    std::ofstream(files_path / "7") << "ABCD";
+    client.enable_file_records(std::make_unique<Modbus::File_Records>(files_path.string()));
+
+    const std::string fifo_prefix = "modbus_rtu_client_shm_test_" + std::to_string(getpid()) + '_';
+    auto              queues      = std::make_unique<Modbus::shm::Fifo_Queues>(fifo_prefix, false, 0600, false);
+    queues->add("100:8");
+    client.enable_fifo_queues(std::move(queues));
+
+    // send a frame, let the client handle it and return the response
+    const auto exchange = [&](const Frame &frame) {
+        bus.send(frame);
+        check(!client.handle_request());
+        return bus.receive();
+    };
+
+    //* counter of the diagnostics
+    const auto counter = [&](std::uint16_t sub_function) -> int {
+        const auto response = exchange(diagnostics_request(sub_function));
+        if (response.size() != 5) return -1;
+        return (response[3] << 8) | response[4];
+    };
+
+    // request length derived from the sub-function
+    check(exchange(diagnostics_request(0x0B)) == std::vector<std::uint8_t>({0x08, 0x00, 0x0B, 0x00, 0x01}));
+
+    // return query data with data of any length: the frame ends with the silent interval
+    check(exchange(Frame(SLAVE, {0x08, 0x00, 0x00, 0x12, 0x34, 0x56})) ==
+          std::vector<std::uint8_t>({0x08, 0x00, 0x00, 0x12, 0x34, 0x56}));
+
+    // requests that are served by libmodbus
+    check(exchange(Frame(SLAVE, {MODBUS_FC_WRITE_SINGLE_REGISTER, 0x00, 0x02, 0xAB, 0xCD})) ==
+          std::vector<std::uint8_t>({MODBUS_FC_WRITE_SINGLE_REGISTER, 0x00, 0x02, 0xAB, 0xCD}));
+    check(registers[2] == 0xABCD);
+
+    // two requests without gap: the second request is not consumed by the first one
+    {
+        const Frame first  = diagnostics_request(0x0E);
+        const Frame second = diagnostics_request(0x0B);
+        std::vector<std::uint8_t> both(first.data(), first.data() + first.size());
+        both.insert(both.end(), second.data(), second.data() + second.size());
+        bus.send(both.data(), both.size());
+
+        check(!client.handle_request());
+        check(bus.receive() == std::vector<std::uint8_t>({0x08, 0x00, 0x0E, 0x00, 0x04}));
+        check(!client.handle_request());
+        check(bus.receive() == std::vector<std::uint8_t>({0x08, 0x00, 0x0B, 0x00, 0x05}));
+    }
+
+    // read device identification (individual access) followed by another request without gap
+    {
+        const Frame first(SLAVE, {0x2B, 0x0E, 0x04, 0x01});
+        const Frame second = diagnostics_request(0x0E);
+        std::vector<std::uint8_t> both(first.data(), first.data() + first.size());
+        both.insert(both.end(), second.data(), second.data() + second.size());
+        bus.send(both.data(), both.size());
+
+        check(!client.handle_request());
+        check(bus.receive() == std::vector<std::uint8_t>({0x2B, 0x0E, 0x04, 0x81, 0x00, 0x00, 0x01, 0x01, 0x01, 'p'}));
+        check(!client.handle_request());
+        check(bus.receive() == std::vector<std::uint8_t>({0x08, 0x00, 0x0E, 0x00, 0x07}));
+    }
+
+    // read and write file record requests without gap (length from the byte count)
+    {
+        const Frame read(SLAVE, {0x14, 0x07, 0x06, 0x00, 0x07, 0x00, 0x00, 0x00, 0x02});
+        const Frame write(SLAVE, {0x15, 0x09, 0x06, 0x00, 0x07, 0x00, 0x01, 0x00, 0x01, 'x', 'y'});
+        std::vector<std::uint8_t> both(read.data(), read.data() + read.size());
+        both.insert(both.end(), write.data(), write.data() + write.size());
+        bus.send(both.data(), both.size());
+
+        check(!client.handle_request());
+        check(bus.receive() == std::vector<std::uint8_t>({0x14, 0x06, 0x05, 0x06, 'A', 'B', 'C', 'D'}));
+        check(!client.handle_request());
+        check(bus.receive() == std::vector<std::uint8_t>(write.data() + 1, write.data() + write.size() - 2));
+        check(exchange(read) == std::vector<std::uint8_t>({0x14, 0x06, 0x05, 0x06, 'A', 'B', 'x', 'y'}));
+    }
+
+    // read fifo queue request (3 byte pdu) followed by another request without gap
+    {
+        Modbus::consumer::Fifo_Producer producer(fifo_prefix, 100);  // NOLINT
+        std::array<std::uint16_t, 2>    values {0x1111, 0x2222};
+        check(producer.push(std::span(values)));
+
+        const Frame first(SLAVE, {0x18, 0x00, 0x64});
+        const Frame second = diagnostics_request(0x0E);
+        std::vector<std::uint8_t> both(first.data(), first.data() + first.size());
+        both.insert(both.end(), second.data(), second.data() + second.size());
+        bus.send(both.data(), both.size());
+
+        check(!client.handle_request());
+        check(bus.receive() == std::vector<std::uint8_t>({0x18, 0x00, 0x06, 0x00, 0x02, 0x11, 0x11, 0x22, 0x22}));
+        check(!client.handle_request());
+        check(bus.receive() == std::vector<std::uint8_t>({0x08, 0x00, 0x0E, 0x00, 0x0C}));
+    }
+
+    // vendor specific function codes with payload: the frame ends with the silent interval
+    {
+        std::vector<std::uint8_t> handled;
+        const auto                echo = [&handled](const Modbus::Request &request, std::uint8_t *response) {
+            const auto *pdu = request.get_pdu();
+            handled.assign(pdu, pdu + request.get_pdu_length());  // NOLINT
+            std::copy(handled.begin(), handled.end(), response);
+            return request.get_pdu_length();
+        };
+        client.set_function_handler(65, echo);   // NOLINT
+        client.set_function_handler(100, echo);  // NOLINT
+
+        const Frame vendor(SLAVE, {65, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A});
+        check(exchange(vendor) == std::vector<std::uint8_t>(vendor.data() + 1, vendor.data() + vendor.size() - 2));
+        check(handled.size() == 11);
+
+        check(exchange(Frame(SLAVE, {100, 0xFF})) == std::vector<std::uint8_t>({100, 0xFF}));
+        check(exchange(Frame(SLAVE, {100})) == std::vector<std::uint8_t>({100}));
+    }
+
+    // frames to other slaves are counted, but not answered
+    check(exchange(Frame(2, {MODBUS_FC_READ_HOLDING_REGISTERS, 0x00, 0x00, 0x00, 0x01})).empty());
+    check(exchange(Frame(2, {MODBUS_FC_READ_HOLDING_REGISTERS, 0x02, 0x12, 0x34})).empty());
+    check(counter(0x0B) == 18);
+
+    // frames with checksum error are counted and ignored
+    {
+        Frame frame = diagnostics_request(0x0B);
+        std::vector<std::uint8_t> corrupted(frame.data(), frame.data() + frame.size());
+        corrupted.back() ^= 0xFFU;
+        bus.send(corrupted.data(), corrupted.size());
+        check(!client.handle_request());
+        check(bus.receive().empty());
+        check(counter(0x0C) == 1);
+    }
+
+    // incomplete frames are invalid
+    {
+        client.set_byte_timeout(0.05);  // NOLINT
+        const Frame frame = diagnostics_request(0x0B);
+        bus.send(frame.data(), frame.size() - 1);
+        check(!client.handle_request());
+        check(bus.receive().empty());
+        check(counter(0x0C) == 2);
+    }
+
+    std::filesystem::remove_all(files_path);
+
+    // without diagnostics: invalid frames are ignored if they are counted by the bus statistics
+    {
+        const Bus other_bus;
+        Client    other(other_bus.get_device(), SLAVE, 'N', 8, 1, 19200, false, false, &mapping);  // NOLINT
+        other.enable_bus_statistics(std::make_unique<Modbus::shm::Bus_Statistics>(
+                fifo_prefix + "bus_stats", 19200, 8, 'N', 1, false, 0600));  // NOLINT
+        const Modbus::consumer::Bus_Statistics statistics(fifo_prefix);
+
+        Frame                     frame = diagnostics_request(0x0B);
+        std::vector<std::uint8_t> corrupted(frame.data(), frame.data() + frame.size());
+        corrupted.back() ^= 0xFFU;
+        other_bus.send(corrupted.data(), corrupted.size());
+        check(!other.handle_request());
+
+        // frames to other slaves are accounted with their received length
+        other_bus.send(Frame(2, {0x41, 0x01, 0x02, 0x03}));
+        check(!other.handle_request());
+
+        const auto stats = statistics.read();
+        check(stats.has_value());
+        if (stats) {
+            check(stats->errors.frames == 1 && stats->errors.bytes == 8);
+            check(stats->foreign.frames == 1 && stats->foreign.bytes == 7);
+        }
+    }
+
+    // without diagnostics: invalid frames are ignored if they are counted by the metrics
+    {
+        const Bus other_bus;
+        Client    other(other_bus.get_device(), SLAVE, 'N', 8, 1, 19200, false, false, &mapping);  // NOLINT
+        auto      metrics = std::make_unique<Modbus::Metrics>(19200, 8, 'N', 1);                   // NOLINT
+        const Modbus::Metrics &counted = *metrics;
+        other.enable_metrics(std::move(metrics));
+
+        other.set_byte_timeout(0.05);  // NOLINT
+        const Frame frame = diagnostics_request(0x0B);
+        other_bus.send(frame.data(), frame.size() - 1);
+        check(!other.handle_request());
+        check(counted.render_prometheus(mapping).find("\nmodbus_checksum_errors_total 1\n") != std::string::npos);
+    }
+
+    return test::result();
+}
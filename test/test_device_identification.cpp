@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Device_Identification.hpp"
+
+#include "test.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using Modbus::Device_Identification;
+using test::check;
+using test::Frame;
+
+//! pdu of a response
+using pdu_t = std::vector<std::uint8_t>;
+
+//* write an identification file
+static void write_file(const std::filesystem::path &path, const std::string &content) {
+    std::ofstream file(path);
+    file << content;
+}
+
+//* read device identification request
+static pdu_t response(const Device_Identification &identification, std::uint8_t code, std::uint8_t object) {
+    const Frame frame(1, {Device_Identification::FUNCTION_CODE, Device_Identification::MEI_TYPE, code, object});
+    const auto  pdu = identification.response(frame.request());
+    return {pdu.begin(), pdu.end()};
+}
+
+int main() {
+    const auto path = std::filesystem::temp_directory_path() /
+                      ("modbus_rtu_client_shm_test_" + std::to_string(getpid()) + ".id");
+
+    // mandatory objects
+    write_file(path, "VendorName=vendor\nProductCode=code\n");
+    test::check_throws<std::runtime_error>([&] { const Device_Identification identification(path.string()); });
+
+    // reserved object ids and duplicates
+    write_file(path, "VendorName=a\nProductCode=b\nMajorMinorRevision=c\n0x10=d\n");
+    test::check_throws<std::runtime_error>([&] { const Device_Identification identification(path.string()); });
+    write_file(path, "VendorName=a\nVendorName=a\nProductCode=b\nMajorMinorRevision=c\n");
+    test::check_throws<std::runtime_error>([&] { const Device_Identification identification(path.string()); });
+
+    write_file(path,
+               "# comment\n"
+               "VendorName = ab\n"
+               "\n"
+               "ProductCode=c\n"
+               "MajorMinorRevision=1.0\n"
+               "ProductName=p\n"
+               "0x80=x\n");
+    const Device_Identification identification(path.string());
+    std::filesystem::remove(path);
+
+    // basic stream access: mandatory objects, conformity level 3 (extended objects) with individual access
+    check(response(identification, 1, 0) ==
+          pdu_t({0x2B, 0x0E, 0x01, 0x83, 0x00, 0x00, 0x03,  // header: 3 objects
+                 0x00, 0x02, 'a',  'b',                    // VendorName
+                 0x01, 0x01, 'c',                          // ProductCode
+                 0x02, 0x03, '1',  '.',  '0'}));           // MajorMinorRevision
+
+    // regular stream access starting with an object id
+    check(response(identification, 2, 0x02) ==
+          pdu_t({0x2B, 0x0E, 0x02, 0x83, 0x00, 0x00, 0x02, 0x02, 0x03, '1', '.', '0', 0x04, 0x01, 'p'}));
+
+    // unknown first object: the stream starts with the first object
+    check(response(identification, 3, 0x03) == response(identification, 3, 0x00));
+    check(response(identification, 3, 0x00).back() == 'x');
+
+    // individual access
+    check(response(identification, 4, 0x80) == pdu_t({0x2B, 0x0E, 0x04, 0x83, 0x00, 0x00, 0x01, 0x80, 0x01, 'x'}));
+    check(response(identification, 4, 0x03) == pdu_t({0xAB, MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS}));
+
+    // invalid read device id code
+    check(response(identification, 5, 0x00) == pdu_t({0xAB, MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE}));
+
+    // other function codes and MEI types are not handled
+    check(identification.response(Frame(1, {0x2B, 0x0D, 0x01, 0x00}).request()).empty());
+    check(identification.response(Frame(1, {MODBUS_FC_READ_HOLDING_REGISTERS, 0x00, 0x00, 0x00, 0x01}).request())
+                  .empty());
+
+    return test::result();
+}
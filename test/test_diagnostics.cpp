@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Diagnostics.hpp"
+
+#include "test.hpp"
+
+#include <array>
+#include <vector>
+
+using Modbus::Diagnostics;
+using test::check;
+using test::Frame;
+
+//! response of a request (empty: not served or no response)
+struct response_t {
+    bool                      served = false;  //!< request was not ignored (listen only mode)
+    std::vector<std::uint8_t> pdu;             //!< response pdu
+};
+
+//* pass a request to the diagnostics (like the client: receive, then reply)
+static response_t process(Diagnostics &diagnostics, const Frame &frame) {
+    response_t result;
+    const auto request = frame.request();
+    result.served      = diagnostics.receive(request);
+    if (!result.served) return result;
+
+    std::array<std::uint8_t, MODBUS_MAX_PDU_LENGTH> response {};
+    const int                                       length = diagnostics.reply(request, response.data());
+    if (length > 0) result.pdu.assign(response.begin(), response.begin() + length);
+    return result;
+}
+
+//* diagnostics request with one data word
+static Frame diagnostics_request(std::uint16_t sub_function, std::uint16_t data = 0, std::uint8_t slave = 1) {
+    return {slave,
+            {Diagnostics::FUNCTION_CODE,
+             static_cast<std::uint8_t>(sub_function >> 8),
+             static_cast<std::uint8_t>(sub_function),
+             static_cast<std::uint8_t>(data >> 8),
+             static_cast<std::uint8_t>(data)}};
+}
+
+//* get the counter of a counter sub-function
+static int counter(Diagnostics &diagnostics, std::uint16_t sub_function) {
+    const auto result = process(diagnostics, diagnostics_request(sub_function));
+    if (result.pdu.size() != 5) return -1;
+    return (result.pdu[3] << 8) | result.pdu[4];
+}
+
+int main() {
+    Diagnostics diagnostics;
+
+    // return query data: echo of the request
+    {
+        const Frame frame(1, {Diagnostics::FUNCTION_CODE, 0x00, 0x00, 0x12, 0x34, 0x56});
+        const auto  result = process(diagnostics, frame);
+        check(result.pdu == std::vector<std::uint8_t>({Diagnostics::FUNCTION_CODE, 0x00, 0x00, 0x12, 0x34, 0x56}));
+    }
+
+    // counters (the counter request itself is counted)
+    diagnostics.count_bus_message();
+    diagnostics.count_bus_error();
+    diagnostics.count_exception();
+    check(counter(diagnostics, 0x0B) == 4);  // bus messages: 2 requests, foreign frame, checksum error
+    check(counter(diagnostics, 0x0C) == 1);  // bus communication errors
+    check(counter(diagnostics, 0x0D) == 1);  // bus exception errors
+    check(counter(diagnostics, 0x0E) == 5);  // server messages
+    check(counter(diagnostics, 0x0F) == 0);  // server no responses
+    check(counter(diagnostics, 0x10) == 0);  // server NAK (not supported: always 0)
+
+    // broadcasts are not answered
+    static_cast<void>(process(diagnostics, diagnostics_request(0x0B, 0, 0)));
+    check(counter(diagnostics, 0x0F) == 1);
+
+    // clear counters
+    check(process(diagnostics, diagnostics_request(0x0A)).pdu.size() == 5);
+    check(counter(diagnostics, 0x0B) == 1);
+    check(counter(diagnostics, 0x0C) == 0);
+
+    // invalid requests
+    {
+        auto result = process(diagnostics, diagnostics_request(0x0B, 1));
+        check(result.pdu == std::vector<std::uint8_t>({Diagnostics::FUNCTION_CODE | 0x80,
+                                                       MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE}));
+        result = process(diagnostics, diagnostics_request(0x03));
+        check(result.pdu ==
+              std::vector<std::uint8_t>({Diagnostics::FUNCTION_CODE | 0x80, MODBUS_EXCEPTION_ILLEGAL_FUNCTION}));
+        result = process(diagnostics, Frame(1, {Diagnostics::FUNCTION_CODE, 0x00}));
+        check(result.pdu == std::vector<std::uint8_t>({Diagnostics::FUNCTION_CODE | 0x80,
+                                                       MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE}));
+    }
+
+    // other function codes are not handled
+    {
+        const Frame                                     frame(1, {MODBUS_FC_READ_HOLDING_REGISTERS, 0, 0, 0, 1});
+        std::array<std::uint8_t, MODBUS_MAX_PDU_LENGTH> response {};
+        check(diagnostics.reply(frame.request(), response.data()) == -1);
+    }
+
+    // force listen only mode: no response, all requests except restart communications are ignored
+    check(process(diagnostics, diagnostics_request(0x04)).pdu.empty());
+    check(!process(diagnostics, Frame(1, {MODBUS_FC_READ_HOLDING_REGISTERS, 0, 0, 0, 1})).served);
+    check(!process(diagnostics, diagnostics_request(0x0B)).served);
+
+    // restart communications: leaves listen only mode without response and clears the counters
+    {
+        const auto result = process(diagnostics, diagnostics_request(0x01));
+        check(result.served);
+        check(result.pdu.empty());
+    }
+    check(counter(diagnostics, 0x0B) == 1);
+
+    // restart communications outside of listen only mode is answered
+    check(process(diagnostics, diagnostics_request(0x01, 0xFF00)).pdu.size() == 5);
+    check(process(diagnostics, diagnostics_request(0x01, 0x1234)).pdu ==
+          std::vector<std::uint8_t>({Diagnostics::FUNCTION_CODE | 0x80, MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE}));
+
+    return test::result();
+}
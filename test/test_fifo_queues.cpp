@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Fifo_Queues.hpp"
+
+#include "test.hpp"
+
+#include <modbus_rtu_client_shm/consumer.hpp>
+
+#include <array>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using Modbus::shm::Fifo_Queues;
+using test::check;
+using test::Frame;
+
+//* read fifo queue request for the queue with fifo pointer address 100
+static const Frame READ_FIFO(1, {Fifo_Queues::FUNCTION_CODE, 0x00, 0x64});
+
+//* get the values of a read fifo queue response
+static std::vector<std::uint16_t> values(const std::uint8_t *response, int length) {
+    std::vector<std::uint16_t> result;
+    for (int i = 5; i + 1 < length; i += 2)
+        result.push_back(static_cast<std::uint16_t>((response[i] << 8) | response[i + 1]));  // NOLINT
+    return result;
+}
+
+int main() {
+    const std::string prefix = "modbus_rtu_client_shm_test_" + std::to_string(getpid()) + '_';
+
+    Fifo_Queues queues(prefix, false, 0600, false);
+    test::check_throws<std::invalid_argument>([&] { queues.add("100:6"); });
+    test::check_throws<std::invalid_argument>([&] { queues.add("100x"); });
+    queues.add("100:8");
+    test::check_throws<std::invalid_argument>([&] { queues.add("100:16"); });
+
+    Modbus::consumer::Fifo_Producer producer(prefix, 100);
+    check(producer.available() == 8);
+
+    std::array<std::uint8_t, MODBUS_MAX_PDU_LENGTH> response {};
+
+    // empty queue
+    int length = queues.reply(READ_FIFO.request(), response.data());
+    check(length == 5);
+    check(response[0] == Fifo_Queues::FUNCTION_CODE);
+    check(response[2] == 2 && response[4] == 0);
+
+    // fill the ring several times: the positions wrap around the capacity
+    std::uint16_t next     = 0;
+    std::uint16_t expected = 0;
+    for (int round = 0; round < 10; ++round) {
+        std::array<std::uint16_t, 5> pushed {};
+        for (auto &value : pushed)
+            value = next++;
+        check(producer.push(std::span(pushed)));
+
+        length = queues.reply(READ_FIFO.request(), response.data());
+        check(length == 5 + 2 * 5);
+        check(response[2] == 2 + 2 * 5 && response[4] == 5);
+        for (const auto value : values(response.data(), length))
+            check(value == expected++);
+        check(producer.available() == 8);
+    }
+
+    // a full ring can not be overwritten
+    std::array<std::uint16_t, 9> too_many {};
+    check(!producer.push(std::span(too_many)));
+    std::array<std::uint16_t, 8> full {1, 2, 3, 4, 5, 6, 7, 8};
+    check(producer.push(std::span(full)));
+    check(producer.available() == 0);
+    length = queues.reply(READ_FIFO.request(), response.data());
+    check(values(response.data(), length) == std::vector<std::uint16_t>(full.begin(), full.end()));
+
+    // broadcasts are not answered and do not consume registers
+    check(producer.push(std::span(full)));
+    const Frame broadcast(0, {Fifo_Queues::FUNCTION_CODE, 0x00, 0x64});
+    check(queues.reply(broadcast.request(), response.data()) == 0);
+    check(producer.available() == 0);
+
+    // unknown queue, invalid request, other function code
+    const Frame unknown(1, {Fifo_Queues::FUNCTION_CODE, 0x00, 0x65});
+    check(queues.reply(unknown.request(), response.data()) == 2);
+    check(response[0] == (Fifo_Queues::FUNCTION_CODE | 0x80) && response[1] == MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS);
+    const Frame invalid(1, {Fifo_Queues::FUNCTION_CODE, 0x00});
+    check(queues.reply(invalid.request(), response.data()) == 2);
+    check(response[1] == MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+    const Frame other(1, {MODBUS_FC_READ_HOLDING_REGISTERS, 0x00, 0x00, 0x00, 0x01});
+    check(queues.reply(other.request(), response.data()) == -1);
+
+    return test::result();
+}
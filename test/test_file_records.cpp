@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "File_Records.hpp"
+
+#include "test.hpp"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using Modbus::File_Records;
+using test::check;
+using test::Frame;
+
+//! pdu of a response
+using pdu_t = std::vector<std::uint8_t>;
+
+//* write a file
+static void write_file(const std::filesystem::path &path, const pdu_t &content) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(content.data()), static_cast<std::streamsize>(content.size()));  // NOLINT
+}
+
+//* read a file
+static pdu_t read_file(const std::filesystem::path &path) {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+//* pass a request to the file records
+static pdu_t process(File_Records &records, const Frame &frame) {
+    std::array<std::uint8_t, MODBUS_MAX_PDU_LENGTH> response {};
+    const int                                       length = records.reply(frame.request(), response.data());
+    if (length < 0) return {};
+    return {response.begin(), response.begin() + length};
+}
+
+int main() {
+    const auto directory = std::filesystem::temp_directory_path() /
+                           ("modbus_rtu_client_shm_test_" + std::to_string(getpid()) + ".files");
+    std::filesystem::create_directory(directory);
+
+    // file numbers must be unique
+    write_file(directory / "1", {});
+    write_file(directory / "01", {});
+    test::check_throws<std::invalid_argument>([&] { const File_Records records(directory.string()); });
+    std::filesystem::remove(directory / "01");
+
+    // file 1: 4 records, file 2: empty, other names are ignored
+    write_file(directory / "1", {0x00, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x04});
+    write_file(directory / "2", {});
+    write_file(directory / "name", {0x00, 0x01});
+    {
+        File_Records records(directory.string());
+        check(records.size() == 2);
+
+        // read two sub-requests: records 1 - 2 and record 3 of file 1
+        const Frame read(1,
+                         {0x14, 0x0E,                                  // byte count
+                          0x06, 0x00, 0x01, 0x00, 0x01, 0x00, 0x02,    // file 1, record 1, length 2
+                          0x06, 0x00, 0x01, 0x00, 0x03, 0x00, 0x01});  // file 1, record 3, length 1
+        check(process(records, read) ==
+              pdu_t({0x14, 0x0A, 0x05, 0x06, 0x00, 0x02, 0x00, 0x03, 0x03, 0x06, 0x00, 0x04}));
+
+        // records beyond the end of the file, empty file, invalid reference type
+        check(process(records, Frame(1, {0x14, 0x07, 0x06, 0x00, 0x01, 0x00, 0x03, 0x00, 0x02})) ==
+              pdu_t({0x94, MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS}));
+        check(process(records, Frame(1, {0x14, 0x07, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01})) ==
+              pdu_t({0x94, MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS}));
+        check(process(records, Frame(1, {0x14, 0x07, 0x05, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01})) ==
+              pdu_t({0x94, MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS}));
+
+        // byte count does not match the request
+        check(process(records, Frame(1, {0x14, 0x08, 0x06, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01})) ==
+              pdu_t({0x94, MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE}));
+
+        // write: echo of the request, the records are written to the file
+        const Frame write(1, {0x15, 0x09, 0x06, 0x00, 0x01, 0x00, 0x02, 0x00, 0x01, 0xBE, 0xEF});
+        check(process(records, write) == pdu_t(write.data() + 1, write.data() + write.size() - 2));
+        check(read_file(directory / "1") == pdu_t({0x00, 0x01, 0x00, 0x02, 0xBE, 0xEF, 0x00, 0x04}));
+
+        // the request is validated before any record is written
+        const Frame invalid_write(1,
+                                  {0x15, 0x12,                                              // byte count
+                                   0x06, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x12, 0x34,    // file 1, record 0
+                                   0x06, 0x00, 0x01, 0x00, 0x04, 0x00, 0x01, 0x56, 0x78});  // file 1, record 4
+        check(process(records, invalid_write) == pdu_t({0x95, MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS}));
+        check(read_file(directory / "1")[0] == 0x00);
+
+        // other function codes are not handled
+        check(process(records, Frame(1, {MODBUS_FC_READ_HOLDING_REGISTERS, 0x00, 0x00, 0x00, 0x01})).empty());
+    }
+
+    std::filesystem::remove_all(directory);
+    return test::result();
+}
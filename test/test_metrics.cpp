@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Metrics.hpp"
+
+#include "test.hpp"
+
+#include <sstream>
+#include <string>
+
+using Modbus::Metrics;
+using test::check;
+
+//* check if the rendered metrics contain a line
+static bool contains_line(const std::string &text, const std::string &line) {
+    std::istringstream stream(text);
+    for (std::string l; std::getline(stream, l);)
+        if (l == line) return true;
+    return false;
+}
+
+//* check if all lines are comments or samples ('<name>[{<labels>}] <value>')
+static bool valid_format(const std::string &text) {
+    if (text.empty() || text.back() != '\n') return false;
+
+    std::istringstream stream(text);
+    for (std::string line; std::getline(stream, line);) {
+        if (line.starts_with("# HELP ") || line.starts_with("# TYPE ")) continue;
+
+        const auto value = line.rfind(' ');
+        if (value == std::string::npos || value == 0 || value + 1 == line.size()) return false;
+        const auto labels = line.find('{');
+        if (labels != std::string::npos && (labels > value || line[value - 1] != '}')) return false;
+    }
+    return true;
+}
+
+int main() {
+    modbus_mapping_t mapping {};
+    mapping.nb_bits            = 16;
+    mapping.nb_input_bits      = 8;
+    mapping.nb_registers       = 100;
+    mapping.nb_input_registers = 50;
+
+    Metrics metrics(19200, 8, 'N', 1);
+
+    // empty metrics: no request histograms, all counters 0
+    std::string text = metrics.render_prometheus(mapping);
+    check(valid_format(text));
+    check(contains_line(text, "# TYPE modbus_request_duration_seconds histogram"));
+    check(contains_line(text, "# TYPE modbus_foreign_frames_total counter"));  // text format 0.0.4, not OpenMetrics
+    check(text.find("# EOF") == std::string::npos);
+    check(text.find("modbus_request_duration_seconds_bucket") == std::string::npos);
+    check(contains_line(text, "modbus_foreign_frames_total 0"));
+    check(contains_line(text, "modbus_lock_wait_seconds_count 0"));
+    check(contains_line(text, "modbus_table_registers{table=\"AO\"} 100"));
+    check(contains_line(text, "modbus_table_size_bytes{table=\"AO\"} 200"));
+    check(contains_line(text, "modbus_table_size_bytes{table=\"DO\"} 16"));
+
+    // histograms are cumulative, the last bucket (+Inf) is the count
+    metrics.observe_request(3, 300'000);
+    metrics.observe_request(3, 300'000);
+    metrics.observe_request(3, 2'000'000'000);
+    metrics.count_exception(3);
+    metrics.count_foreign_frame();
+    metrics.count_received(8);
+    metrics.count_sent(11);
+    metrics.count_sent(-1);
+    text = metrics.render_prometheus(mapping);
+    check(valid_format(text));
+    check(contains_line(text, R"(modbus_request_duration_seconds_bucket{function="3",le="0.00025"} 0)"));
+    check(contains_line(text, R"(modbus_request_duration_seconds_bucket{function="3",le="0.0005"} 2)"));
+    check(contains_line(text, R"(modbus_request_duration_seconds_bucket{function="3",le="1"} 2)"));
+    check(contains_line(text, R"(modbus_request_duration_seconds_bucket{function="3",le="+Inf"} 3)"));
+    check(contains_line(text, R"(modbus_request_duration_seconds_sum{function="3"} 2.0006)"));
+    check(contains_line(text, R"(modbus_request_duration_seconds_count{function="3"} 3)"));
+    check(text.find(R"(function="4")") == std::string::npos);
+    check(contains_line(text, R"(modbus_exceptions_total{function="3"} 1)"));
+    check(contains_line(text, "modbus_foreign_frames_total 1"));
+    check(contains_line(text, R"(modbus_bus_bytes_total{direction="rx"} 8)"));
+    check(contains_line(text, R"(modbus_bus_bytes_total{direction="tx"} 11)"));
+
+    // 19 bytes, 10 bits per character at 19200 baud
+    check(contains_line(text, "modbus_bus_busy_seconds_total 0.00989583333"));
+
+    return test::result();
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Recorder.hpp"
+#include "Recorder_Format.hpp"
+
+#include "test.hpp"
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using Modbus::Recorder;
+using Modbus::recorder::file_header_t;
+using Modbus::recorder::record_header_t;
+using test::check;
+
+//* size of the ring
+static constexpr std::size_t RING_SIZE = 1024 * 1024;
+
+//* number of recorded registers
+static constexpr std::size_t REGISTERS = 1000;
+
+//! content of a ring file
+struct ring_file_t {
+    file_header_t                header {};
+    std::vector<record_header_t> records;     //!< records from tail to head (without padding)
+    std::vector<std::uint16_t>   last_values;  //!< values of the newest record
+    bool                         valid = true;
+};
+
+//* read and check a ring file
+static ring_file_t read_ring(const std::filesystem::path &path) {
+    std::ifstream                   file(path, std::ios::binary);
+    const std::vector<std::uint8_t> content {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+    ring_file_t ring;
+    if (content.size() < sizeof(file_header_t)) {
+        ring.valid = false;
+        return ring;
+    }
+    std::memcpy(&ring.header, content.data(), sizeof(file_header_t));
+    const std::uint8_t *data     = content.data() + sizeof(file_header_t);
+    const auto          capacity = ring.header.capacity;
+    if (content.size() != sizeof(file_header_t) + capacity || ring.header.tail > ring.header.head ||
+        ring.header.head - ring.header.tail > capacity) {
+        ring.valid = false;
+        return ring;
+    }
+
+    std::uint64_t last_timestamp = 0;
+    for (auto position = ring.header.tail; position < ring.header.head;) {
+        record_header_t record {};
+        std::memcpy(&record, data + position % capacity, sizeof(record));  // NOLINT
+
+        // records never wrap around the end of the ring
+        if (record.size == 0 || record.size % Modbus::recorder::RECORD_ALIGNMENT ||
+            record.size > capacity - position % capacity) {
+            ring.valid = false;
+            return ring;
+        }
+        position += record.size;
+        if (record.type == Modbus::recorder::PADDING) continue;
+
+        if (record.timestamp < last_timestamp) {
+            ring.valid = false;
+            return ring;
+        }
+        last_timestamp = record.timestamp;
+        ring.records.emplace_back(record);
+        ring.last_values.resize(record.count);
+        std::memcpy(ring.last_values.data(),
+                    data + (position - record.size) % capacity + sizeof(record_header_t),  // NOLINT
+                    record.count * sizeof(std::uint16_t));
+    }
+    return ring;
+}
+
+int main() {
+    const auto path = std::filesystem::temp_directory_path() /
+                      ("modbus_rtu_client_shm_test_" + std::to_string(getpid()) + ".rec");
+
+    std::array<std::uint16_t, REGISTERS> registers {};
+    modbus_mapping_t                     mapping {};
+    mapping.nb_registers  = static_cast<int>(registers.size());
+    mapping.tab_registers = registers.data();
+
+    test::check_throws<std::invalid_argument>(
+            [&] { const Recorder recorder(path.string(), RING_SIZE / 2, mapping, false, 1, 0600); });
+
+    {
+        // keyframe interval: only the first sample writes keyframes
+        Recorder recorder(path.string(), RING_SIZE, mapping, false, 1e6, 0600);
+        test::check_throws<std::invalid_argument>([&] { recorder.add_range("AO:0-1000"); });
+        recorder.add_range("AO:0-999");
+        test::check_throws<std::invalid_argument>([&] { recorder.add_range("AO:999"); });
+
+        // each sample changes all registers: one record of about 2 KiB per sample, the ring wraps several times
+        for (std::uint16_t sample = 1; sample <= 2000; ++sample) {
+            registers.fill(sample);
+            recorder.sample();
+        }
+    }
+
+    auto ring = read_ring(path);
+    check(ring.valid);
+    check(ring.header.magic == Modbus::recorder::MAGIC);
+    check(ring.header.head > 3 * ring.header.capacity);
+    check(!ring.records.empty());
+    check(ring.records.front().type == Modbus::recorder::DELTA);
+    check(ring.records.back().count == REGISTERS);
+    check(ring.last_values == std::vector<std::uint16_t>(REGISTERS, 2000));
+
+    // only the changed registers of a write are recorded (after the keyframes of the first sample)
+    {
+        Recorder recorder(path.string(), RING_SIZE, mapping, false, 1e6, 0600);
+        recorder.add_range("AO:0-999");
+        recorder.sample();
+
+        const test::Frame write(  // AO 10 - 12
+                1,
+                {MODBUS_FC_WRITE_MULTIPLE_REGISTERS, 0x00, 0x0A, 0x00, 0x03, 6, 0x12, 0x34, 0x56, 0x78, 0x9A, 0x00});
+        registers[10] = 0x1234;  // NOLINT
+        registers[11] = 0x5678;  // NOLINT
+        registers[12] = 0x9A00;  // NOLINT
+        recorder.on_write(write.request());
+    }
+
+    // the records of the existing file are kept
+    const auto previous = ring.header.head;
+    ring                = read_ring(path);
+    check(ring.valid);
+    check(ring.header.head > previous);
+    check(ring.records.back().type == Modbus::recorder::DELTA);
+    check(ring.records.back().address == 10);
+    check(ring.last_values == std::vector<std::uint16_t>({0x1234, 0x5678, 0x9A00}));
+
+    // a corrupted ring is reset
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(sizeof(file_header_t) + ring.header.tail % ring.header.capacity));
+        const std::uint32_t size = 3;
+        file.write(reinterpret_cast<const char *>(&size), sizeof(size));  // NOLINT
+    }
+    { Recorder recorder(path.string(), RING_SIZE, mapping, false, 1e6, 0600); }
+    ring = read_ring(path);
+    check(ring.valid);
+    check(ring.header.head == 0 && ring.header.tail == 0);
+
+    std::filesystem::remove(path);
+    return test::result();
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "modbus_shm.hpp"
+
+#include "test.hpp"
+
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using Modbus::shm::Shm_Mapping;
+using test::check;
+
+//* size of a shared memory object (-1: failed to open the object)
+static off_t object_size(const std::string &name) {
+    const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd == -1) return -1;
+
+    struct stat st {};
+    const int   rc = fstat(fd, &st);
+    close(fd);
+    return rc ? -1 : st.st_size;
+}
+
+int main() {
+    const std::string prefix = "modbus_rtu_client_shm_test_" + std::to_string(getpid()) + '_';
+
+    Shm_Mapping       storage(16, 16, 16, 16, prefix, false, 0600);  // NOLINT
+    modbus_mapping_t &mapping   = *storage.get_mapping();
+    std::uint16_t    *registers = mapping.tab_registers;
+    for (int i = 0; i < 16; ++i)
+        registers[i] = static_cast<std::uint16_t>(i + 1);  // NOLINT
+
+    test::check_throws<std::invalid_argument>([&] { storage.resize(Modbus::AO, 0); });
+    test::check_throws<std::invalid_argument>([&] { storage.resize(Modbus::AO, 0x10001); });
+    check(mapping.nb_registers == 16);
+
+    // shrink: only the number of registers changes, the object keeps its size
+    storage.resize(Modbus::AO, 8);
+    check(mapping.nb_registers == 8);
+    check(mapping.tab_registers == registers);
+    check(object_size(prefix + "AO") == 32);
+    check(registers[7] == 8);
+
+    // grow within the object: the registers that are added are 0
+    storage.resize(Modbus::AO, 12);  // NOLINT
+    check(mapping.nb_registers == 12);
+    check(object_size(prefix + "AO") == 32);
+    check(registers[7] == 8);
+    check(registers[8] == 0 && registers[11] == 0);  // NOLINT
+    check(registers[12] == 13);                      // NOLINT
+
+    // grow beyond the object: the object is enlarged and mapped at the same address
+    storage.resize(Modbus::AO, 1000);  // NOLINT
+    check(mapping.nb_registers == 1000);
+    check(mapping.tab_registers == registers);
+    check(object_size(prefix + "AO") == 2000);
+    check(registers[7] == 8 && registers[12] == 0 && registers[999] == 0);  // NOLINT
+    registers[999] = 1;                                                      // NOLINT
+
+    // bit tables: one byte per register
+    mapping.tab_bits[15] = 1;  // NOLINT
+    storage.resize(Modbus::DO, 4);
+    storage.resize(Modbus::DO, 0x10000);  // NOLINT
+    check(mapping.nb_bits == 0x10000);
+    check(object_size(prefix + "DO") == 0x10000);
+    check(mapping.tab_bits[15] == 0 && mapping.tab_bits[0xFFFF] == 0);  // NOLINT
+
+    // other tables are not changed
+    check(mapping.nb_input_bits == 16 && mapping.nb_input_registers == 16);
+    check(object_size(prefix + "AI") == 32);
+
+    return test::result();
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Write_Journal.hpp"
+
+#include "test.hpp"
+
+#include <modbus_rtu_client_shm/consumer.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using Modbus::shm::Write_Journal;
+using test::check;
+using test::Frame;
+
+//* number of journal entries
+static constexpr std::size_t CAPACITY = 8;
+
+//* number of entries that are appended while the journal is read concurrently
+static constexpr std::uint64_t CONCURRENT_ENTRIES = 20'000;
+
+//! result of reading a journal entry
+enum class read_result_t { OK, LOST, RETRY };
+
+//! reader of the journal (protocol of the documentation)
+class Reader final {
+private:
+    Modbus::consumer::Shared_Memory shm;
+    const Write_Journal::header_t  *header;
+    const Write_Journal::entry_t   *entries;
+
+public:
+    explicit Reader(const std::string &name)
+        : shm(name, true),
+          header(static_cast<const Write_Journal::header_t *>(shm.get_addr())),
+          entries(reinterpret_cast<const Write_Journal::entry_t *>(header + 1)) {}  // NOLINT
+
+    [[nodiscard]] const Write_Journal::header_t &get_header() const noexcept { return *header; }
+
+    [[nodiscard]] std::uint64_t head() const noexcept {
+        return std::atomic_ref(header->head).load(std::memory_order_acquire);
+    }
+
+    //* copy entry n, check that the sequence number is unchanged afterward
+    read_result_t read(std::uint64_t n, Write_Journal::entry_t &entry) const noexcept {
+        const auto &shared = entries[(n - 1) % header->capacity];  // NOLINT
+        const auto  before = std::atomic_ref(shared.sequence).load(std::memory_order_acquire);
+        if (before > n) return read_result_t::LOST;
+        if (before != n) return read_result_t::RETRY;
+
+        std::memcpy(&entry, &shared, sizeof(entry));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto after = std::atomic_ref(shared.sequence).load(std::memory_order_relaxed);
+        if (after != n) return after > n ? read_result_t::LOST : read_result_t::RETRY;
+        return read_result_t::OK;
+    }
+};
+
+//* write multiple registers request (AO address, values)
+static Frame write_registers(std::uint16_t address, std::uint16_t value, std::uint8_t count) {
+    Frame frame(1,
+                {MODBUS_FC_WRITE_MULTIPLE_REGISTERS,
+                 static_cast<std::uint8_t>(address >> 8),
+                 static_cast<std::uint8_t>(address),
+                 0,
+                 count,
+                 static_cast<std::uint8_t>(count * 2)});
+    for (std::uint8_t i = 0; i < count; ++i)
+        frame.append({static_cast<std::uint8_t>(value >> 8), static_cast<std::uint8_t>(value)});
+    return frame;
+}
+
+int main() {
+    const std::string name = "modbus_rtu_client_shm_test_" + std::to_string(getpid()) + "_write_journal";
+
+    std::array<std::uint8_t, 16>   bits {};
+    std::array<std::uint16_t, 200> registers {};
+    modbus_mapping_t               mapping {};
+    mapping.nb_bits       = static_cast<int>(bits.size());
+    mapping.tab_bits      = bits.data();
+    mapping.nb_registers  = static_cast<int>(registers.size());
+    mapping.tab_registers = registers.data();
+
+    test::check_throws<std::invalid_argument>([&] { const Write_Journal journal(name, 0, false, 0600); });
+
+    {
+        Write_Journal journal(name, CAPACITY, false, 0600);
+        const Reader  reader(name);
+        check(reader.get_header().magic == Write_Journal::MAGIC);
+        check(reader.get_header().capacity == CAPACITY);
+        check(reader.get_header().entry_size == sizeof(Write_Journal::entry_t));
+        check(reader.head() == 0);
+
+        // sequence numbers start with 1, the ring wraps around
+        for (std::uint16_t n = 1; n <= 2 * CAPACITY + 3; ++n) {
+            const auto count = static_cast<std::uint8_t>(n % 5 + 1);
+            const auto frame = write_registers(n, n, count);
+            std::fill_n(registers.begin() + n, count, n);
+            journal.append(frame.request(), mapping, 1000U + n);
+        }
+        const auto head = reader.head();
+        check(head == 2 * CAPACITY + 3);
+        check(reader.get_header().notify == head);
+
+        Write_Journal::entry_t entry {};
+        for (std::uint64_t n = head - CAPACITY + 1; n <= head; ++n) {
+            check(reader.read(n, entry) == read_result_t::OK);
+            check(entry.sequence == n && entry.timestamp == 1000 + n);
+            check(entry.function == MODBUS_FC_WRITE_MULTIPLE_REGISTERS && entry.table == Modbus::AO);
+            check(entry.address == n && entry.count == n % 5 + 1);
+            check(entry.data[0] == n && entry.data[entry.count - 1] == n);
+        }
+
+        // overwritten entries are detected by a larger sequence number, future entries are not read
+        check(reader.read(head - CAPACITY, entry) == read_result_t::LOST);
+        check(reader.read(1, entry) == read_result_t::LOST);
+        check(reader.read(head + 1, entry) == read_result_t::RETRY);
+
+        // coils are packed (LSB of the first byte is the first coil)
+        bits.fill(0);
+        bits[3] = 1;
+        bits[5] = 1;
+        bits[12] = 1;  // NOLINT
+        const Frame coils(1, {MODBUS_FC_WRITE_MULTIPLE_COILS, 0x00, 0x03, 0x00, 0x0A, 0x02, 0x05, 0x02});
+        journal.append(coils.request(), mapping, 0);
+        check(reader.read(head + 1, entry) == read_result_t::OK);
+        check(entry.table == Modbus::DO && entry.address == 3 && entry.count == 10);
+        std::array<std::uint8_t, 2> packed {};
+        std::memcpy(packed.data(), entry.data.data(), packed.size());
+        check(packed[0] == 0x05 && packed[1] == 0x02);  // NOLINT
+    }
+
+    // concurrent reader: an entry is only accepted if it was copied completely
+    {
+        Write_Journal     journal(name, CAPACITY, true, 0600);
+        const Reader      reader(name);
+        std::atomic<bool> done = false;
+
+        std::thread writer([&] {
+            for (std::uint64_t n = 1; n <= CONCURRENT_ENTRIES; ++n) {
+                const auto value = static_cast<std::uint16_t>(n);
+                const auto count = static_cast<std::uint8_t>(n % MODBUS_MAX_WRITE_REGISTERS + 1);
+                const auto frame = write_registers(0, value, count);
+                std::fill_n(registers.begin(), count, value);
+                journal.append(frame.request(), mapping, n);
+            }
+            done = true;
+        });
+
+        std::uint64_t read = 0;
+        std::uint64_t lost = 0;
+        std::uint64_t torn = 0;
+        for (std::uint64_t next = 1; !done || next <= reader.head();) {
+            if (next > reader.head()) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            Write_Journal::entry_t entry {};
+            switch (reader.read(next, entry)) {
+                case read_result_t::OK:
+                    ++read;
+                    if (entry.timestamp != next || entry.count != next % MODBUS_MAX_WRITE_REGISTERS + 1 ||
+                        entry.data[0] != static_cast<std::uint16_t>(next) ||
+                        entry.data[entry.count - 1] != static_cast<std::uint16_t>(next))
+                        ++torn;
+                    ++next;
+                    break;
+                case read_result_t::LOST:
+                    ++lost;
+                    next = reader.head() - CAPACITY / 2;
+                    break;
+                case read_result_t::RETRY:
+                default: std::this_thread::yield();
+            }
+        }
+        writer.join();
+
+        check(torn == 0);
+        check(read > 0);
+        check(read + lost <= CONCURRENT_ENTRIES);
+        check(reader.head() == CONCURRENT_ENTRIES);
+    }
+
+    shm_unlink(name.c_str());
+    return test::result();
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Write_Mask.hpp"
+
+#include "test.hpp"
+
+#include <stdexcept>
+
+using Modbus::Write_Mask;
+using test::check;
+using test::Frame;
+
+//* write request header (function code, address, quantity or value)
+static Frame write_request(std::uint8_t function, std::uint16_t address, std::uint16_t quantity) {
+    return {1,
+            {function,
+             static_cast<std::uint8_t>(address >> 8),
+             static_cast<std::uint8_t>(address),
+             static_cast<std::uint8_t>(quantity >> 8),
+             static_cast<std::uint8_t>(quantity)}};
+}
+
+//* check if a write request is allowed
+static bool allows(const Write_Mask &mask, const Frame &frame) {
+    return mask.allows(frame.request());
+}
+
+int main() {
+    Write_Mask mask;
+    test::check_throws<std::invalid_argument>([&] { mask.protect("DI:0"); });
+    test::check_throws<std::invalid_argument>([&] { mask.protect("AI:0-10"); });
+    test::check_throws<std::invalid_argument>([&] { mask.protect("AO:x"); });
+
+    mask.protect("AO:10-20");
+    mask.protect("AO:200");
+    mask.protect("DO:63-64");
+
+    // single register writes at the bounds of the protected range
+    check(allows(mask, write_request(MODBUS_FC_WRITE_SINGLE_REGISTER, 9, 0)));
+    check(!allows(mask, write_request(MODBUS_FC_WRITE_SINGLE_REGISTER, 10, 0)));
+    check(!allows(mask, write_request(MODBUS_FC_WRITE_SINGLE_REGISTER, 20, 0)));
+    check(allows(mask, write_request(MODBUS_FC_WRITE_SINGLE_REGISTER, 21, 0)));
+    check(!allows(mask, write_request(MODBUS_FC_MASK_WRITE_REGISTER, 15, 0)));
+
+    // multiple register writes that touch the protected range
+    check(allows(mask, write_request(MODBUS_FC_WRITE_MULTIPLE_REGISTERS, 0, 10)));
+    check(!allows(mask, write_request(MODBUS_FC_WRITE_MULTIPLE_REGISTERS, 0, 11)));
+    check(allows(mask, write_request(MODBUS_FC_WRITE_MULTIPLE_REGISTERS, 21, 123)));
+
+    // writes that cover several words of the bitmap (first, middle and last word)
+    check(!allows(mask, write_request(MODBUS_FC_WRITE_MULTIPLE_REGISTERS, 100, 123)));
+    check(allows(mask, write_request(MODBUS_FC_WRITE_MULTIPLE_REGISTERS, 201, 123)));
+    check(!allows(mask, write_request(MODBUS_FC_WRITE_MULTIPLE_REGISTERS, 190, 11)));
+    check(!allows(mask, write_request(MODBUS_FC_WRITE_MULTIPLE_REGISTERS, 200, 100)));
+
+    // coils: the protected range crosses a word boundary
+    check(allows(mask, write_request(MODBUS_FC_WRITE_MULTIPLE_COILS, 0, 63)));
+    check(!allows(mask, write_request(MODBUS_FC_WRITE_MULTIPLE_COILS, 0, 64)));
+    check(!allows(mask, write_request(MODBUS_FC_WRITE_SINGLE_COIL, 64, 0xFF00)));
+    check(allows(mask, write_request(MODBUS_FC_WRITE_MULTIPLE_COILS, 65, 1968)));
+
+    // write and read registers: only the written range is checked
+    const Frame read_protected(1,
+                               {MODBUS_FC_WRITE_AND_READ_REGISTERS,
+                                0x00, 0x0A, 0x00, 0x01,    // read register 10
+                                0x00, 0x00, 0x00, 0x01});  // write register 0
+    const Frame write_protected(1,
+                                {MODBUS_FC_WRITE_AND_READ_REGISTERS,
+                                 0x00, 0x00, 0x00, 0x01,    // read register 0
+                                 0x00, 0x0A, 0x00, 0x01});  // write register 10
+    check(allows(mask, read_protected));
+    check(!allows(mask, write_protected));
+
+    // reads and address ranges beyond the table are not rejected by the mask
+    check(allows(mask, write_request(MODBUS_FC_READ_HOLDING_REGISTERS, 10, 1)));
+    check(allows(mask, write_request(MODBUS_FC_WRITE_MULTIPLE_REGISTERS, 0xFFFF, 2)));
+
+    return test::result();
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+#include "Write_Staging.hpp"
+
+#include "test.hpp"
+
+#include <modbus_rtu_client_shm/consumer.hpp>
+
+#include <array>
+#include <chrono>
+#include <poll.h>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+using Modbus::shm::Write_Staging;
+using test::check;
+using test::Frame;
+
+int main() {
+    const std::string prefix = "modbus_rtu_client_shm_test_" + std::to_string(getpid()) + '_';
+
+    std::array<std::uint8_t, 16> bits {};
+    std::array<std::uint16_t, 8> registers {};
+    modbus_mapping_t             mapping {};
+    mapping.nb_bits       = static_cast<int>(bits.size());
+    mapping.tab_bits      = bits.data();
+    mapping.nb_registers  = static_cast<int>(registers.size());
+    mapping.tab_registers = registers.data();
+
+    Write_Staging                 staging(prefix + "staging", mapping, false, 0600);
+    Modbus::consumer::Commit_Sync commits(prefix);
+    modbus_mapping_t             &view    = staging.get_view();
+    static constexpr auto         NO_WAIT = std::chrono::nanoseconds::zero();
+
+    test::check_throws<std::invalid_argument>([&] { staging.set_commit_coil(bits.size()); });
+
+    // the master is served from the shadow tables: staged writes are not visible before the commit
+    view.tab_registers[2] = 0x1234;  // NOLINT
+    staging.stage(Frame(1, {MODBUS_FC_WRITE_SINGLE_REGISTER, 0x00, 0x02, 0x12, 0x34}).request());
+    check(registers[2] == 0);
+    check(!commits.wait(NO_WAIT));
+
+    check(staging.commit());
+    check(registers[2] == 0x1234);
+    check(commits.commits() == 1);
+    check(commits.wait(NO_WAIT));
+
+    // nothing staged: no commit, but changes of other processes become visible for the master
+    registers[3] = 0x5678;
+    check(!staging.commit());
+    check(view.tab_registers[3] == 0x5678);  // NOLINT
+    check(commits.commits() == 1);
+
+    // registers that are not staged are not overwritten by a commit
+    view.tab_registers[4] = 1;  // NOLINT
+    registers[5]          = 2;
+    staging.stage(Frame(1, {MODBUS_FC_WRITE_SINGLE_REGISTER, 0x00, 0x04, 0x00, 0x01}).request());
+    check(staging.commit());
+    check(registers[4] == 1 && registers[5] == 2);
+
+    // commit coil: the write of 1 commits and resets the coil
+    staging.set_commit_coil(15);  // NOLINT
+    view.tab_bits[0] = 1;
+    staging.stage(Frame(1, {MODBUS_FC_WRITE_SINGLE_COIL, 0x00, 0x00, 0xFF, 0x00}).request());
+    check(bits[0] == 0);
+    view.tab_bits[15] = 1;  // NOLINT
+    staging.stage(Frame(1, {MODBUS_FC_WRITE_SINGLE_COIL, 0x00, 0x0F, 0xFF, 0x00}).request());
+    check(bits[0] == 1 && bits[15] == 0);
+    check(view.tab_bits[15] == 0);  // NOLINT
+    check(commits.commits() == 3);
+
+    // ticks of the consumers make the eventfd readable
+    const int tick_fd = staging.watch_ticks();
+    test::check_throws<std::logic_error>([&] { staging.watch_ticks(); });
+    commits.request_commit();
+    pollfd pfd {tick_fd, POLLIN, 0};
+    check(poll(&pfd, 1, 1000) == 1);  // NOLINT
+
+    return test::result();
+}
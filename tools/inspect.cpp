@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+/*! \brief print register ranges of a running client and watch them for changes
+ *
+ * The tables are mapped read only. The semaphore of the client (if specified) is only held while one range is
+ * copied (one memcpy). Values are decoded and compared after the semaphore is released.
+ */
+
+#include "Address_Range.hpp"
+
+#include <modbus_rtu_client_shm/consumer.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <cxxopts.hpp>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <sysexits.h>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace consumer = Modbus::consumer;
+
+//! terminate flag (watch mode)
+static volatile std::sig_atomic_t terminate = 0;  // NOLINT
+
+static void sig_term_handler(int) {
+    terminate = 1;
+}
+
+//! value representation
+enum class Value_Type { U16, I16, U32, I32, F32, HEX };
+
+//! size of the blocks that are compared at once (a multiple of all value sizes)
+static constexpr std::size_t COMPARE_BLOCK = 64;
+
+//! inspected range
+struct inspected_range_t {
+    Modbus::Address_Range     range;
+    std::size_t               value_size;  //!< size of one value in bytes
+    std::vector<std::uint8_t> previous;    //!< raw content of the previous sample
+    std::vector<std::uint8_t> current;     //!< raw content of the current sample
+};
+
+//* copy the raw content of a range (one memcpy while the semaphore is held)
+static void sample(consumer::Tables &tables, inspected_range_t &r) {
+    const auto table = static_cast<consumer::Table>(r.range.table);
+    if (Modbus::is_coil_table(r.range.table)) {
+        tables.read(table, r.range.start, std::span(r.current));
+    } else {
+        const std::span registers(reinterpret_cast<std::uint16_t *>(r.current.data()), r.range.count);  // NOLINT
+        tables.read(table, r.range.start, registers, consumer::Format {});
+    }
+}
+
+//* print one value
+static void print_value(const inspected_range_t &r,
+                        const std::uint8_t      *raw,
+                        Value_Type               type,
+                        consumer::Format         format) {
+    if (Modbus::is_coil_table(r.range.table)) {
+        std::cout << static_cast<unsigned>(*raw != 0);
+        return;
+    }
+
+    std::array<std::uint16_t, 2> regs {};
+    std::memcpy(regs.data(), raw, r.value_size);
+    switch (type) {
+        case Value_Type::U16: std::cout << consumer::decode<std::uint16_t>(regs.data(), format); break;
+        case Value_Type::I16: std::cout << consumer::decode<std::int16_t>(regs.data(), format); break;
+        case Value_Type::U32: std::cout << consumer::decode<std::uint32_t>(regs.data(), format); break;
+        case Value_Type::I32: std::cout << consumer::decode<std::int32_t>(regs.data(), format); break;
+        case Value_Type::F32: std::cout << consumer::decode<float>(regs.data(), format); break;
+        case Value_Type::HEX:
+            std::cout << "0x" << std::hex << std::setw(4) << std::setfill('0')
+                      << consumer::decode<std::uint16_t>(regs.data(), format) << std::dec;
+            break;
+        default: break;
+    }
+}
+
+//* print the address of a value
+static void print_address(const inspected_range_t &r, std::size_t offset) {
+    std::cout << Modbus::table_name(r.range.table) << ':' << r.range.start + offset / (r.value_size == 1 ? 1 : 2);
+}
+
+int main(int argc, char **argv) {
+    const std::string exe_name = std::filesystem::path(argv[0]).filename().string();  // NOLINT
+    cxxopts::Options  options(exe_name, "Print register ranges of a running modbus client and watch them for changes");
+
+    options.add_options()("range",
+                          "register ranges: <table>:<first>[-<last>] (e.g. AO:0-99)",
+                          cxxopts::value<std::vector<std::string>>());
+    options.add_options()("n,name-prefix",
+                          "shared memory name prefix of the client",
+                          cxxopts::value<std::string>()->default_value("modbus_"));
+    options.add_options()("socket",
+                          "receive the tables from the memfd socket of the client (--storage memfd:<socket>)",
+                          cxxopts::value<std::string>());
+    options.add_options()("semaphore", "semaphore of the client", cxxopts::value<std::string>());
+    options.add_options()("t,type",
+                          "representation of AO/AI registers: u16, i16, u32, i32, f32 or hex",
+                          cxxopts::value<std::string>()->default_value("u16"));
+    options.add_options()("wire-order", "the client stores the registers in modbus byte order (--wire-order)");
+    options.add_options()("low-word-first", "the first register of 32 bit values contains the low word");
+    options.add_options()("w,watch",
+                          "print only changes. The ranges are sampled with the given interval in seconds. "
+                          "Fractional values are possible.",
+                          cxxopts::value<double>());
+    options.add_options()("h,help", "print usage");
+    options.parse_positional({"range"});
+    options.positional_help("RANGE...");
+
+    cxxopts::ParseResult args;
+    try {
+        args = options.parse(argc, argv);
+    } catch (cxxopts::exceptions::exception &e) {
+        std::cerr << "Failed to parse arguments: " << e.what() << ".'\n";
+        return EX_USAGE;
+    }
+
+    if (args.count("help")) {
+        std::cout << options.help() << '\n';
+        return EX_OK;
+    }
+
+    if (!args.count("range")) {
+        std::cerr << "at least one register range is mandatory (see --help)" << '\n';
+        return EX_USAGE;
+    }
+
+    const auto type_str = args["type"].as<std::string>();
+    Value_Type type     = Value_Type::U16;
+    if (type_str == "u16") type = Value_Type::U16;
+    else if (type_str == "i16") type = Value_Type::I16;
+    else if (type_str == "u32") type = Value_Type::U32;
+    else if (type_str == "i32") type = Value_Type::I32;
+    else if (type_str == "f32") type = Value_Type::F32;
+    else if (type_str == "hex") type = Value_Type::HEX;
+    else {
+        std::cerr << "invalid type '" << type_str << "'" << '\n';
+        return EX_USAGE;
+    }
+    const bool wide = type == Value_Type::U32 || type == Value_Type::I32 || type == Value_Type::F32;
+
+    consumer::Format format;
+    format.byte_order = args.count("wire-order") ? consumer::Byte_Order::WIRE : consumer::Byte_Order::HOST;
+    format.word_order =
+            args.count("low-word-first") ? consumer::Word_Order::LOW_FIRST : consumer::Word_Order::HIGH_FIRST;
+
+    std::vector<inspected_range_t> ranges;
+    try {
+        for (const auto &definition : args["range"].as<std::vector<std::string>>()) {
+            inspected_range_t r;
+            r.range      = Modbus::parse_address_range(definition);
+            r.value_size = Modbus::is_coil_table(r.range.table) ? 1 : (wide ? 4 : 2);
+            if (r.value_size == 4 && r.range.count % 2)
+                throw std::invalid_argument("range '" + definition + "' does not contain complete 32 bit values");
+
+            const std::size_t bytes = Modbus::is_coil_table(r.range.table) ? r.range.count : 2 * r.range.count;
+            r.current.resize(bytes);
+            r.previous.resize(bytes);
+            ranges.emplace_back(std::move(r));
+        }
+    } catch (const std::invalid_argument &e) {
+        std::cerr << e.what() << '\n';
+        return EX_USAGE;
+    }
+
+    consumer::Tables::Options attach;
+    attach.prefix    = args["name-prefix"].as<std::string>();
+    attach.read_only = true;
+    attach.format    = format;
+    if (args.count("socket")) attach.socket = args["socket"].as<std::string>();
+    if (args.count("semaphore")) attach.semaphore = args["semaphore"].as<std::string>();
+
+    std::ios::sync_with_stdio(false);
+    try {
+        consumer::Tables tables(attach);
+        format = tables.get_format();
+        for (auto &r : ranges)
+            sample(tables, r);
+
+        if (!args.count("watch")) {
+            for (const auto &r : ranges) {
+                for (std::size_t offset = 0; offset < r.current.size(); offset += r.value_size) {
+                    print_address(r, offset);
+                    std::cout << ' ';
+                    print_value(r, r.current.data() + offset, type, format);  // NOLINT
+                    std::cout << '\n';
+                }
+            }
+            return EX_OK;
+        }
+
+        const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(args["watch"].as<double>()));
+        if (interval <= std::chrono::steady_clock::duration::zero()) {
+            std::cerr << "invalid watch interval" << '\n';
+            return EX_USAGE;
+        }
+
+        std::signal(SIGINT, sig_term_handler);
+        std::signal(SIGTERM, sig_term_handler);
+
+        auto next = std::chrono::steady_clock::now();
+        while (!terminate) {
+            next += interval;
+            std::this_thread::sleep_until(next);
+
+            const auto now = std::chrono::system_clock::now().time_since_epoch();
+            const auto ns  = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+            for (auto &r : ranges) {
+                std::swap(r.previous, r.current);
+                sample(tables, r);
+
+                // compare blocks first (vectorized memcmp), values only inside changed blocks
+                const std::size_t size = r.current.size();
+                for (std::size_t block = 0; block < size; block += COMPARE_BLOCK) {
+                    const std::size_t block_size = std::min(COMPARE_BLOCK, size - block);
+                    if (std::memcmp(r.previous.data() + block, r.current.data() + block, block_size) == 0) continue;
+
+                    for (std::size_t offset = block; offset < block + block_size; offset += r.value_size) {
+                        if (std::memcmp(r.previous.data() + offset, r.current.data() + offset, r.value_size) == 0)
+                            continue;
+
+                        std::cout << ns / 1'000'000'000 << '.' << std::setw(9) << std::setfill('0')
+                                  << ns % 1'000'000'000 << ' ';
+                        print_address(r, offset);
+                        std::cout << ' ';
+                        print_value(r, r.previous.data() + offset, type, format);  // NOLINT
+                        std::cout << " -> ";
+                        print_value(r, r.current.data() + offset, type, format);  // NOLINT
+                        std::cout << '\n';
+                    }
+                }
+            }
+            std::cout.flush();
+        }
+    } catch (const std::system_error &e) {
+        std::cerr << e.what() << '\n';
+        return EX_NOINPUT;
+    } catch (const std::out_of_range &e) {
+        std::cerr << e.what() << '\n';
+        return EX_DATAERR;
+    } catch (const std::runtime_error &e) {
+        std::cerr << e.what() << '\n';
+        return EX_DATAERR;
+    }
+}
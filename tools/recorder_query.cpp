@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2026 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the GPLv3 License.
+ */
+
+/*! \brief extract an address range and a time window from a recorder ring file (see Recorder_Format.hpp)
+ *
+ * Output (CSV): one line per change of the range: timestamp (seconds since epoch), one column per address.
+ * The first line after the header contains the state at the start of the time window.
+ * Values that are not known yet (no keyframe before) are empty.
+ */
+
+#include "Address_Range.hpp"
+#include "Recorder_Format.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <cxxopts.hpp>
+#include <fcntl.h>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sysexits.h>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+
+using Modbus::recorder::file_header_t;
+using Modbus::recorder::record_header_t;
+
+//! read only mapping of a recorder file
+class Recorder_File final {
+private:
+    void       *addr = nullptr;
+    std::size_t size = 0;
+
+public:
+    explicit Recorder_File(const std::string &path) {
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);  // NOLINT
+        if (fd == -1) throw std::system_error(errno, std::generic_category(), "failed to open '" + path + "'");
+
+        struct stat st {};
+        if (fstat(fd, &st)) {
+            const int error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "failed to stat '" + path + "'");
+        }
+        size = static_cast<std::size_t>(st.st_size);
+        if (size < sizeof(file_header_t)) {
+            close(fd);
+            throw std::runtime_error("'" + path + "' is not a recorder file");
+        }
+
+        addr            = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        const int error = errno;
+        close(fd);
+        if (addr == MAP_FAILED)  // NOLINT
+            throw std::system_error(error, std::generic_category(), "failed to map '" + path + "'");
+
+        const auto &h = header();
+        if (std::atomic_ref(h.magic).load(std::memory_order_acquire) != Modbus::recorder::MAGIC ||
+            h.version != Modbus::recorder::VERSION || h.capacity + sizeof(file_header_t) != size) {
+            munmap(addr, size);
+            throw std::runtime_error("'" + path + "' is not a recorder file or has an unsupported version");
+        }
+    }
+
+    ~Recorder_File() { munmap(addr, size); }
+
+    Recorder_File(const Recorder_File &other)            = delete;
+    Recorder_File(Recorder_File &&other)                 = delete;
+    Recorder_File &operator=(const Recorder_File &other) = delete;
+    Recorder_File &operator=(Recorder_File &&other)      = delete;
+
+    [[nodiscard]] file_header_t &header() const noexcept { return *static_cast<file_header_t *>(addr); }
+
+    [[nodiscard]] const std::uint8_t *ring() const noexcept {
+        return static_cast<const std::uint8_t *>(addr) + sizeof(file_header_t);  // NOLINT
+    }
+};
+
+/*! \brief copy the valid records of a recorder file that is possibly written concurrently
+ *
+ * @param file recorder file
+ * @return records in chronological order (without padding)
+ */
+static std::vector<std::uint8_t> copy_records(const Recorder_File &file) {
+    const auto         &header   = file.header();
+    const std::uint64_t capacity = header.capacity;
+    const std::uint64_t head     = std::atomic_ref(header.head).load(std::memory_order_acquire);
+    const std::uint64_t tail     = std::atomic_ref(header.tail).load(std::memory_order_acquire);
+    if (head <= tail) return {};
+
+    // copy the ring in chronological order
+    std::vector<std::uint8_t> raw(head - tail);
+    const std::uint64_t       first_part = std::min(head - tail, capacity - tail % capacity);
+    std::memcpy(raw.data(), file.ring() + tail % capacity, first_part);                       // NOLINT
+    std::memcpy(raw.data() + first_part, file.ring(), raw.size() - first_part);             // NOLINT
+
+    // the writer advances the tail before records are overwritten: records before the new tail are not valid
+    const std::uint64_t valid = std::atomic_ref(header.tail).load(std::memory_order_acquire);
+    if (valid >= head) return {};
+
+    std::vector<std::uint8_t> records;
+    records.reserve(head - valid);
+    std::uint64_t offset = valid - tail;
+    while (offset + sizeof(record_header_t) <= raw.size()) {
+        record_header_t record {};
+        std::memcpy(&record, raw.data() + offset, sizeof(record));  // NOLINT
+        if (record.size < sizeof(record_header_t) || offset + record.size > raw.size()) break;
+
+        if (record.type != Modbus::recorder::PADDING)
+            records.insert(records.end(), raw.begin() + static_cast<std::ptrdiff_t>(offset),
+                           raw.begin() + static_cast<std::ptrdiff_t>(offset + record.size));
+        offset += record.size;
+    }
+
+    return records;
+}
+
+//! print a line of the CSV output
+static void print_state(std::uint64_t timestamp, const std::vector<std::optional<std::uint16_t>> &state) {
+    std::cout << timestamp / 1'000'000'000 << '.' << std::setw(9) << std::setfill('0') << timestamp % 1'000'000'000;
+    for (const auto &value : state) {
+        std::cout << ',';
+        if (value) std::cout << *value;
+    }
+    std::cout << '\n';
+}
+
+//! check if at least one value of the range is known
+static bool known(const std::vector<std::optional<std::uint16_t>> &state) {
+    return std::any_of(state.begin(), state.end(), [](const auto &value) { return value.has_value(); });
+}
+
+int main(int argc, char **argv) {
+    const std::string exe_name = std::filesystem::path(argv[0]).filename().string();  // NOLINT
+    cxxopts::Options  options(exe_name, "Extract an address range and a time window from a recorder ring file");
+
+    options.add_options()("file", "recorder ring file", cxxopts::value<std::string>());
+    options.add_options()(
+            "range", "address range: <table>:<first>[-<last>] (e.g. AI:0-9)", cxxopts::value<std::string>());
+    options.add_options()("from",
+                          "start of the time window in seconds since epoch (default: oldest record). "
+                          "Fractional values are possible.",
+                          cxxopts::value<double>());
+    options.add_options()("to",
+                          "end of the time window in seconds since epoch (default: newest record). "
+                          "Fractional values are possible.",
+                          cxxopts::value<double>());
+    options.add_options()("h,help", "print usage");
+    options.parse_positional({"file", "range"});
+    options.positional_help("FILE RANGE");
+
+    cxxopts::ParseResult args;
+    try {
+        args = options.parse(argc, argv);
+    } catch (cxxopts::exceptions::exception &e) {
+        std::cerr << "Failed to parse arguments: " << e.what() << ".'\n";
+        return EX_USAGE;
+    }
+
+    if (args.count("help")) {
+        std::cout << options.help() << '\n';
+        return EX_OK;
+    }
+
+    if (!args.count("file") || !args.count("range")) {
+        std::cerr << "recorder file and address range are mandatory (see --help)" << '\n';
+        return EX_USAGE;
+    }
+
+    Modbus::Address_Range range;
+    try {
+        range = Modbus::parse_address_range(args["range"].as<std::string>());
+    } catch (const std::invalid_argument &e) {
+        std::cerr << e.what() << '\n';
+        return EX_USAGE;
+    }
+
+    const auto to_ns = [](double seconds) { return static_cast<std::uint64_t>(std::llround(seconds * 1e9)); };
+    const std::uint64_t from = args.count("from") ? to_ns(args["from"].as<double>()) : 0;
+    const std::uint64_t to   = args.count("to") ? to_ns(args["to"].as<double>()) : std::numeric_limits<uint64_t>::max();
+
+    std::vector<std::uint8_t> records;
+    try {
+        const Recorder_File file(args["file"].as<std::string>());
+        records = copy_records(file);
+    } catch (const std::system_error &e) {
+        std::cerr << e.what() << '\n';
+        return EX_NOINPUT;
+    } catch (const std::runtime_error &e) {
+        std::cerr << e.what() << '\n';
+        return EX_DATAERR;
+    }
+
+    std::cout << "timestamp";
+    for (std::size_t i = 0; i < range.count; ++i)
+        std::cout << ',' << Modbus::table_name(range.table) << ':' << range.start + i;
+    std::cout << '\n';
+
+    std::vector<std::optional<std::uint16_t>> state(range.count);
+    bool                                      in_window = false;
+    for (std::size_t offset = 0; offset < records.size();) {
+        record_header_t record {};
+        std::memcpy(&record, records.data() + offset, sizeof(record));  // NOLINT
+        const std::uint8_t *values = records.data() + offset + sizeof(record);  // NOLINT
+        offset                    += record.size;
+
+        if (record.timestamp > to) break;
+
+        // state at the start of the window
+        if (!in_window && record.timestamp >= from) {
+            in_window = true;
+            if (known(state)) print_state(from, state);
+        }
+
+        // apply the overlapping part of the record
+        if (record.table != range.table) continue;
+        const std::size_t begin = std::max<std::size_t>(record.address, range.start);
+        const std::size_t end   = std::min<std::size_t>(record.address + record.count, range.start + range.count);
+        if (begin >= end) continue;
+
+        bool changed = false;
+        for (std::size_t address = begin; address < end; ++address) {
+            std::uint16_t value = 0;
+            std::memcpy(&value, values + (address - record.address) * sizeof(value), sizeof(value));  // NOLINT
+            auto &current = state[address - range.start];
+            if (current != value) {
+                current = value;
+                changed = true;
+            }
+        }
+
+        if (in_window && changed) print_state(record.timestamp, state);
+    }
+
+    // no change inside the window
+    if (!in_window && known(state)) print_state(from, state);
+}